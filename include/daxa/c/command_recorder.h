@@ -25,6 +25,10 @@ typedef struct
 {
     daxa_QueueFamily queue_family;
     daxa_SmallString name;
+    // Skips remembering used resource ids and validating them on submit. Saves recording and submit time for trusted command lists.
+    daxa_Bool8 disable_submit_validation;
+    // Allows submitting the completed command lists multiple times, also while previous submissions are still executing.
+    daxa_Bool8 reusable;
 } daxa_CommandRecorderInfo;
 
 static daxa_CommandRecorderInfo const DAXA_DEFAULT_COMMAND_RECORDER_INFO = DAXA_ZERO_INIT;
@@ -447,6 +451,11 @@ daxa_cmd_pipeline_barrier(daxa_CommandRecorder cmd_enc, daxa_MemoryBarrierInfo c
 /// @param info parameters.
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_cmd_pipeline_barrier_image_transition(daxa_CommandRecorder cmd_enc, daxa_ImageMemoryBarrierInfo const * info);
+/// @brief  Adds all barriers to the currently recorded barriers.
+///         They are flushed together with a single vkCmdPipelineBarrier2 call, regardless of their count.
+/// @param info parameters.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_cmd_pipeline_barriers(daxa_CommandRecorder cmd_enc, daxa_PipelineBarrierInfo const * info);
 DAXA_EXPORT void
 daxa_cmd_signal_event(daxa_CommandRecorder cmd_enc, daxa_EventSignalInfo const * info);
 DAXA_EXPORT void
@@ -351,6 +351,11 @@ typedef struct
     uint32_t max_allowed_samplers;
     uint32_t max_allowed_acceleration_structures;
     daxa_SmallString name;
+    // When not 0, a background thread collects garbage in this interval, so daxa_dvc_collect_garbage never has to be called manually.
+    uint32_t background_garbage_collection_interval_ms;
+    // When set, pipelines are created through a pipeline cache loaded from this file.
+    // The file is ignored when it was written for a different device or driver version. It is written back when the device is destroyed.
+    char const * pipeline_cache_path;
 } daxa_DeviceInfo2;
 
 static daxa_DeviceInfo2 const DAXA_DEFAULT_DEVICE_INFO_2 = {
@@ -361,6 +366,8 @@ static daxa_DeviceInfo2 const DAXA_DEFAULT_DEVICE_INFO_2 = {
     .max_allowed_samplers = 400,
     .max_allowed_acceleration_structures = 10000,
     .name = DAXA_ZERO_INIT,
+    .background_garbage_collection_interval_ms = 0,
+    .pipeline_cache_path = 0,
 };
 
 typedef struct
@@ -384,7 +391,11 @@ static daxa_Queue const DAXA_QUEUE_TRANSFER_1 = { DAXA_QUEUE_FAMILY_TRANSFER, 1
 typedef struct
 {
     daxa_Queue queue;
-    VkPipelineStageFlags wait_stages;
+    // Stages that wait on the wait semaphores. 0 waits before all commands.
+    // Since daxa 3.1.0 this is a VkPipelineStageFlags2 instead of a VkPipelineStageFlags.
+    // The offsets and size of the struct are unchanged, the field now also spans the former padding after it.
+    // C bindings built against older headers must be rebuilt, as they leave that padding uninitialized.
+    VkPipelineStageFlags2 wait_stages;
     daxa_ExecutableCommandList const * command_lists;
     uint64_t command_list_count;
     daxa_BinarySemaphore const * wait_binary_semaphores;
@@ -452,6 +463,35 @@ typedef struct
     uint64_t build_scratch_size;
 } daxa_AccelerationStructureBuildSizesInfo;
 
+// Descriptor writes for gpu resources are queued and merged into one vkUpdateDescriptorSets call per flush.
+typedef struct
+{
+    uint64_t flush_count;
+    uint64_t flushed_write_count;
+    // Number of writes merged into the most recent flush.
+    uint64_t last_flush_write_count;
+    // Queued writes that were replaced by a later write to the same descriptor before being flushed.
+    uint64_t replaced_write_count;
+} daxa_DescriptorWriteStatistics;
+
+// The bookkeeping vectors of executable command lists are recycled per device.
+typedef struct
+{
+    // Command list data created from scratch because no recycled one was available.
+    uint64_t created_count;
+    uint64_t recycled_count;
+    // Recycled command list data currently waiting to be reused.
+    uint64_t pooled_count;
+} daxa_CommandListDataStatistics;
+
+// Limits the work of a single daxa_dvc_collect_garbage_incremental call. 0 means no limit.
+// The duration is checked between chunks of zombies, so a call may overshoot it by the time of one chunk.
+typedef struct
+{
+    uint64_t max_objects;
+    uint64_t max_duration_nanos;
+} daxa_GarbageCollectionBudget;
+
 DAXA_EXPORT VkMemoryRequirements
 daxa_dvc_buffer_memory_requirements(daxa_Device device, daxa_BufferInfo const * info);
 DAXA_EXPORT VkMemoryRequirements
@@ -497,6 +537,22 @@ daxa_dvc_destroy_tlas(daxa_Device device, daxa_TlasId tlas);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_destroy_blas(daxa_Device device, daxa_BlasId blas);
 
+// Bulk creation allocates the memory of all resources up front and queues all descriptor writes at once.
+// When creation fails, all resources created by the call are destroyed again.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_create_buffers(daxa_Device device, daxa_BufferInfo const * infos, uint64_t count, daxa_BufferId * out_ids);
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_create_images(daxa_Device device, daxa_ImageInfo const * infos, uint64_t count, daxa_ImageId * out_ids);
+// Destroys all valid ids. Returns the invalid id error when any of the ids was invalid.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_destroy_buffers(daxa_Device device, daxa_BufferId const * buffers, uint64_t count);
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_destroy_images(daxa_Device device, daxa_ImageId const * images, uint64_t count);
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_destroy_image_views(daxa_Device device, daxa_ImageViewId const * ids, uint64_t count);
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_destroy_samplers(daxa_Device device, daxa_SamplerId const * samplers, uint64_t count);
+
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_info_buffer(daxa_Device device, daxa_BufferId buffer, daxa_BufferInfo * out_info);
 DAXA_EXPORT daxa_Result
@@ -551,6 +607,13 @@ DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_create_compute_pipeline(daxa_Device device, daxa_ComputePipelineInfo const * info, daxa_ComputePipeline * out_pipeline);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_create_ray_tracing_pipeline(daxa_Device device, daxa_RayTracingPipelineInfo const * info, daxa_RayTracingPipeline * out_pipeline);
+// Creates count pipelines with as few vkCreate*Pipelines calls as possible.
+// The infos are split into thread_count chunks that are created in parallel, 0 uses one thread per hardware thread.
+// When creation fails, all pipelines created by the call are destroyed again.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_create_raster_pipelines(daxa_Device device, daxa_RasterPipelineInfo const * infos, uint32_t count, uint32_t thread_count, daxa_RasterPipeline * out_pipelines);
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_create_compute_pipelines(daxa_Device device, daxa_ComputePipelineInfo const * infos, uint32_t count, uint32_t thread_count, daxa_ComputePipeline * out_pipelines);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_create_swapchain(daxa_Device device, daxa_SwapchainInfo const * info, daxa_Swapchain * out_swapchain);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
@@ -578,10 +641,25 @@ DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_wait_idle(daxa_Device device);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_submit(daxa_Device device, daxa_CommandSubmitInfo const * info);
+// Submits all infos as separate batches of a single vkQueueSubmit2 call. All infos must target the same queue.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_submit_batch(daxa_Device device, daxa_CommandSubmitInfo const * infos, uint64_t info_count);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_present(daxa_Device device, daxa_PresentInfo const * info);
 DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
 daxa_dvc_collect_garbage(daxa_Device device);
+// out_done is optional, it is set to false when zombies ready for destruction are left after the budget is used up.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_collect_garbage_incremental(daxa_Device device, daxa_GarbageCollectionBudget const * budget, daxa_Bool8 * out_done);
+DAXA_EXPORT void
+daxa_dvc_flush_descriptor_writes(daxa_Device device);
+DAXA_EXPORT void
+daxa_dvc_descriptor_write_statistics(daxa_Device device, daxa_DescriptorWriteStatistics * out_statistics);
+// Writes the pipeline cache to DeviceInfo2::pipeline_cache_path. Does nothing without a path.
+DAXA_EXPORT DAXA_NO_DISCARD daxa_Result
+daxa_dvc_save_pipeline_cache(daxa_Device device);
+DAXA_EXPORT void
+daxa_dvc_command_list_data_statistics(daxa_Device device, daxa_CommandListDataStatistics * out_statistics);
 
 DAXA_EXPORT daxa_DeviceInfo2 const *
 daxa_dvc_info(daxa_Device device);
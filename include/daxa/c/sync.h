@@ -166,6 +166,14 @@ typedef struct
 
 typedef daxa_EventSignalInfo daxa_EventWaitInfo;
 
+typedef struct
+{
+    daxa_MemoryBarrierInfo const * memory_barriers;
+    uint64_t memory_barrier_count;
+    daxa_ImageMemoryBarrierInfo const * image_memory_barriers;
+    uint64_t image_memory_barrier_count;
+} daxa_PipelineBarrierInfo;
+
 DAXA_EXPORT daxa_EventInfo const *
 daxa_event_info(daxa_Event event);
 
@@ -123,6 +123,7 @@ typedef enum
     DAXA_RESULT_ERROR_DEVICE_NOT_SUPPORTED = (1 << 30) + 69,
     DAXA_RESULT_DEVICE_DOES_NOT_SUPPORT_ACCELERATION_STRUCTURE_COUNT = (1 << 30) + 70,
     DAXA_RESULT_ERROR_NO_SUITABLE_DEVICE_FOUND = (1 << 30) + 71,
+    DAXA_RESULT_ERROR_FAILED_TO_WRITE_PIPELINE_CACHE = (1 << 30) + 72,
     DAXA_RESULT_MAX_ENUM = 0x7FFFFFFF,
 } daxa_Result;
 
@@ -22,6 +22,10 @@ namespace daxa
     {
         QueueFamily queue_family = {};
         SmallString name = {};
+        // Skips remembering used resource ids and validating them on submit. Saves recording and submit time for trusted command lists.
+        bool disable_submit_validation = {};
+        // Allows submitting the completed command lists multiple times, also while previous submissions are still executing.
+        bool reusable = {};
     };
 
     struct ImageBlitInfo
@@ -388,6 +392,10 @@ namespace daxa
         ///         As soon as a non-pipeline barrier command is recorded, the currently recorded barriers are flushed with a vkCmdPipelineBarrier2 call.
         /// @param info parameters.
         void pipeline_barrier_image_transition(ImageMemoryBarrierInfo const & info);
+        /// @brief  Adds all barriers to the currently recorded barriers.
+        ///         They are flushed together with a single vkCmdPipelineBarrier2 call, regardless of their count.
+        /// @param info parameters.
+        void pipeline_barriers(PipelineBarrierInfo const & info);
         void signal_event(EventSignalInfo const & info);
         void wait_events(std::span<EventWaitInfo const> const & infos);
         void wait_event(EventWaitInfo const & info);
@@ -347,6 +347,11 @@ namespace daxa
         u32 max_allowed_samplers = 400;
         u32 max_allowed_acceleration_structures = 10'000;
         SmallString name = {};
+        // When not 0, a background thread collects garbage in this interval, so collect_garbage never has to be called manually.
+        u32 background_garbage_collection_interval_ms = 0;
+        // When set, pipelines are created through a pipeline cache loaded from this file.
+        // The file is ignored when it was written for a different device or driver version. It is written back when the device is destroyed.
+        char const * pipeline_cache_path = {};
     };
 
     struct Queue
@@ -370,6 +375,7 @@ namespace daxa
     struct CommandSubmitInfo
     {
         Queue queue = daxa::QUEUE_MAIN;
+        // Stages that wait on the wait semaphores. Empty waits before all commands.
         PipelineStageFlags wait_stages = {};
         std::span<ExecutableCommandList const> command_lists = {};
         std::span<BinarySemaphore const> wait_binary_semaphores = {};
@@ -406,6 +412,28 @@ namespace daxa
         u64 build_scratch_size;
     };
 
+    struct DescriptorWriteStatistics
+    {
+        u64 flush_count = {};
+        u64 flushed_write_count = {};
+        u64 last_flush_write_count = {};
+        u64 replaced_write_count = {};
+    };
+
+    struct CommandListDataStatistics
+    {
+        u64 created_count = {};
+        u64 recycled_count = {};
+        u64 pooled_count = {};
+    };
+
+    /// 0 means no limit.
+    struct GarbageCollectionBudget
+    {
+        u64 max_objects = {};
+        u64 max_duration_nanos = {};
+    };
+
     struct BufferTlasInfo
     {
         TlasInfo tlas_info = {};
@@ -480,6 +508,16 @@ namespace daxa
         void destroy(TlasId id) { destroy_tlas(id); }
         void destroy(BlasId id) { destroy_blas(id); }
 
+        /// @brief  Bulk variants of resource creation and destruction, intended for asset streaming.
+        ///         Memory for all resources is allocated up front and their descriptors are written in one batch.
+        ///         Attachment images still get their own allocation.
+        [[nodiscard]] auto create_buffers(std::span<BufferInfo const> infos) -> std::vector<BufferId>;
+        [[nodiscard]] auto create_images(std::span<ImageInfo const> infos) -> std::vector<ImageId>;
+        void destroy_buffers(std::span<BufferId const> ids);
+        void destroy_images(std::span<ImageId const> ids);
+        void destroy_image_views(std::span<ImageViewId const> ids);
+        void destroy_samplers(std::span<SamplerId const> ids);
+
         // TODO: deprecate?
 
         /// @brief  Daxa stores each create info and keeps it up to date if the object changes
@@ -538,6 +576,11 @@ namespace daxa
         [[nodiscard]] auto create_raster_pipeline(RasterPipelineInfo const & info) -> RasterPipeline;
         [[nodiscard]] auto create_compute_pipeline(ComputePipelineInfo const & info) -> ComputePipeline;
         [[nodiscard]] auto create_ray_tracing_pipeline(RayTracingPipelineInfo const & info) -> RayTracingPipeline;
+        /// @brief  Batch variants of pipeline creation, intended for creating all pipelines at startup.
+        ///         The infos are split into thread_count chunks that are created in parallel, each with a single vkCreate*Pipelines call.
+        ///         A thread_count of 0 uses one thread per hardware thread.
+        [[nodiscard]] auto create_raster_pipelines(std::span<RasterPipelineInfo const> infos, u32 thread_count = 1) -> std::vector<RasterPipeline>;
+        [[nodiscard]] auto create_compute_pipelines(std::span<ComputePipelineInfo const> infos, u32 thread_count = 1) -> std::vector<ComputePipeline>;
 
         [[nodiscard]] auto create_swapchain(SwapchainInfo const & info) -> Swapchain;
         [[nodiscard]] auto create_command_recorder(CommandRecorderInfo const & info) -> CommandRecorder;
@@ -554,6 +597,9 @@ namespace daxa
         auto queue_count(QueueFamily queue_count) -> u32;
 
         void submit_commands(CommandSubmitInfo const & submit_info);
+        /// @brief  Submits all infos as separate batches of a single queue submission.
+        ///         Cheaper than calling submit_commands for each info. All infos must target the same queue.
+        void submit_commands_batch(std::span<CommandSubmitInfo const> submit_infos);
         void present_frame(PresentInfo const & info);
 
         /// @brief  Actually destroys all resources that are ready to be destroyed.
@@ -561,11 +607,28 @@ namespace daxa
         ///         A zombie lives until the gpu catches up to the point of zombification.
         /// NOTE:
         /// * this function will block until it gains an exclusive resource lock
+        /// * the exclusive lock is only held while recycling the resource slots of a small chunk of zombies at a time
         /// * command lists may hold shared lifetime locks, those must all unlock before an exclusive lock can be made
         /// * look at CommandRecorder for more info on this
         /// * SoftwareCommandRecorder is exempt from this limitation,
         ///   you can freely record those in parallel with collect_garbage
         void collect_garbage();
+        /// @brief  Same as collect_garbage, but returns early once the budget is used up.
+        ///         The duration is checked between chunks, a call may overshoot it by the time of one chunk.
+        /// @return true when no zombies ready for destruction are left.
+        auto collect_garbage_incremental(GarbageCollectionBudget const & budget) -> bool;
+
+        /// @brief  Descriptor writes of created and destroyed resources are queued and merged.
+        ///         They are flushed automatically before each submit and during collect_garbage.
+        ///         Flushing manually is only needed when the descriptor set is used outside of daxa submits.
+        void flush_descriptor_writes();
+        [[nodiscard]] auto descriptor_write_statistics() const -> DescriptorWriteStatistics;
+        /// @brief  Writes the pipeline cache to DeviceInfo2::pipeline_cache_path. Does nothing without a path.
+        ///         Also happens automatically when the device is destroyed.
+        void save_pipeline_cache();
+        /// @brief  Executable command list bookkeeping is recycled once the list is destroyed.
+        ///         created_count only grows when no recycled data was available.
+        [[nodiscard]] auto command_list_data_statistics() const -> CommandListDataStatistics;
 
         /// THREADSAFETY:
         /// * reference MUST NOT be read after the device is destroyed.
@@ -103,4 +103,10 @@ namespace daxa
     };
 
     using EventWaitInfo = EventSignalInfo;
+
+    struct PipelineBarrierInfo
+    {
+        std::span<MemoryBarrierInfo const> memory_barriers = {};
+        std::span<ImageMemoryBarrierInfo const> image_barriers = {};
+    };
 } // namespace daxa
\ No newline at end of file
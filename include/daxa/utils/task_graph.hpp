@@ -48,6 +48,35 @@ namespace daxa
         Variant<TaskBufferView, std::string> aliased_buffer = {};
     };
 
+    struct TransientHeapInfo
+    {
+        Device device = {};
+        std::string name = {};
+    };
+
+    struct ImplTransientHeap;
+    /// @brief  Memory block shared by the transient resources of multiple task graphs.
+    ///         Graphs using the same heap alias their transient resources into the same memory.
+    ///         The heap grows to the largest transient memory requirement of the graphs using it.
+    struct DAXA_EXPORT_CXX TransientHeap : ManagedPtr<TransientHeap, ImplTransientHeap *>
+    {
+        TransientHeap() = default;
+        TransientHeap(TransientHeapInfo const & info);
+
+        /// THREADSAFETY:
+        /// * reference MUST NOT be read after the object is destroyed.
+        /// @return reference to info of object.
+        auto info() const -> TransientHeapInfo const &;
+        /// @return size of the memory block currently backing the heap.
+        auto size() const -> usize;
+
+      protected:
+        template <typename T, typename H_T>
+        friend struct ManagedPtr;
+        static auto inc_refcnt(ImplHandle const * object) -> u64;
+        static auto dec_refcnt(ImplHandle const * object) -> u64;
+    };
+
     struct TaskGraphInfo
     {
         Device device = {};
@@ -56,8 +85,30 @@ namespace daxa
         /// @brief  Task reordering can drastically improve performance,
         ///         yet is it also nice to have sequential callback execution.
         bool reorder_tasks = true;
+        /// @brief  Schedules the tasks of each submit scope with a list scheduler over their full dependency graph,
+        ///         instead of inserting each task at the earliest batch in recording order.
+        ///         Reads of a resource are no longer ordered behind each other
+        ///         and tasks without dependencies are delayed until just before the first task depending on them.
+        ///         This reduces the number of batches and split barriers, at the cost of a slower complete.
+        ///         Requires reorder_tasks.
+        bool minimize_barriers = {};
+        /// @brief  Removes tasks whose outputs are never used from each permutation.
+        ///         A task is kept when it writes a persistent resource or the swapchain, has side effects, has no write attachments,
+        ///         or when a kept task after it reads a resource it writes. Producers of culled tasks are culled transitively.
+        ///         The culled tasks of the executed permutation are listed in the debug string.
+        bool cull_dead_tasks = {};
         /// @brief  Allows task graph to alias transient resources memory (ofc only when that wont break the program)
         bool alias_transients = {};
+        /// @brief  Places the transient resources into a heap shared with other task graphs instead of memory owned by this graph.
+        ///         All graphs using the same heap must be executed one after another on the main queue.
+        ///         Executing and completing graphs sharing a heap is not threadsafe.
+        std::optional<TransientHeap> transient_heap = {};
+        /// @brief  Number of executions whose transient resources can be in use by the gpu at the same time.
+        ///         Each frame in flight gets its own transient memory and its own runtime transient buffers and images.
+        ///         Consecutive executions use the frames round robin, so the gpu work of an execution can overlap the previous executions.
+        ///         Before executing, the caller must make sure the execution frames_in_flight executions earlier finished on the gpu, as with any other per frame resource.
+        ///         Multiplies the transient memory. Can not be combined with a transient_heap or static_execution.
+        u32 frames_in_flight = 1;
         /// @brief  Some drivers have bad implementations for split barriers.
         ///         If that is the case for you, you can turn off all use of split barriers.
         ///         Daxa will use pipeline barriers instead if this is set.
@@ -66,13 +117,31 @@ namespace daxa
         ///         For a low number of permutations its is preferable to precompile all permutations.
         ///         For a large number of permutations it might be preferable to only create the permutations actually used on the fly just before they are needed.
         ///         The second option is enabled by using jit (just in time) compilation.
+        ///         With jit compilation, a permutation is compiled on its first execution and cached for later executions.
         bool jit_compile_permutations = {};
+        /// @brief  Limits the number of jit compiled permutations kept alive at once, 0 means unlimited.
+        ///         When the limit is reached, the least recently executed permutation and its transient resources are evicted.
+        u32 jit_max_cached_permutations = {};
         /// @brief  Task graph can branch the execution based on conditionals. All conditionals must be set before execution and stay constant while executing.
         ///         This is useful to create permutations of a task graph without having to create a separate task graph.
         ///         Another benefit is that task graph can generate synch between executions of permutations while it can not generate synch between two separate task graphs.
         usize permutation_condition_count = {};
         /// @brief  Task graph will put performance markers that are used by profilers like nsight around each tasks execution by default.
         bool enable_command_labels = true;
+        /// @brief  Records the tasks of each submit scope on multiple threads.
+        ///         The tasks are split into contiguous ranges, each range is recorded into its own command list and the lists are submitted in order.
+        ///         When enabled, task callbacks are called concurrently and must be safe to run in parallel.
+        bool enable_parallel_recording = {};
+        /// @brief  Maximum number of threads used for parallel recording, 0 means one thread per hardware thread.
+        ///         Each additional thread gets its own staging memory pool of staging_memory_pool_size.
+        u32 parallel_recording_thread_count = {};
+        /// @brief  Records the commands of each permutation on its first execution and resubmits them in later executions without calling the task callbacks.
+        ///         The commands are replayed as long as the runtime resources of the persistent task buffers and images used by the permutation stay the same.
+        ///         Changing them, for example with TaskImage::set_images or TaskBuffer::set_buffers, re-records the permutation on its next execution.
+        ///         Task callbacks must record the same commands in every execution. Data written with the staging allocator of a task is only written once.
+        ///         Recording a permutation discards the commands of permutations that read staging memory, as the recording can overwrite it.
+        ///         Can not be combined with a swapchain, as the acquired swapchain image changes every frame.
+        bool static_execution = {};
         std::array<f32, 4> task_graph_label_color = {0.463f, 0.333f, 0.671f, 1.0f};
         std::array<f32, 4> task_batch_label_color = {0.563f, 0.433f, 0.771f, 1.0f};
         std::array<f32, 4> task_label_color = {0.663f, 0.533f, 0.871f, 1.0f};
@@ -102,6 +171,11 @@ namespace daxa
 
     struct TaskCompleteInfo
     {
+        /// @brief  Compiled permutations returned by TaskGraph::serialize_compiled_permutations of an earlier run.
+        ///         When the data matches the recorded tasks, resources, graph info and device, complete skips compilation and only creates the transient resources.
+        ///         Data that does not match is ignored and the permutations are compiled as usual.
+        ///         Ignored with jit compilation.
+        std::span<std::byte const> serialized_permutations = {};
     };
 
     struct TaskImageLastUse
@@ -118,6 +192,56 @@ namespace daxa
         std::function<void()> when_false = {};
     };
 
+    struct TaskGraphJitStatistics
+    {
+        /// @brief  Permutations compiled on first use, recompilations after eviction included.
+        u32 compiled_permutations = {};
+        u32 cached_permutations = {};
+        u32 evicted_permutations = {};
+        /// @brief  Time the last execute spent compiling its permutation, zero when the permutation was cached.
+        u64 last_compile_nanos = {};
+        u64 total_compile_nanos = {};
+    };
+
+    struct TaskTransientMemoryStatistics
+    {
+        /// @brief  Lower bound of the transient memory, the most bytes of transient resources alive within one batch.
+        usize peak_live_bytes = {};
+        /// @brief  Transient memory allocated by the task graph for all frames in flight, or the size of its transient heap.
+        usize allocated_bytes = {};
+        /// @brief  Transient memory needed without aliasing.
+        usize unaliased_bytes = {};
+        u64 memory_requirements_cache_hits = {};
+        u64 memory_requirements_cache_misses = {};
+    };
+
+    struct TaskScheduleStatistics
+    {
+        usize batch_count = {};
+        /// @brief  Batches that wait on pipeline or split barriers before their tasks execute.
+        usize barrier_point_count = {};
+        usize pipeline_barrier_count = {};
+        usize split_barrier_count = {};
+    };
+
+    struct TaskGraphSchedulingStatistics
+    {
+        /// @brief  Schedule of the default scheduler, placing each task at the earliest batch in recording order.
+        ///         With minimize_barriers, it is only computed when record_debug_information is enabled and equals scheduled otherwise.
+        TaskScheduleStatistics earliest_batch = {};
+        /// @brief  Schedule used for execution, only differs from earliest_batch when minimize_barriers is enabled.
+        TaskScheduleStatistics scheduled = {};
+    };
+
+    struct TaskGraphStaticExecutionStatistics
+    {
+        /// @brief  Executions that called the task callbacks, re-recordings included.
+        u64 recorded_executions = {};
+        u64 replayed_executions = {};
+        /// @brief  Discarded recordings, because the runtime resources changed or another permutation was recorded while they read staging memory.
+        u64 invalidations = {};
+    };
+
     struct ExecutionInfo
     {
         std::span<bool> permutation_condition_values = {};
@@ -139,6 +263,11 @@ namespace daxa
         std::vector<TaskAttachmentInfo> attachments = {};
         std::function<void(TaskInterface)> task = {};
         std::string_view name = "unnamed";
+        /// @brief  Async compute and transfer queues run the task overlapped with the main queue.
+        ///         The task must only record commands valid on that queue. Images it uses must be created with SharingMode::CONCURRENT.
+        Queue queue = QUEUE_MAIN;
+        /// @brief  Keeps the task when dead task culling is enabled, even if none of its outputs are used.
+        bool has_side_effects = {};
     };
 
     struct InlineTask : ITask
@@ -148,6 +277,8 @@ namespace daxa
             _attachments = info.attachments;
             _callback = info.task;
             _name = info.name;
+            _queue = info.queue;
+            _has_side_effects = info.has_side_effects;
         }
         constexpr virtual auto attachments() -> std::span<TaskAttachmentInfo> override
         {
@@ -158,6 +289,8 @@ namespace daxa
             return _attachments;
         }
         constexpr virtual std::string_view name() const override { return _name; };
+        virtual auto queue() const -> Queue override { return _queue; }
+        virtual auto has_side_effects() const -> bool override { return _has_side_effects; }
         virtual void callback(TaskInterface ti) override
         {
             _callback(ti);
@@ -167,6 +300,8 @@ namespace daxa
         std::vector<TaskAttachmentInfo> _attachments = {};
         std::function<void(TaskInterface)> _callback = {};
         std::string_view _name = {};
+        Queue _queue = QUEUE_MAIN;
+        bool _has_side_effects = {};
     };
 
     struct ImplTaskGraph;
@@ -256,6 +391,30 @@ namespace daxa
                 constexpr virtual auto attachments() -> std::span<TaskAttachmentInfo> { return _attachments; }
                 constexpr virtual auto attachments() const -> std::span<TaskAttachmentInfo const> { return _attachments; }
                 constexpr virtual auto name() const -> std::string_view { return NoRefTTask::name(); }
+                virtual auto queue() const -> Queue
+                {
+                    // Tasks can choose their queue with a queue member.
+                    if constexpr (requires { Queue{_task.queue}; })
+                    {
+                        return _task.queue;
+                    }
+                    else
+                    {
+                        return QUEUE_MAIN;
+                    }
+                }
+                virtual auto has_side_effects() const -> bool
+                {
+                    // Tasks can mark themselves as having side effects with a has_side_effects member.
+                    if constexpr (requires { bool{_task.has_side_effects}; })
+                    {
+                        return _task.has_side_effects;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
                 virtual void callback(TaskInterface ti) { _task.callback(ti); };
             };
             auto wrapped_task = std::make_unique<WrapperTask>(task);
@@ -277,6 +436,19 @@ namespace daxa
 
         DAXA_EXPORT_CXX auto get_debug_string() -> std::string;
         DAXA_EXPORT_CXX auto get_transient_memory_size() -> daxa::usize;
+        DAXA_EXPORT_CXX auto get_jit_statistics() const -> TaskGraphJitStatistics;
+        /// @brief  With jit compilation, the byte counts are summed over all cached permutations, as each has its own memory.
+        ///         Otherwise they are the maximum over all permutations, which share one memory block.
+        DAXA_EXPORT_CXX auto get_transient_memory_statistics() const -> TaskTransientMemoryStatistics;
+        /// @brief  Summed over all compiled permutations.
+        DAXA_EXPORT_CXX auto get_scheduling_statistics() const -> TaskGraphSchedulingStatistics;
+        DAXA_EXPORT_CXX auto get_static_execution_statistics() const -> TaskGraphStaticExecutionStatistics;
+        /// @brief  Serializes the batches, barriers and transient resource placement of all compiled permutations.
+        ///         The data can be passed to TaskCompleteInfo::serialized_permutations to skip compilation in later runs.
+        ///         Only valid for completed graphs without jit compilation.
+        DAXA_EXPORT_CXX auto serialize_compiled_permutations() const -> std::vector<std::byte>;
+        /// @brief  True when complete used the serialized permutations instead of compiling them.
+        DAXA_EXPORT_CXX auto loaded_serialized_permutations() const -> bool;
 
       protected:
         template <typename T, typename H_T>
@@ -668,6 +668,10 @@ namespace daxa
         constexpr virtual auto attachments() -> std::span<TaskAttachmentInfo> = 0;
         constexpr virtual auto attachments() const -> std::span<TaskAttachmentInfo const> = 0;
         constexpr virtual std::string_view name() const = 0;
+        /// @brief  Queue the task prefers to run on. Task graph schedules it onto this queue when the device has it.
+        virtual auto queue() const -> Queue { return QUEUE_MAIN; }
+        /// @brief  Tasks with side effects invisible to the graph are never removed by dead task culling.
+        virtual auto has_side_effects() const -> bool { return false; }
         virtual void callback(TaskInterface){};
     };
 
@@ -136,6 +136,7 @@ auto daxa_result_to_string(daxa_Result result) -> std::string_view
     case daxa_Result::DAXA_RESULT_ERROR_DEVICE_NOT_SUPPORTED: return "DAXA_RESULT_ERROR_DEVICE_NOT_SUPPORTED";
     case daxa_Result::DAXA_RESULT_DEVICE_DOES_NOT_SUPPORT_ACCELERATION_STRUCTURE_COUNT: return "DAXA_RESULT_DEVICE_DOES_NOT_SUPPORT_ACCELERATION_STRUCTURE_COUNT";
     case daxa_Result::DAXA_RESULT_ERROR_NO_SUITABLE_DEVICE_FOUND: return "DAXA_RESULT_ERROR_NO_SUITABLE_DEVICE_FOUND";
+    case daxa_Result::DAXA_RESULT_ERROR_FAILED_TO_WRITE_PIPELINE_CACHE: return "DAXA_RESULT_ERROR_FAILED_TO_WRITE_PIPELINE_CACHE";
     case daxa_Result::DAXA_RESULT_MAX_ENUM: return "DAXA_RESULT_MAX_ENUM";
     default: return "UNIMPLEMENTED";
     }
@@ -161,6 +162,24 @@ void check_result(daxa_Result result, char const * message, std::array<daxa_Resu
     }
 }
 
+auto to_c_command_submit_info(daxa::CommandSubmitInfo const & submit_info) -> daxa_CommandSubmitInfo
+{
+    return daxa_CommandSubmitInfo{
+        .queue = std::bit_cast<daxa_Queue>(submit_info.queue),
+        .wait_stages = static_cast<VkPipelineStageFlags2>(submit_info.wait_stages.data),
+        .command_lists = reinterpret_cast<daxa_ExecutableCommandList const *>(submit_info.command_lists.data()),
+        .command_list_count = submit_info.command_lists.size(),
+        .wait_binary_semaphores = reinterpret_cast<daxa_BinarySemaphore const *>(submit_info.wait_binary_semaphores.data()),
+        .wait_binary_semaphore_count = submit_info.wait_binary_semaphores.size(),
+        .signal_binary_semaphores = reinterpret_cast<daxa_BinarySemaphore const *>(submit_info.signal_binary_semaphores.data()),
+        .signal_binary_semaphore_count = submit_info.signal_binary_semaphores.size(),
+        .wait_timeline_semaphores = reinterpret_cast<daxa_TimelinePair const *>(submit_info.wait_timeline_semaphores.data()),
+        .wait_timeline_semaphore_count = submit_info.wait_timeline_semaphores.size(),
+        .signal_timeline_semaphores = reinterpret_cast<daxa_TimelinePair const *>(submit_info.signal_timeline_semaphores.data()),
+        .signal_timeline_semaphore_count = submit_info.signal_timeline_semaphores.size(),
+    };
+}
+
 // --- End Helpers ---
 
 namespace daxa
@@ -385,6 +404,37 @@ namespace daxa
     DAXA_DECL_GPU_RES_FN(Tlas, tlas)
     DAXA_DECL_GPU_RES_FN(Blas, blas)
 
+#define DAXA_DECL_GPU_RES_BULK_FN(Name, name)                                                 \
+    auto Device::create_##name##s(std::span<Name##Info const> infos) -> std::vector<Name##Id> \
+    {                                                                                         \
+        std::vector<Name##Id> ids(infos.size());                                              \
+        check_result(                                                                         \
+            daxa_dvc_create_##name##s(                                                        \
+                r_cast<daxa_Device>(this->object),                                            \
+                r_cast<daxa_##Name##Info const *>(infos.data()),                              \
+                infos.size(),                                                                 \
+                r_cast<daxa_##Name##Id *>(ids.data())),                                       \
+            "failed to create " #name "s");                                                   \
+        return ids;                                                                           \
+    }
+
+#define DAXA_DECL_GPU_RES_BULK_DESTROY_FN(Name, name)             \
+    void Device::destroy_##name##s(std::span<Name##Id const> ids) \
+    {                                                             \
+        auto result = daxa_dvc_destroy_##name##s(                 \
+            r_cast<daxa_Device>(this->object),                    \
+            r_cast<daxa_##Name##Id const *>(ids.data()),          \
+            ids.size());                                          \
+        check_result(result, "invalid resource id");              \
+    }
+
+    DAXA_DECL_GPU_RES_BULK_FN(Buffer, buffer)
+    DAXA_DECL_GPU_RES_BULK_FN(Image, image)
+    DAXA_DECL_GPU_RES_BULK_DESTROY_FN(Buffer, buffer)
+    DAXA_DECL_GPU_RES_BULK_DESTROY_FN(Image, image)
+    DAXA_DECL_GPU_RES_BULK_DESTROY_FN(ImageView, image_view)
+    DAXA_DECL_GPU_RES_BULK_DESTROY_FN(Sampler, sampler)
+
     auto Device::buffer_device_address(BufferId id) const -> Optional<DeviceAddress>
     {
         DeviceAddress ret = 0;
@@ -511,6 +561,23 @@ namespace daxa
     DAXA_DECL_DVC_CREATE_FN(Event, event)
     DAXA_DECL_DVC_CREATE_FN(TimelineQueryPool, timeline_query_pool)
 
+#define DAXA_DECL_DVC_CREATE_PIPELINES_FN(Name, name)                                                       \
+    auto Device::create_##name##s(std::span<Name##Info const> infos, u32 thread_count) -> std::vector<Name> \
+    {                                                                                                       \
+        std::vector<Name> ret(infos.size());                                                                \
+        check_result(daxa_dvc_create_##name##s(                                                             \
+                         r_cast<daxa_Device>(this->object),                                                 \
+                         r_cast<daxa_##Name##Info const *>(infos.data()),                                   \
+                         static_cast<u32>(infos.size()),                                                    \
+                         thread_count,                                                                      \
+                         r_cast<daxa_##Name *>(ret.data())),                                                \
+                     "failed to create " #name "s");                                                        \
+        return ret;                                                                                         \
+    }
+
+    DAXA_DECL_DVC_CREATE_PIPELINES_FN(RasterPipeline, raster_pipeline)
+    DAXA_DECL_DVC_CREATE_PIPELINES_FN(ComputePipeline, compute_pipeline)
+
     auto Device::info() const -> DeviceInfo2 const &
     {
         return *r_cast<DeviceInfo2 const *>(daxa_dvc_info(rc_cast<daxa_Device>(this->object)));
@@ -538,25 +605,25 @@ namespace daxa
 
     void Device::submit_commands(CommandSubmitInfo const & submit_info)
     {
-        daxa_CommandSubmitInfo const c_submit_info = {
-            .queue = std::bit_cast<daxa_Queue>(submit_info.queue),
-            .wait_stages = static_cast<VkPipelineStageFlags>(submit_info.wait_stages.data),
-            .command_lists = reinterpret_cast<daxa_ExecutableCommandList const *>(submit_info.command_lists.data()),
-            .command_list_count = submit_info.command_lists.size(),
-            .wait_binary_semaphores = reinterpret_cast<daxa_BinarySemaphore const *>(submit_info.wait_binary_semaphores.data()),
-            .wait_binary_semaphore_count = submit_info.wait_binary_semaphores.size(),
-            .signal_binary_semaphores = reinterpret_cast<daxa_BinarySemaphore const *>(submit_info.signal_binary_semaphores.data()),
-            .signal_binary_semaphore_count = submit_info.signal_binary_semaphores.size(),
-            .wait_timeline_semaphores = reinterpret_cast<daxa_TimelinePair const *>(submit_info.wait_timeline_semaphores.data()),
-            .wait_timeline_semaphore_count = submit_info.wait_timeline_semaphores.size(),
-            .signal_timeline_semaphores = reinterpret_cast<daxa_TimelinePair const *>(submit_info.signal_timeline_semaphores.data()),
-            .signal_timeline_semaphore_count = submit_info.signal_timeline_semaphores.size(),
-        };
+        daxa_CommandSubmitInfo const c_submit_info = to_c_command_submit_info(submit_info);
         check_result(
             daxa_dvc_submit(r_cast<daxa_Device>(this->object), &c_submit_info),
             "failed to submit commands");
     }
 
+    void Device::submit_commands_batch(std::span<CommandSubmitInfo const> submit_infos)
+    {
+        std::vector<daxa_CommandSubmitInfo> c_submit_infos = {};
+        c_submit_infos.reserve(submit_infos.size());
+        for (auto const & submit_info : submit_infos)
+        {
+            c_submit_infos.push_back(to_c_command_submit_info(submit_info));
+        }
+        check_result(
+            daxa_dvc_submit_batch(r_cast<daxa_Device>(this->object), c_submit_infos.data(), c_submit_infos.size()),
+            "failed to submit commands");
+    }
+
     void Device::present_frame(PresentInfo const & info)
     {
         daxa_PresentInfo const c_present_info = {
@@ -576,6 +643,41 @@ namespace daxa
             "failed to collect garbage");
     }
 
+    auto Device::collect_garbage_incremental(GarbageCollectionBudget const & budget) -> bool
+    {
+        daxa_Bool8 done = {};
+        check_result(
+            daxa_dvc_collect_garbage_incremental(r_cast<daxa_Device>(this->object), r_cast<daxa_GarbageCollectionBudget const *>(&budget), &done),
+            "failed to collect garbage");
+        return done != 0;
+    }
+
+    void Device::flush_descriptor_writes()
+    {
+        daxa_dvc_flush_descriptor_writes(r_cast<daxa_Device>(this->object));
+    }
+
+    auto Device::descriptor_write_statistics() const -> DescriptorWriteStatistics
+    {
+        DescriptorWriteStatistics ret = {};
+        daxa_dvc_descriptor_write_statistics(rc_cast<daxa_Device>(this->object), r_cast<daxa_DescriptorWriteStatistics *>(&ret));
+        return ret;
+    }
+
+    void Device::save_pipeline_cache()
+    {
+        check_result(
+            daxa_dvc_save_pipeline_cache(r_cast<daxa_Device>(this->object)),
+            "failed to save pipeline cache");
+    }
+
+    auto Device::command_list_data_statistics() const -> CommandListDataStatistics
+    {
+        CommandListDataStatistics ret = {};
+        daxa_dvc_command_list_data_statistics(rc_cast<daxa_Device>(this->object), r_cast<daxa_CommandListDataStatistics *>(&ret));
+        return ret;
+    }
+
     auto Device::properties() const -> DeviceProperties const &
     {
         return *r_cast<DeviceProperties const *>(daxa_dvc_properties(rc_cast<daxa_Device>(object)));
@@ -1069,6 +1171,7 @@ namespace daxa
     }
     DAXA_DECL_COMMAND_LIST_WRAPPER(TransferCommandRecorder, pipeline_barrier, MemoryBarrierInfo)
     DAXA_DECL_COMMAND_LIST_WRAPPER_CHECK_RESULT(TransferCommandRecorder, pipeline_barrier_image_transition, ImageMemoryBarrierInfo)
+    DAXA_DECL_COMMAND_LIST_WRAPPER_CHECK_RESULT(TransferCommandRecorder, pipeline_barriers, PipelineBarrierInfo)
     DAXA_DECL_COMMAND_LIST_WRAPPER(TransferCommandRecorder, signal_event, EventSignalInfo)
 
     void TransferCommandRecorder::wait_events(std::span<EventWaitInfo const> const & infos)
@@ -2,6 +2,7 @@
 
 #include <daxa/c/types.h>
 #include <utility>
+#include <algorithm>
 
 #include "impl_sync.hpp"
 #include "impl_device.hpp"
@@ -92,6 +93,39 @@ void CommandPoolPool::cleanup(daxa_Device device)
     pools_and_buffers.clear();
 }
 
+auto CommandListDataPool::get() -> ExecutableCommandListData
+{
+    std::unique_lock const lock{this->mtx};
+    if (this->pooled.empty())
+    {
+        ++this->statistics.created_count;
+        return ExecutableCommandListData{};
+    }
+    ++this->statistics.recycled_count;
+    ExecutableCommandListData data = std::move(this->pooled.back());
+    this->pooled.pop_back();
+    this->statistics.pooled_count = this->pooled.size();
+    return data;
+}
+
+void CommandListDataPool::put_back(ExecutableCommandListData && data)
+{
+    data.vk_cmd_buffer = {};
+    data.deferred_destructions.clear();
+    data.used_buffers.clear();
+    data.used_images.clear();
+    data.used_image_views.clear();
+    data.used_samplers.clear();
+    data.used_tlass.clear();
+    data.used_blass.clear();
+    std::unique_lock const lock{this->mtx};
+    if (this->pooled.size() < MAX_POOLED_DATA)
+    {
+        this->pooled.push_back(std::move(data));
+        this->statistics.pooled_count = this->pooled.size();
+    }
+}
+
 template <typename T>
 auto only_check_buffer(daxa_CommandRecorder self, T id) -> bool
 {
@@ -167,29 +201,51 @@ auto only_check_blas(daxa_CommandRecorder self, T id) -> bool
 template <typename T>
 void remember_ids(daxa_CommandRecorder self, T id)
 {
+    if (self->info.disable_submit_validation != 0)
+    {
+        return;
+    }
     if constexpr (std::is_same_v<daxa_BufferId, T>)
     {
-        self->current_command_data.used_buffers.push_back(std::bit_cast<BufferId>(id));
+        if (self->remembered_buffers.insert(std::bit_cast<u64>(id)))
+        {
+            self->current_command_data.used_buffers.push_back(std::bit_cast<BufferId>(id));
+        }
     }
     if constexpr (std::is_same_v<daxa_ImageId, T>)
     {
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(id));
+        if (self->remembered_images.insert(std::bit_cast<u64>(id)))
+        {
+            self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(id));
+        }
     }
     if constexpr (std::is_same_v<daxa_ImageViewId, T>)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(id));
+        if (self->remembered_image_views.insert(std::bit_cast<u64>(id)))
+        {
+            self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(id));
+        }
     }
     if constexpr (std::is_same_v<daxa_SamplerId, T>)
     {
-        self->current_command_data.used_samplers.push_back(std::bit_cast<SamplerId>(id));
+        if (self->remembered_samplers.insert(std::bit_cast<u64>(id)))
+        {
+            self->current_command_data.used_samplers.push_back(std::bit_cast<SamplerId>(id));
+        }
     }
     if constexpr (std::is_same_v<daxa_TlasId, T>)
     {
-        self->current_command_data.used_tlass.push_back(std::bit_cast<TlasId>(id));
+        if (self->remembered_tlass.insert(std::bit_cast<u64>(id)))
+        {
+            self->current_command_data.used_tlass.push_back(std::bit_cast<TlasId>(id));
+        }
     }
     if constexpr (std::is_same_v<daxa_BlasId, T>)
     {
-        self->current_command_data.used_blass.push_back(std::bit_cast<BlasId>(id));
+        if (self->remembered_blass.insert(std::bit_cast<u64>(id)))
+        {
+            self->current_command_data.used_blass.push_back(std::bit_cast<BlasId>(id));
+        }
     }
 }
 
@@ -264,8 +320,8 @@ auto daxa_cmd_copy_buffer_to_buffer(daxa_CommandRecorder self, daxa_BufferCopyIn
     ImplBufferSlot const & src_slot = self->device->slot(info->src_buffer);
     ImplBufferSlot const & dst_slot = self->device->slot(info->dst_buffer);
     bool in_bounds = true;
-    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->srcOffset) + static_cast<u64>(vk_buffer_copy->size)) <= static_cast<u64>(src_slot.info.size));
-    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->dstOffset) + static_cast<u64>(vk_buffer_copy->size)) <= static_cast<u64>(dst_slot.info.size));
+    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->srcOffset) + static_cast<u64>(vk_buffer_copy->size)) <= static_cast<u64>(self->device->cold_slot(info->src_buffer).info.size));
+    in_bounds = in_bounds && ((static_cast<u64>(vk_buffer_copy->dstOffset) + static_cast<u64>(vk_buffer_copy->size)) <= static_cast<u64>(self->device->cold_slot(info->dst_buffer).info.size));
     if (!in_bounds)
     {
         return DAXA_RESULT_ERROR_COPY_OUT_OF_BOUNDS;
@@ -460,9 +516,10 @@ auto daxa_cmd_clear_image(daxa_CommandRecorder self, daxa_ImageClearInfo const *
     daxa_cmd_flush_barriers(self);
     DAXA_CHECK_AND_REMEMBER_IDS(self, info->image)
     auto const & img_slot = self->device->slot(info->image);
+    auto const & img_slot_cold = self->device->cold_slot(info->image);
     bool const is_image_depth_stencil =
-        is_depth_format(std::bit_cast<Format>(img_slot.info.format)) ||
-        is_stencil_format(std::bit_cast<Format>(img_slot.info.format));
+        is_depth_format(std::bit_cast<Format>(img_slot_cold.info.format)) ||
+        is_stencil_format(std::bit_cast<Format>(img_slot_cold.info.format));
     bool const is_clear_depth_stencil = info->clear_value.index == 3;
     if (is_clear_depth_stencil)
     {
@@ -502,18 +559,14 @@ auto daxa_cmd_clear_image(daxa_CommandRecorder self, daxa_ImageClearInfo const *
 /// @param info parameters.
 void daxa_cmd_pipeline_barrier(daxa_CommandRecorder self, daxa_MemoryBarrierInfo const * info)
 {
-    if (self->memory_barrier_batch_count == COMMAND_LIST_BARRIER_MAX_BATCH_SIZE)
-    {
-        daxa_cmd_flush_barriers(self);
-    }
-    self->memory_barrier_batch.at(self->memory_barrier_batch_count++) = {
+    self->memory_barrier_batch.push_back({
         .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
         .pNext = nullptr,
         .srcStageMask = info->src_access.stages,
         .srcAccessMask = info->src_access.access_type,
         .dstStageMask = info->dst_access.stages,
         .dstAccessMask = info->dst_access.access_type,
-    };
+    });
 }
 
 /// @brief  Successive pipeline barrier calls are combined.
@@ -522,12 +575,8 @@ void daxa_cmd_pipeline_barrier(daxa_CommandRecorder self, daxa_MemoryBarrierInfo
 auto daxa_cmd_pipeline_barrier_image_transition(daxa_CommandRecorder self, daxa_ImageMemoryBarrierInfo const * info) -> daxa_Result
 {
     DAXA_CHECK_AND_REMEMBER_IDS(self, info->image_id)
-    if (self->image_barrier_batch_count == COMMAND_LIST_BARRIER_MAX_BATCH_SIZE)
-    {
-        daxa_cmd_flush_barriers(self);
-    }
     auto const & img_slot = self->device->slot(info->image_id);
-    self->image_barrier_batch.at(self->image_barrier_batch_count++) = {
+    self->image_barrier_batch.push_back({
         .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
         .pNext = nullptr,
         .srcStageMask = info->src_access.stages,
@@ -540,7 +589,29 @@ auto daxa_cmd_pipeline_barrier_image_transition(daxa_CommandRecorder self, daxa_
         .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
         .image = img_slot.vk_image,
         .subresourceRange = make_subresource_range(info->image_slice, img_slot.aspect_flags),
-    };
+    });
+    return DAXA_RESULT_SUCCESS;
+}
+
+/// @brief  Adds all barriers to the currently recorded barriers.
+///         They are flushed together with a single vkCmdPipelineBarrier2 call, regardless of their count.
+/// @param info parameters.
+auto daxa_cmd_pipeline_barriers(daxa_CommandRecorder self, daxa_PipelineBarrierInfo const * info) -> daxa_Result
+{
+    self->memory_barrier_batch.reserve(self->memory_barrier_batch.size() + info->memory_barrier_count);
+    for (u64 i = 0; i < info->memory_barrier_count; ++i)
+    {
+        daxa_cmd_pipeline_barrier(self, &info->memory_barriers[i]);
+    }
+    self->image_barrier_batch.reserve(self->image_barrier_batch.size() + info->image_memory_barrier_count);
+    for (u64 i = 0; i < info->image_memory_barrier_count; ++i)
+    {
+        auto result = daxa_cmd_pipeline_barrier_image_transition(self, &info->image_memory_barriers[i]);
+        if (result != DAXA_RESULT_SUCCESS)
+        {
+            return result;
+        }
+    }
     return DAXA_RESULT_SUCCESS;
 }
 struct SplitBarrierDependencyInfoBuffer
@@ -821,7 +892,7 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
         {
             return DAXA_RESULT_INVALID_IMAGE_VIEW_ID;
         }
-        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->color_attachments.data[i].image_view).info.image) == 0)
+        if (daxa_dvc_is_image_valid(self->device, self->device->cold_slot(info->color_attachments.data[i].image_view).info.image) == 0)
         {
             return DAXA_RESULT_INVALID_IMAGE_ID;
         }
@@ -834,7 +905,7 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
         {
             return DAXA_RESULT_INVALID_IMAGE_VIEW_ID;
         }
-        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->depth_attachment.value.image_view).info.image) == 0)
+        if (daxa_dvc_is_image_valid(self->device, self->device->cold_slot(info->depth_attachment.value.image_view).info.image) == 0)
         {
             return DAXA_RESULT_INVALID_IMAGE_ID;
         }
@@ -847,7 +918,7 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
         {
             return DAXA_RESULT_INVALID_IMAGE_VIEW_ID;
         }
-        if (daxa_dvc_is_image_valid(self->device, self->device->slot(info->stencil_attachment.value.image_view).info.image) == 0)
+        if (daxa_dvc_is_image_valid(self->device, self->device->cold_slot(info->stencil_attachment.value.image_view).info.image) == 0)
         {
             return DAXA_RESULT_INVALID_IMAGE_ID;
         }
@@ -855,18 +926,15 @@ auto daxa_cmd_begin_renderpass(daxa_CommandRecorder self, daxa_RenderPassBeginIn
     };
     for (usize i = 0; i < info->color_attachments.size; ++i)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(info->color_attachments.data[i].image_view));
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(self->device->slot(info->color_attachments.data[i].image_view).info.image));
+        remember_ids(self, info->color_attachments.data[i].image_view, self->device->cold_slot(info->color_attachments.data[i].image_view).info.image);
     }
     if (info->depth_attachment.has_value != 0)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(info->depth_attachment.value.image_view));
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(self->device->slot(info->depth_attachment.value.image_view).info.image));
+        remember_ids(self, info->depth_attachment.value.image_view, self->device->cold_slot(info->depth_attachment.value.image_view).info.image);
     }
     if (info->stencil_attachment.has_value != 0)
     {
-        self->current_command_data.used_image_views.push_back(std::bit_cast<ImageViewId>(info->stencil_attachment.value.image_view));
-        self->current_command_data.used_images.push_back(std::bit_cast<ImageId>(self->device->slot(info->stencil_attachment.value.image_view).info.image));
+        remember_ids(self, info->stencil_attachment.value.image_view, self->device->cold_slot(info->stencil_attachment.value.image_view).info.image);
     }
 
     VkRenderingInfo const vk_rendering_info{
@@ -1087,24 +1155,24 @@ void daxa_cmd_end_label(daxa_CommandRecorder self)
 
 void daxa_cmd_flush_barriers(daxa_CommandRecorder self)
 {
-    if (self->memory_barrier_batch_count > 0 || self->image_barrier_batch_count > 0)
+    if (!self->memory_barrier_batch.empty() || !self->image_barrier_batch.empty())
     {
         VkDependencyInfo const vk_dependency_info{
             .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
             .pNext = nullptr,
             .dependencyFlags = {},
-            .memoryBarrierCount = static_cast<u32>(self->memory_barrier_batch_count),
+            .memoryBarrierCount = static_cast<u32>(self->memory_barrier_batch.size()),
             .pMemoryBarriers = self->memory_barrier_batch.data(),
             .bufferMemoryBarrierCount = 0,
             .pBufferMemoryBarriers = nullptr,
-            .imageMemoryBarrierCount = static_cast<u32>(self->image_barrier_batch_count),
+            .imageMemoryBarrierCount = static_cast<u32>(self->image_barrier_batch.size()),
             .pImageMemoryBarriers = self->image_barrier_batch.data(),
         };
 
         vkCmdPipelineBarrier2(self->current_command_data.vk_cmd_buffer, &vk_dependency_info);
 
-        self->memory_barrier_batch_count = 0;
-        self->image_barrier_batch_count = 0;
+        self->memory_barrier_batch.clear();
+        self->image_barrier_batch.clear();
     }
 }
 
@@ -1235,6 +1303,7 @@ void executable_cmd_list_execute_deferred_destructions(daxa_Device device, Execu
 
 auto daxa_ImplCommandRecorder::generate_new_current_command_data() -> daxa_Result
 {
+    this->current_command_data = this->device->command_list_data_pool.get();
     VkCommandBufferAllocateInfo const vk_command_buffer_allocate_info{
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
         .pNext = nullptr,
@@ -1250,7 +1319,7 @@ auto daxa_ImplCommandRecorder::generate_new_current_command_data() -> daxa_Resul
     VkCommandBufferBeginInfo const vk_command_buffer_begin_info{
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
         .pNext = nullptr,
-        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+        .flags = this->info.reusable != 0 ? VkCommandBufferUsageFlags{VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT} : VkCommandBufferUsageFlags{VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT},
         .pInheritanceInfo = {},
     };
     vk_result = vkBeginCommandBuffer(this->current_command_data.vk_cmd_buffer, &vk_command_buffer_begin_info);
@@ -1259,6 +1328,12 @@ auto daxa_ImplCommandRecorder::generate_new_current_command_data() -> daxa_Resul
         return std::bit_cast<daxa_Result>(vk_result);
     }
     this->allocated_command_buffers.push_back(this->current_command_data.vk_cmd_buffer);
+    this->remembered_buffers.clear();
+    this->remembered_images.clear();
+    this->remembered_image_views.clear();
+    this->remembered_samplers.clear();
+    this->remembered_tlass.clear();
+    this->remembered_blass.clear();
     this->current_command_data.used_buffers.reserve(12);
     this->current_command_data.used_images.reserve(12);
     this->current_command_data.used_image_views.reserve(12);
@@ -1266,18 +1341,58 @@ auto daxa_ImplCommandRecorder::generate_new_current_command_data() -> daxa_Resul
     return DAXA_RESULT_SUCCESS;
 }
 
+auto ImplRememberedIdSet::insert(u64 id) -> bool
+{
+    // Keep the load factor below 3/4.
+    if ((this->count + 1) * 4 > this->slots.size() * 3)
+    {
+        auto old_slots = std::move(this->slots);
+        this->slots.assign(std::max<usize>(16, old_slots.size() * 2), EMPTY);
+        this->count = 0;
+        for (u64 const old_id : old_slots)
+        {
+            if (old_id != EMPTY)
+            {
+                this->insert(old_id);
+            }
+        }
+    }
+    usize const mask = this->slots.size() - 1;
+    usize slot = static_cast<usize>((id * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+    while (this->slots[slot] != EMPTY)
+    {
+        if (this->slots[slot] == id)
+        {
+            return false;
+        }
+        slot = (slot + 1) & mask;
+    }
+    this->slots[slot] = id;
+    ++this->count;
+    return true;
+}
+
+void ImplRememberedIdSet::clear()
+{
+    if (this->count != 0)
+    {
+        std::fill(this->slots.begin(), this->slots.end(), EMPTY);
+        this->count = 0;
+    }
+}
+
 void daxa_ImplCommandRecorder::zero_ref_callback(ImplHandle const * handle)
 {
     auto * self = rc_cast<daxa_CommandRecorder>(handle);
     u64 const submit_timeline = self->device->global_submit_timeline.load(std::memory_order::relaxed);
-    std::unique_lock const lock{self->device->zombies_mtx};
     executable_cmd_list_execute_deferred_destructions(self->device, self->current_command_data);
-    self->device->command_list_zombies.emplace_front(
+    self->device->command_list_zombies.push(
         submit_timeline,
         CommandRecorderZombie{
             .vk_cmd_pool = self->vk_cmd_pool,
             .allocated_command_buffers = std::move(self->allocated_command_buffers),
         });
+    self->device->command_list_data_pool.put_back(std::move(self->current_command_data));
     self->device->dec_weak_refcnt(
         &daxa_ImplDevice::zero_ref_callback,
         self->device->instance);
@@ -1288,6 +1403,7 @@ void daxa_ImplExecutableCommandList::zero_ref_callback(ImplHandle const * handle
 {
     auto * self = rc_cast<daxa_ExecutableCommandList>(handle);
     executable_cmd_list_execute_deferred_destructions(self->cmd_recorder->device, self->data);
+    self->cmd_recorder->device->command_list_data_pool.put_back(std::move(self->data));
     self->cmd_recorder->dec_refcnt(
         daxa_ImplCommandRecorder::zero_ref_callback,
         self->cmd_recorder->device->instance);
@@ -19,7 +19,6 @@ static inline constexpr u8 DEFERRED_DESTRUCTION_TIMELINE_QUERY_POOL_INDEX = 4;
 // TODO: maybe reintroduce this in some fashion?
 // static inline constexpr usize DEFERRED_DESTRUCTION_COUNT_MAX = 32;
 
-static inline constexpr usize COMMAND_LIST_BARRIER_MAX_BATCH_SIZE = 16;
 static inline constexpr usize COMMAND_LIST_COLOR_ATTACHMENT_MAX = 16;
 
 struct CommandPoolPool
@@ -46,9 +45,9 @@ struct ExecutableCommandListData
 {
     VkCommandBuffer vk_cmd_buffer = {};
     std::vector<std::pair<GPUResourceId, u8>> deferred_destructions = {};
-    // TODO:    These vectors seem to be fast enough. overhead is around 1-4% in cmd recording.
-    //          It might be cool to have some slab allocator for these.
-    // If there is demand, we could make an instance or cmd list flag to disable the submit checks.
+    // These vectors are recycled through the devices CommandListDataPool, keeping their capacity.
+    // Each id is only stored once, so submit validation scales with the number of unique resources.
+    // Left empty when the recorder was created with disable_submit_validation.
     // TODO:    Also collect ref counted handles.
     std::vector<BufferId> used_buffers = {};
     std::vector<ImageId> used_images = {};
@@ -58,6 +57,33 @@ struct ExecutableCommandListData
     std::vector<BlasId> used_blass = {};
 };
 
+// Recycles the bookkeeping of executable command lists once they reach zero references.
+// Recycled data keeps the capacity of its vectors, so steady state recording does not allocate.
+struct CommandListDataPool
+{
+    static inline constexpr usize MAX_POOLED_DATA = 256;
+
+    auto get() -> ExecutableCommandListData;
+    void put_back(ExecutableCommandListData && data);
+
+    std::vector<ExecutableCommandListData> pooled = {};
+    daxa_CommandListDataStatistics statistics = {};
+    std::mutex mtx = {};
+};
+
+// Open addressing set of gpu resource ids, deduplicates the used id lists of the current command data.
+struct ImplRememberedIdSet
+{
+    static inline constexpr u64 EMPTY = ~u64{0};
+
+    std::vector<u64> slots = {};
+    usize count = {};
+
+    // Returns true when the id was not in the set yet.
+    auto insert(u64 id) -> bool;
+    void clear();
+};
+
 struct daxa_ImplCommandRecorder final : ImplHandle
 {
     daxa_Device device = {};
@@ -65,15 +91,21 @@ struct daxa_ImplCommandRecorder final : ImplHandle
     daxa_CommandRecorderInfo info = {};
     VkCommandPool vk_cmd_pool = {};
     std::vector<VkCommandBuffer> allocated_command_buffers = {};
-    std::array<VkMemoryBarrier2, COMMAND_LIST_BARRIER_MAX_BATCH_SIZE> memory_barrier_batch = {};
-    std::array<VkImageMemoryBarrier2, COMMAND_LIST_BARRIER_MAX_BATCH_SIZE> image_barrier_batch = {};
-    usize image_barrier_batch_count = {};
-    usize memory_barrier_batch_count = {};
+    // Pipeline barriers are collected until the next non barrier command, which records all of them in a single vkCmdPipelineBarrier2 call.
+    // The vectors keep their capacity between flushes.
+    std::vector<VkMemoryBarrier2> memory_barrier_batch = {};
+    std::vector<VkImageMemoryBarrier2> image_barrier_batch = {};
     usize split_barrier_batch_count = {};
     struct NoPipeline {};
     Variant<NoPipeline, daxa_ComputePipeline, daxa_RasterPipeline, daxa_RayTracingPipeline> current_pipeline = NoPipeline{};
 
     ExecutableCommandListData current_command_data = {};
+    ImplRememberedIdSet remembered_buffers = {};
+    ImplRememberedIdSet remembered_images = {};
+    ImplRememberedIdSet remembered_image_views = {};
+    ImplRememberedIdSet remembered_samplers = {};
+    ImplRememberedIdSet remembered_tlass = {};
+    ImplRememberedIdSet remembered_blass = {};
 
     auto generate_new_current_command_data() -> daxa_Result;
     
@@ -2,6 +2,11 @@
 
 #include <utility>
 #include <functional>
+#include <numeric>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
 #include "impl_features.hpp"
 
 #include "impl_device.hpp"
@@ -68,6 +73,241 @@ namespace
         }
         return result;
     }
+
+    inline auto buffer_host_accessible(daxa_BufferInfo const & info) -> bool
+    {
+        auto const vma_allocation_flags = static_cast<VmaAllocationCreateFlags>(info.allocate_info);
+        return ((vma_allocation_flags & VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT) != 0u) ||
+               ((vma_allocation_flags & VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT) != 0u) ||
+               ((vma_allocation_flags & VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT) != 0u);
+    }
+
+    inline auto buffer_vma_allocation_flags(daxa_BufferInfo const & info) -> VmaAllocationCreateFlags
+    {
+        auto vma_allocation_flags = static_cast<VmaAllocationCreateFlags>(info.allocate_info);
+        if (buffer_host_accessible(info))
+        {
+            vma_allocation_flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        }
+        return vma_allocation_flags;
+    }
+
+    struct BulkAllocationRequest
+    {
+        VkMemoryRequirements requirements = {};
+        u32 memory_type_index = {};
+        VmaAllocationCreateFlags flags = {};
+    };
+
+    // Requests with identical requirements, memory type and flags share a single vmaAllocateMemoryPages call.
+    // On failure all allocations made so far are freed again and out_allocations is left filled with nullptr.
+    auto allocate_memory_pages(daxa_Device self, std::span<BulkAllocationRequest const> requests, std::span<VmaAllocation> out_allocations) -> daxa_Result
+    {
+        daxa_Result result = DAXA_RESULT_SUCCESS;
+        std::fill(out_allocations.begin(), out_allocations.end(), VmaAllocation{});
+        defer
+        {
+            if (result != DAXA_RESULT_SUCCESS)
+            {
+                for (auto & allocation : out_allocations)
+                {
+                    if (allocation != nullptr)
+                    {
+                        vmaFreeMemory(self->vma_allocator, allocation);
+                        allocation = nullptr;
+                    }
+                }
+            }
+        };
+
+        auto const key = [&](u32 i)
+        {
+            auto const & request = requests[i];
+            return std::tuple{request.memory_type_index, request.flags, request.requirements.size, request.requirements.alignment};
+        };
+        std::vector<u32> order(requests.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(), [&](u32 a, u32 b)
+                  { return key(a) < key(b); });
+
+        std::vector<VmaAllocation> group_allocations = {};
+        usize group_begin = 0;
+        while (group_begin < order.size())
+        {
+            usize group_end = group_begin + 1;
+            while (group_end < order.size() && key(order[group_end]) == key(order[group_begin]))
+            {
+                ++group_end;
+            }
+            auto const & request = requests[order[group_begin]];
+            VmaAllocationCreateInfo const vma_allocation_create_info{
+                .flags = request.flags,
+                .usage = VMA_MEMORY_USAGE_UNKNOWN,
+                .requiredFlags = {},
+                .preferredFlags = {},
+                .memoryTypeBits = 1u << request.memory_type_index,
+                .pool = nullptr,
+                .pUserData = nullptr,
+                .priority = 0.5f,
+            };
+            group_allocations.resize(group_end - group_begin);
+            result = static_cast<daxa_Result>(vmaAllocateMemoryPages(
+                self->vma_allocator,
+                &request.requirements,
+                &vma_allocation_create_info,
+                group_allocations.size(),
+                group_allocations.data(),
+                nullptr));
+            _DAXA_RETURN_IF_ERROR(result, result)
+            for (usize i = group_begin; i < group_end; ++i)
+            {
+                out_allocations[order[i]] = group_allocations[i - group_begin];
+            }
+            group_begin = group_end;
+        }
+        return result;
+    }
+
+    // Prepended to the vulkan pipeline cache data on disk.
+    // The vulkan cache header does not contain the driver version, so it is checked here as well.
+    // Updated drivers start with a fresh cache instead of handing stale data to the driver.
+    struct PipelineCacheFileHeader
+    {
+        u32 magic = {};
+        u32 version = {};
+        u32 vendor_id = {};
+        u32 device_id = {};
+        u32 driver_version = {};
+        u32 reserved = {};
+        std::array<char, VK_UUID_SIZE> pipeline_cache_uuid = {};
+        u64 data_size = {};
+    };
+    constexpr u32 PIPELINE_CACHE_FILE_MAGIC = 0x43505844; // "DXPC"
+    constexpr u32 PIPELINE_CACHE_FILE_VERSION = 1;
+
+    auto make_pipeline_cache_file_header(daxa_DeviceProperties const & properties, u64 data_size) -> PipelineCacheFileHeader
+    {
+        PipelineCacheFileHeader header = {
+            .magic = PIPELINE_CACHE_FILE_MAGIC,
+            .version = PIPELINE_CACHE_FILE_VERSION,
+            .vendor_id = properties.vendor_id,
+            .device_id = properties.device_id,
+            .driver_version = properties.driver_version,
+            .data_size = data_size,
+        };
+        std::memcpy(header.pipeline_cache_uuid.data(), properties.pipeline_cache_uuid, VK_UUID_SIZE);
+        return header;
+    }
+
+    // Returns the cache data when the file exists and was written for this exact device and driver, otherwise nothing.
+    auto load_pipeline_cache_data(std::string const & path, daxa_DeviceProperties const & properties) -> std::vector<char>
+    {
+        auto file = std::ifstream{path, std::ios::binary};
+        PipelineCacheFileHeader header = {};
+        if (!file || !file.read(r_cast<char *>(&header), sizeof(PipelineCacheFileHeader)))
+        {
+            return {};
+        }
+        auto const expected = make_pipeline_cache_file_header(properties, header.data_size);
+        bool const matches =
+            header.magic == expected.magic &&
+            header.version == expected.version &&
+            header.vendor_id == expected.vendor_id &&
+            header.device_id == expected.device_id &&
+            header.driver_version == expected.driver_version &&
+            header.pipeline_cache_uuid == expected.pipeline_cache_uuid;
+        if (!matches)
+        {
+            return {};
+        }
+        // A truncated or corrupted file must not make device creation allocate whatever size its header claims.
+        std::streampos const data_start = file.tellg();
+        file.seekg(0, std::ios::end);
+        std::streampos const file_end = file.tellg();
+        if (data_start < 0 || file_end < data_start || static_cast<u64>(file_end - data_start) != header.data_size)
+        {
+            return {};
+        }
+        file.seekg(data_start);
+        std::vector<char> data(header.data_size);
+        if (!file.read(data.data(), static_cast<std::streamsize>(data.size())))
+        {
+            return {};
+        }
+        return data;
+    }
+
+    // Submits with up to this many command lists, signals and waits do not allocate.
+    constexpr usize SUBMIT_INLINE_CAPACITY = 16;
+
+    // Array of a size only known at runtime. Lives on the stack up to N elements, larger sizes fall back to the heap.
+    template <typename T, usize N>
+    struct InlineStorage
+    {
+        std::array<T, N> inline_storage = {};
+        std::vector<T> heap_storage = {};
+        T * data = {};
+
+        explicit InlineStorage(u64 size)
+        {
+            if (size <= N)
+            {
+                data = inline_storage.data();
+            }
+            else
+            {
+                heap_storage.resize(size);
+                data = heap_storage.data();
+            }
+        }
+        InlineStorage(InlineStorage const &) = delete;
+        auto operator=(InlineStorage const &) -> InlineStorage & = delete;
+    };
+
+    auto validate_command_submit_info(daxa_Device self, daxa_CommandSubmitInfo const & info) -> daxa_Result
+    {
+        if (static_cast<u32>(info.queue.index) >= self->queue_families[info.queue.family].queue_count)
+        {
+            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_INVALID_QUEUE, DAXA_RESULT_ERROR_INVALID_QUEUE);
+        }
+
+        for (daxa_ExecutableCommandList commands : std::span{info.command_lists, info.command_list_count})
+        {
+            if (commands->cmd_recorder->info.queue_family != info.queue.family)
+            {
+                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH, DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH);
+            }
+            for (BufferId id : commands->data.used_buffers)
+            {
+                if (!daxa_dvc_is_buffer_valid(self, id))
+                {
+                    _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_BUFFER_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_BUFFER_ID);
+                }
+            }
+            for (ImageId id : commands->data.used_images)
+            {
+                if (!daxa_dvc_is_image_valid(self, id))
+                {
+                    _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_ID);
+                }
+            }
+            for (ImageViewId id : commands->data.used_image_views)
+            {
+                if (!daxa_dvc_is_image_view_valid(self, id))
+                {
+                    _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_VIEW_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_VIEW_ID);
+                }
+            }
+            for (SamplerId id : commands->data.used_samplers)
+            {
+                if (!daxa_dvc_is_sampler_valid(self, id))
+                {
+                    _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_SAMPLER_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_SAMPLER_ID);
+                }
+            }
+        }
+        return DAXA_RESULT_SUCCESS;
+    }
 } // namespace
 
 auto daxa_ImplDevice::ImplQueue::initialize(VkDevice vk_device, u32 queue_family_index, u32 queue_index) -> daxa_Result
@@ -127,7 +367,16 @@ auto daxa_ImplDevice::ImplQueue::get_oldest_pending_submit(VkDevice vk_device, s
     return DAXA_RESULT_SUCCESS;
 }
 
-auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_BufferId * out_id, daxa_MemoryBlock opt_memory_block, usize opt_offset) -> daxa_Result
+// opt_allocation:        Memory allocated up front by bulk creation. The buffer takes ownership on success.
+// opt_descriptor_writes: When set, the descriptor write is appended instead of being queued on the table.
+auto create_buffer_helper(
+    daxa_Device self,
+    daxa_BufferInfo const * info,
+    daxa_BufferId * out_id,
+    daxa_MemoryBlock opt_memory_block,
+    usize opt_offset,
+    VmaAllocation opt_allocation = nullptr,
+    std::vector<ImplDescriptorWrite> * opt_descriptor_writes = nullptr) -> daxa_Result
 {
     daxa_Result result = DAXA_RESULT_SUCCESS;
     // --- Begin Parameter Validation ---
@@ -150,7 +399,7 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
     }
     _DAXA_RETURN_IF_ERROR(result, result)
 
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
 
     defer
     {
@@ -164,13 +413,13 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
         }
     };
 
-    ret.info = *info;
+    ret_cold.info = *info;
 
     VkBufferCreateInfo const vk_buffer_create_info{
         .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         .pNext = nullptr,
         .flags = {},
-        .size = static_cast<VkDeviceSize>(ret.info.size),
+        .size = static_cast<VkDeviceSize>(ret_cold.info.size),
         .usage = create_buffer_use_flags(self),
         .sharingMode = VK_SHARING_MODE_CONCURRENT,                  // Buffers are always shared.
         .queueFamilyIndexCount = self->valid_vk_queue_family_count, // Buffers are always shared across all queues.
@@ -179,19 +428,26 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
 
     bool host_accessible = false;
     VmaAllocationInfo vma_allocation_info = {};
-    if (opt_memory_block == nullptr)
+    if (opt_allocation != nullptr)
     {
-        auto vma_allocation_flags = static_cast<VmaAllocationCreateFlags>(info->allocate_info);
-        if (((vma_allocation_flags & VMA_ALLOCATION_CREATE_HOST_ACCESS_ALLOW_TRANSFER_INSTEAD_BIT) != 0u) ||
-            ((vma_allocation_flags & VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT) != 0u) ||
-            ((vma_allocation_flags & VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT) != 0u))
-        {
-            vma_allocation_flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
-            host_accessible = true;
-        }
+        host_accessible = buffer_host_accessible(*info);
+
+        result = static_cast<daxa_Result>(vkCreateBuffer(self->vk_device, &vk_buffer_create_info, nullptr, &ret.vk_buffer));
+        _DAXA_RETURN_IF_ERROR(result, result)
+
+        result = static_cast<daxa_Result>(vmaBindBufferMemory(self->vma_allocator, opt_allocation, ret.vk_buffer));
+        _DAXA_RETURN_IF_ERROR(result, result)
+
+        // Nothing after this can fail. The caller frees the allocation on error.
+        ret_cold.vma_allocation = opt_allocation;
+        vmaGetAllocationInfo(self->vma_allocator, opt_allocation, &vma_allocation_info);
+    }
+    else if (opt_memory_block == nullptr)
+    {
+        host_accessible = buffer_host_accessible(*info);
 
         VmaAllocationCreateInfo const vma_allocation_create_info{
-            .flags = vma_allocation_flags,
+            .flags = buffer_vma_allocation_flags(*info),
             .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
             .requiredFlags = {},
             .preferredFlags = {},
@@ -206,14 +462,14 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
             &vk_buffer_create_info,
             &vma_allocation_create_info,
             &ret.vk_buffer,
-            &ret.vma_allocation,
+            &ret_cold.vma_allocation,
             &vma_allocation_info));
         _DAXA_RETURN_IF_ERROR(result, result)
     }
     else
     {
         auto const & mem_block = *opt_memory_block;
-        ret.opt_memory_block = opt_memory_block;
+        ret_cold.opt_memory_block = opt_memory_block;
         opt_memory_block->inc_weak_refcnt();
 
         result = static_cast<daxa_Result>(vkCreateBuffer(self->vk_device, &vk_buffer_create_info, nullptr, &ret.vk_buffer));
@@ -255,21 +511,30 @@ auto create_buffer_helper(daxa_Device self, daxa_BufferInfo const * info, daxa_B
     }
 
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
+        // Queued, flushed before the next submit.
         write_descriptor_set_buffer(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set, ret.vk_buffer,
+            self->gpu_sro_table,
+            ret.vk_buffer,
             0,
-            static_cast<VkDeviceSize>(ret.info.size),
-            id.index);
+            static_cast<VkDeviceSize>(ret_cold.info.size),
+            id.index,
+            opt_descriptor_writes);
     }
 
     *out_id = std::bit_cast<daxa_BufferId>(id);
     return result;
 }
 
-auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_ImageId * out_id, daxa_MemoryBlock opt_memory_block, usize opt_offset) -> daxa_Result
+// opt_allocation:        Memory allocated up front by bulk creation. The image takes ownership on success.
+// opt_descriptor_writes: When set, the descriptor writes are appended instead of being queued on the table.
+auto create_image_helper(
+    daxa_Device self,
+    daxa_ImageInfo const * info,
+    daxa_ImageId * out_id,
+    daxa_MemoryBlock opt_memory_block,
+    usize opt_offset,
+    VmaAllocation opt_allocation = nullptr,
+    std::vector<ImplDescriptorWrite> * opt_descriptor_writes = nullptr) -> daxa_Result
 {
     daxa_Result result = DAXA_RESULT_SUCCESS;
     /// --- Begin Validation ---
@@ -288,14 +553,14 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
     }
     _DAXA_RETURN_IF_ERROR(result, result)
 
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
         {
             if (ret.vk_image)
             {
-                vmaDestroyImage(self->vma_allocator, ret.vk_image, ret.vma_allocation);
+                vmaDestroyImage(self->vma_allocator, ret.vk_image, ret_cold.vma_allocation);
             }
             if (ret.view_slot.vk_image_view)
             {
@@ -304,10 +569,10 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
         }
     };
 
-    ret.info = *info;
-    ret.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
+    ret_cold.info = *info;
+    ret_cold.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
         .type = static_cast<ImageViewType>(info->dimensions - 1),
-        .format = std::bit_cast<Format>(ret.info.format),
+        .format = std::bit_cast<Format>(ret_cold.info.format),
         .image = {id},
         .slice = ImageMipArraySlice{
             .base_mip_level = 0,
@@ -351,7 +616,22 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
         },
     };
     VkImageCreateInfo const vk_image_create_info = initialize_image_create_info_from_image_info(self, *info);
-    if (opt_memory_block == nullptr)
+    if (opt_allocation != nullptr)
+    {
+        result = static_cast<daxa_Result>(vkCreateImage(self->vk_device, &vk_image_create_info, nullptr, &ret.vk_image));
+        _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_CREATE_IMAGE);
+
+        result = static_cast<daxa_Result>(vmaBindImageMemory(self->vma_allocator, opt_allocation, ret.vk_image));
+        _DAXA_RETURN_IF_ERROR(result, result);
+
+        vk_image_view_create_info.image = ret.vk_image;
+        result = static_cast<daxa_Result>(vkCreateImageView(self->vk_device, &vk_image_view_create_info, nullptr, &ret.view_slot.vk_image_view));
+        _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_CREATE_DEFAULT_IMAGE_VIEW);
+
+        // Only take ownership once nothing can fail anymore, the caller frees the allocation on error.
+        ret_cold.vma_allocation = opt_allocation;
+    }
+    else if (opt_memory_block == nullptr)
     {
         VmaAllocationCreateInfo const vma_allocation_create_info{
             .flags = static_cast<VmaAllocationCreateFlags>(info->allocate_info),
@@ -364,7 +644,7 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
             .priority = 0.5f,
         };
 
-        result = static_cast<daxa_Result>(vmaCreateImage(self->vma_allocator, &vk_image_create_info, &vma_allocation_create_info, &ret.vk_image, &ret.vma_allocation, nullptr));
+        result = static_cast<daxa_Result>(vmaCreateImage(self->vma_allocator, &vk_image_create_info, &vma_allocation_create_info, &ret.vk_image, &ret_cold.vma_allocation, nullptr));
         _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_CREATE_IMAGE);
 
         vk_image_view_create_info.image = ret.vk_image;
@@ -374,7 +654,7 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
     else
     {
         daxa_ImplMemoryBlock const & mem_block = *opt_memory_block;
-        ret.opt_memory_block = opt_memory_block;
+        ret_cold.opt_memory_block = opt_memory_block;
         opt_memory_block->inc_weak_refcnt();
         // TODO(pahrens): Add validation for memory requirements.
         result = static_cast<daxa_Result>(vkCreateImage(self->vk_device, &vk_image_create_info, nullptr, &ret.vk_image));
@@ -416,14 +696,13 @@ auto create_image_helper(daxa_Device self, daxa_ImageInfo const * info, daxa_Ima
     }
 
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
+        // Queued, flushed before the next submit.
         write_descriptor_set_image(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set,
+            self->gpu_sro_table,
             ret.view_slot.vk_image_view,
-            std::bit_cast<ImageUsageFlags>(ret.info.usage),
-            id.index);
+            std::bit_cast<ImageUsageFlags>(ret_cold.info.usage),
+            id.index,
+            opt_descriptor_writes);
     }
     *out_id = std::bit_cast<daxa_ImageId>(id);
     return result;
@@ -456,56 +735,56 @@ auto create_acceleration_structure_helper(
     }
     _DAXA_RETURN_IF_ERROR(result, result);
 
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
         {
             table.unsafe_destroy_zombie_slot(id);
-            if (!ret.buffer_id.is_empty())
+            if (!ret_cold.buffer_id.is_empty())
             {
-                [[maybe_unused]] auto const _ignore = daxa_dvc_destroy_buffer(self, ret.buffer_id);
+                [[maybe_unused]] auto const _ignore = daxa_dvc_destroy_buffer(self, ret_cold.buffer_id);
             }
         }
     };
 
-    ret.info = info;
+    ret_cold.info = info;
 
     if (buffer)
     {
-        ret.buffer_id = std::bit_cast<daxa::BufferId>(*buffer);
-        ret.offset = *offset;
-        ret.owns_buffer = false;
+        ret_cold.buffer_id = std::bit_cast<daxa::BufferId>(*buffer);
+        ret_cold.offset = *offset;
+        ret_cold.owns_buffer = false;
     }
     else
     {
-        daxa::SmallString buffer_name{std::string_view{ret.info.name.data, ret.info.name.size}};
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        daxa::SmallString buffer_name{std::string_view{ret_cold.info.name.data, ret_cold.info.name.size}};
+        if (ret_cold.info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back(' ');
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        if (ret_cold.info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back('b');
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        if (ret_cold.info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back('u');
-        if (ret.info.name.size < DAXA_SMALL_STRING_CAPACITY)
+        if (ret_cold.info.name.size < DAXA_SMALL_STRING_CAPACITY)
             buffer_name.push_back('f');
         auto cinfo = daxa_BufferInfo{
-            .size = ret.info.size,
+            .size = ret_cold.info.size,
             .name = std::bit_cast<daxa_SmallString>(buffer_name),
         };
-        result = daxa_dvc_create_buffer(self, &cinfo, r_cast<daxa_BufferId *>(&ret.buffer_id));
+        result = daxa_dvc_create_buffer(self, &cinfo, r_cast<daxa_BufferId *>(&ret_cold.buffer_id));
         _DAXA_RETURN_IF_ERROR(result, result);
-        ret.offset = 0;
-        ret.owns_buffer = true;
+        ret_cold.offset = 0;
+        ret_cold.owns_buffer = true;
     }
-    ret.vk_buffer = self->slot(ret.buffer_id).vk_buffer;
+    ret_cold.vk_buffer = self->slot(ret_cold.buffer_id).vk_buffer;
 
     VkAccelerationStructureCreateInfoKHR vk_create_info = {
         .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR,
         .pNext = nullptr,
         .createFlags = {}, // VK_ACCELERATION_STRUCTURE_CREATE_DEVICE_ADDRESS_CAPTURE_REPLAY_BIT_KHR,
-        .buffer = self->slot(ret.buffer_id).vk_buffer,
-        .offset = ret.offset,
-        .size = ret.info.size,
+        .buffer = ret_cold.vk_buffer,
+        .offset = ret_cold.offset,
+        .size = ret_cold.info.size,
         .type = vk_as_type,
         .deviceAddress = {},
     };
@@ -521,9 +800,9 @@ auto create_acceleration_structure_helper(
         self->vk_device,
         &vk_acceleration_structure_device_address_info_khr);
 
-    if ((self->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && ret.info.name.size != 0)
+    if ((self->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && ret_cold.info.name.size != 0)
     {
-        auto c_str_arr = r_cast<SmallString const *>(&ret.info.name)->c_str();
+        auto c_str_arr = r_cast<SmallString const *>(&ret_cold.info.name)->c_str();
         VkDebugUtilsObjectNameInfoEXT const swapchain_image_name_info{
             .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
             .pNext = nullptr,
@@ -536,11 +815,9 @@ auto create_acceleration_structure_helper(
 
     if (vk_as_type == VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR)
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
+        // Queued, flushed before the next submit.
         write_descriptor_set_acceleration_structure(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set,
+            self->gpu_sro_table,
             ret.vk_acceleration_structure,
             id.index);
     }
@@ -715,6 +992,208 @@ auto daxa_dvc_create_image_from_block(daxa_Device self, daxa_MemoryBlockImageInf
     return create_image_helper(self, &info->image_info, out_id, *info->memory_block, info->offset);
 }
 
+auto daxa_dvc_create_buffers(daxa_Device self, daxa_BufferInfo const * infos, u64 count, daxa_BufferId * out_ids) -> daxa_Result
+{
+    daxa_Result result = DAXA_RESULT_SUCCESS;
+    // --- Begin Parameter Validation ---
+
+    for (daxa_BufferInfo const & info : std::span{infos, count})
+    {
+        if (info.size == 0)
+        {
+            result = DAXA_RESULT_INVALID_BUFFER_INFO;
+        }
+    }
+    _DAXA_RETURN_IF_ERROR(result, result)
+
+    // --- End Parameter Validation ---
+
+    // All buffers are created with the same usage flags, so their memory type only depends on the allocation flags.
+    std::vector<std::pair<VmaAllocationCreateFlags, u32>> memory_type_cache = {};
+    std::vector<BulkAllocationRequest> requests(count);
+    for (u64 i = 0; i < count; ++i)
+    {
+        auto & request = requests[i];
+        request.flags = buffer_vma_allocation_flags(infos[i]);
+        request.requirements = daxa_dvc_buffer_memory_requirements(self, &infos[i]);
+        auto memory_type = std::find_if(
+            memory_type_cache.begin(), memory_type_cache.end(),
+            [&](auto const & cached)
+            { return cached.first == request.flags; });
+        if (memory_type == memory_type_cache.end())
+        {
+            VkBufferCreateInfo const vk_buffer_create_info{
+                .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = {},
+                .size = static_cast<VkDeviceSize>(infos[i].size),
+                .usage = create_buffer_use_flags(self),
+                .sharingMode = VK_SHARING_MODE_CONCURRENT,
+                .queueFamilyIndexCount = self->valid_vk_queue_family_count,
+                .pQueueFamilyIndices = self->valid_vk_queue_families.data(),
+            };
+            VmaAllocationCreateInfo const vma_allocation_create_info{
+                .flags = request.flags,
+                .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+                .requiredFlags = {},
+                .preferredFlags = {},
+                .memoryTypeBits = std::numeric_limits<u32>::max(),
+                .pool = nullptr,
+                .pUserData = nullptr,
+                .priority = 0.5f,
+            };
+            u32 memory_type_index = {};
+            result = static_cast<daxa_Result>(vmaFindMemoryTypeIndexForBufferInfo(self->vma_allocator, &vk_buffer_create_info, &vma_allocation_create_info, &memory_type_index));
+            _DAXA_RETURN_IF_ERROR(result, result)
+            memory_type = memory_type_cache.insert(memory_type_cache.end(), std::pair{request.flags, memory_type_index});
+        }
+        request.memory_type_index = memory_type->second;
+    }
+
+    std::vector<VmaAllocation> allocations(count);
+    result = allocate_memory_pages(self, requests, allocations);
+    _DAXA_RETURN_IF_ERROR(result, result)
+
+    std::vector<ImplDescriptorWrite> descriptor_writes = {};
+    descriptor_writes.reserve(count);
+    u64 created_count = 0;
+    defer
+    {
+        if (result != DAXA_RESULT_SUCCESS)
+        {
+            for (u64 i = 0; i < created_count; ++i)
+            {
+                [[maybe_unused]] auto const _ignore = daxa_dvc_destroy_buffer(self, out_ids[i]);
+            }
+            for (u64 i = created_count; i < count; ++i)
+            {
+                vmaFreeMemory(self->vma_allocator, allocations[i]);
+            }
+        }
+    };
+    for (; created_count < count; ++created_count)
+    {
+        result = create_buffer_helper(self, &infos[created_count], &out_ids[created_count], nullptr, 0, allocations[created_count], &descriptor_writes);
+        _DAXA_RETURN_IF_ERROR(result, result)
+    }
+    self->gpu_sro_table.queue_descriptor_writes(descriptor_writes);
+    return result;
+}
+
+auto daxa_dvc_create_images(daxa_Device self, daxa_ImageInfo const * infos, u64 count, daxa_ImageId * out_ids) -> daxa_Result
+{
+    daxa_Result result = DAXA_RESULT_SUCCESS;
+    /// --- Begin Validation ---
+
+    for (daxa_ImageInfo const & info : std::span{infos, count})
+    {
+        if (!(info.dimensions >= 1 && info.dimensions <= 3))
+        {
+            result = DAXA_RESULT_INVALID_IMAGE_INFO;
+        }
+    }
+    _DAXA_RETURN_IF_ERROR(result, result)
+
+    /// --- End Validation ---
+
+    // Attachments are still allocated by vmaCreateImage, so that they can get dedicated allocations.
+    // The memory type of all other images depends on their format, usage and create flags and the allocation flags.
+    auto const allocates_dedicated = [](daxa_ImageInfo const & info)
+    {
+        return (info.usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)) != 0;
+    };
+    struct MemoryTypeCacheEntry
+    {
+        daxa_ImageFlags flags = {};
+        VkFormat format = {};
+        daxa_ImageUsageFlags usage = {};
+        VmaAllocationCreateFlags allocation_flags = {};
+        u32 memory_type_index = {};
+    };
+    std::vector<MemoryTypeCacheEntry> memory_type_cache = {};
+    std::vector<BulkAllocationRequest> requests = {};
+    std::vector<u64> request_image_indices = {};
+    for (u64 i = 0; i < count; ++i)
+    {
+        auto const & info = infos[i];
+        if (allocates_dedicated(info))
+        {
+            continue;
+        }
+        auto const allocation_flags = static_cast<VmaAllocationCreateFlags>(info.allocate_info);
+        auto memory_type = std::find_if(
+            memory_type_cache.begin(), memory_type_cache.end(),
+            [&](MemoryTypeCacheEntry const & cached)
+            {
+                return cached.flags == info.flags && cached.format == info.format && cached.usage == info.usage && cached.allocation_flags == allocation_flags;
+            });
+        if (memory_type == memory_type_cache.end())
+        {
+            VkImageCreateInfo const vk_image_create_info = initialize_image_create_info_from_image_info(self, info);
+            VmaAllocationCreateInfo const vma_allocation_create_info{
+                .flags = allocation_flags,
+                .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+                .requiredFlags = {},
+                .preferredFlags = {},
+                .memoryTypeBits = std::numeric_limits<u32>::max(),
+                .pool = nullptr,
+                .pUserData = nullptr,
+                .priority = 0.5f,
+            };
+            u32 memory_type_index = {};
+            result = static_cast<daxa_Result>(vmaFindMemoryTypeIndexForImageInfo(self->vma_allocator, &vk_image_create_info, &vma_allocation_create_info, &memory_type_index));
+            _DAXA_RETURN_IF_ERROR(result, result)
+            memory_type = memory_type_cache.insert(memory_type_cache.end(), MemoryTypeCacheEntry{
+                .flags = info.flags,
+                .format = info.format,
+                .usage = info.usage,
+                .allocation_flags = allocation_flags,
+                .memory_type_index = memory_type_index,
+            });
+        }
+        requests.push_back(BulkAllocationRequest{
+            .requirements = daxa_dvc_image_memory_requirements(self, &info),
+            .memory_type_index = memory_type->memory_type_index,
+            .flags = allocation_flags,
+        });
+        request_image_indices.push_back(i);
+    }
+
+    std::vector<VmaAllocation> request_allocations(requests.size());
+    result = allocate_memory_pages(self, requests, request_allocations);
+    _DAXA_RETURN_IF_ERROR(result, result)
+    std::vector<VmaAllocation> allocations(count);
+    for (usize i = 0; i < requests.size(); ++i)
+    {
+        allocations[request_image_indices[i]] = request_allocations[i];
+    }
+
+    std::vector<ImplDescriptorWrite> descriptor_writes = {};
+    descriptor_writes.reserve(count * 2);
+    u64 created_count = 0;
+    defer
+    {
+        if (result != DAXA_RESULT_SUCCESS)
+        {
+            for (u64 i = 0; i < created_count; ++i)
+            {
+                [[maybe_unused]] auto const _ignore = daxa_dvc_destroy_image(self, out_ids[i]);
+            }
+            for (u64 i = created_count; i < count; ++i)
+            {
+                vmaFreeMemory(self->vma_allocator, allocations[i]);
+            }
+        }
+    };
+    for (; created_count < count; ++created_count)
+    {
+        result = create_image_helper(self, &infos[created_count], &out_ids[created_count], nullptr, 0, allocations[created_count], &descriptor_writes);
+        _DAXA_RETURN_IF_ERROR(result, result)
+    }
+    self->gpu_sro_table.queue_descriptor_writes(descriptor_writes);
+    return result;
+}
+
 auto daxa_dvc_create_tlas(daxa_Device self, daxa_TlasInfo const * info, daxa_TlasId * out_id) -> daxa_Result
 {
     return create_acceleration_structure_helper(
@@ -775,7 +1254,7 @@ auto daxa_dvc_create_image_view(daxa_Device self, daxa_ImageViewInfo const * inf
     {
         _DAXA_RETURN_IF_ERROR(DAXA_RESULT_EXCEEDED_MAX_IMAGE_VIEWS, DAXA_RESULT_EXCEEDED_MAX_IMAGE_VIEWS);
     }
-    auto [id, image_slot] = slot_opt.value();
+    auto [id, image_slot, image_slot_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
@@ -789,18 +1268,21 @@ auto daxa_dvc_create_image_view(daxa_Device self, daxa_ImageViewInfo const * inf
     };
 
     ImplImageSlot const & parent_image_slot = self->slot(info->image);
+    ImplImageColdSlot const & parent_image_slot_cold = self->cold_slot(info->image);
     image_slot = {};
+    image_slot_cold = {};
     auto & ret = image_slot.view_slot;
-    ret.info = *info;
-    daxa_ImageMipArraySlice slice = self->validate_image_slice(ret.info.slice, ret.info.image);
-    ret.info.slice = slice;
+    auto & ret_cold = image_slot_cold.view_slot;
+    ret_cold.info = *info;
+    daxa_ImageMipArraySlice slice = self->validate_image_slice(ret_cold.info.slice, ret_cold.info.image);
+    ret_cold.info.slice = slice;
     VkImageViewCreateInfo const vk_image_view_create_info{
         .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
         .pNext = nullptr,
         .flags = {},
         .image = parent_image_slot.vk_image,
-        .viewType = static_cast<VkImageViewType>(ret.info.type),
-        .format = *r_cast<VkFormat const *>(&ret.info.format),
+        .viewType = static_cast<VkImageViewType>(ret_cold.info.type),
+        .format = *r_cast<VkFormat const *>(&ret_cold.info.format),
         .components = VkComponentMapping{
             .r = VK_COMPONENT_SWIZZLE_IDENTITY,
             .g = VK_COMPONENT_SWIZZLE_IDENTITY,
@@ -825,13 +1307,11 @@ auto daxa_dvc_create_image_view(daxa_Device self, daxa_ImageViewInfo const * inf
     }
 
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
+        // Queued, flushed before the next submit.
         write_descriptor_set_image(
-            self->vk_device,
-            self->gpu_sro_table.vk_descriptor_set,
+            self->gpu_sro_table,
             ret.vk_image_view,
-            std::bit_cast<ImageUsageFlags>(parent_image_slot.info.usage),
+            std::bit_cast<ImageUsageFlags>(parent_image_slot_cold.info.usage),
             id.index);
         *out_id = std::bit_cast<daxa_ImageViewId>(id);
     }
@@ -854,7 +1334,7 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
     {
         return DAXA_RESULT_EXCEEDED_MAX_SAMPLERS;
     }
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
@@ -867,33 +1347,33 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
         }
     };
 
-    ret.info = *info;
+    ret_cold.info = *info;
 
     VkSamplerReductionModeCreateInfo vk_sampler_reduction_mode_create_info{
         .sType = VK_STRUCTURE_TYPE_SAMPLER_REDUCTION_MODE_CREATE_INFO,
         .pNext = nullptr,
-        .reductionMode = static_cast<VkSamplerReductionMode>(ret.info.reduction_mode),
+        .reductionMode = static_cast<VkSamplerReductionMode>(ret_cold.info.reduction_mode),
     };
 
     VkSamplerCreateInfo const vk_sampler_create_info{
         .sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
         .pNext = r_cast<void *>(&vk_sampler_reduction_mode_create_info),
         .flags = {},
-        .magFilter = static_cast<VkFilter>(ret.info.magnification_filter),
-        .minFilter = static_cast<VkFilter>(ret.info.minification_filter),
-        .mipmapMode = static_cast<VkSamplerMipmapMode>(ret.info.mipmap_filter),
-        .addressModeU = static_cast<VkSamplerAddressMode>(ret.info.address_mode_u),
-        .addressModeV = static_cast<VkSamplerAddressMode>(ret.info.address_mode_v),
-        .addressModeW = static_cast<VkSamplerAddressMode>(ret.info.address_mode_w),
-        .mipLodBias = ret.info.mip_lod_bias,
-        .anisotropyEnable = static_cast<VkBool32>(ret.info.enable_anisotropy),
-        .maxAnisotropy = ret.info.max_anisotropy,
-        .compareEnable = static_cast<VkBool32>(ret.info.enable_compare),
-        .compareOp = static_cast<VkCompareOp>(ret.info.compare_op),
-        .minLod = ret.info.min_lod,
-        .maxLod = ret.info.max_lod,
-        .borderColor = static_cast<VkBorderColor>(ret.info.border_color),
-        .unnormalizedCoordinates = static_cast<VkBool32>(ret.info.enable_unnormalized_coordinates),
+        .magFilter = static_cast<VkFilter>(ret_cold.info.magnification_filter),
+        .minFilter = static_cast<VkFilter>(ret_cold.info.minification_filter),
+        .mipmapMode = static_cast<VkSamplerMipmapMode>(ret_cold.info.mipmap_filter),
+        .addressModeU = static_cast<VkSamplerAddressMode>(ret_cold.info.address_mode_u),
+        .addressModeV = static_cast<VkSamplerAddressMode>(ret_cold.info.address_mode_v),
+        .addressModeW = static_cast<VkSamplerAddressMode>(ret_cold.info.address_mode_w),
+        .mipLodBias = ret_cold.info.mip_lod_bias,
+        .anisotropyEnable = static_cast<VkBool32>(ret_cold.info.enable_anisotropy),
+        .maxAnisotropy = ret_cold.info.max_anisotropy,
+        .compareEnable = static_cast<VkBool32>(ret_cold.info.enable_compare),
+        .compareOp = static_cast<VkCompareOp>(ret_cold.info.compare_op),
+        .minLod = ret_cold.info.min_lod,
+        .maxLod = ret_cold.info.max_lod,
+        .borderColor = static_cast<VkBorderColor>(ret_cold.info.border_color),
+        .unnormalizedCoordinates = static_cast<VkBool32>(ret_cold.info.enable_unnormalized_coordinates),
     };
 
     result = static_cast<daxa_Result>(vkCreateSampler(self->vk_device, &vk_sampler_create_info, nullptr, &ret.vk_sampler));
@@ -913,9 +1393,8 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
     }
 
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_sampler(self->vk_device, self->gpu_sro_table.vk_descriptor_set, ret.vk_sampler, id.index);
+        // Queued, flushed before the next submit.
+        write_descriptor_set_sampler(self->gpu_sro_table, ret.vk_sampler, id.index);
     }
     *out_id = std::bit_cast<daxa_SamplerId>(id);
     return result;
@@ -936,7 +1415,7 @@ auto daxa_dvc_create_sampler(daxa_Device self, daxa_SamplerInfo const * info, da
     auto daxa_dvc_info_##name(daxa_Device self, daxa_##Name##Id id, daxa_##Name##Info * out_info) -> daxa_Result \
     {                                                                                                            \
         /*NOTE: THIS CAN RACE. BUT IT IS OK AS ITS A POD AND WE CHECK IF ITS VALID AFTER THE COPY!*/             \
-        auto info_copy = self->slot(id).info;                                                                    \
+        auto info_copy = self->cold_slot(id).info;                                                               \
         if (daxa_dvc_is_##name##_valid(self, id))                                                                \
         {                                                                                                        \
             *out_info = info_copy;                                                                               \
@@ -966,6 +1445,34 @@ _DAXA_DECL_COMMON_GP_RES_FUNCTIONS(sampler, Sampler, SAMPLER, sampler_slots, sam
 _DAXA_DECL_COMMON_GP_RES_FUNCTIONS(tlas, Tlas, TLAS, tlas_slots, acceleration_structure, VkAccelerationStructureKHR)
 _DAXA_DECL_COMMON_GP_RES_FUNCTIONS(blas, Blas, BLAS, blas_slots, acceleration_structure, VkAccelerationStructureKHR)
 
+// Zombifies all valid ids, pushing them onto the lock free zombie queue as one linked chain. Invalid ids are skipped and reported after all valid ids were destroyed.
+#define _DAXA_DECL_BULK_DESTROY_FUNCTION(name, Name, NAME, SLOT_NAME)                                            \
+    auto daxa_dvc_destroy_##name##s(daxa_Device self, daxa_##Name##Id const * ids, u64 count) -> daxa_Result     \
+    {                                                                                                            \
+        _DAXA_TEST_PRINT("STRONG daxa_dvc_destroy_%ss\n", #name);                                                \
+        daxa_Result result = DAXA_RESULT_SUCCESS;                                                                \
+        std::vector<Name##Id> zombified_ids = {};                                                                \
+        zombified_ids.reserve(count);                                                                            \
+        for (daxa_##Name##Id const id : std::span{ids, count})                                                   \
+        {                                                                                                        \
+            if (self->gpu_sro_table.SLOT_NAME.try_zombify(std::bit_cast<GPUResourceId>(id)))                     \
+            {                                                                                                    \
+                zombified_ids.push_back(std::bit_cast<Name##Id>(id));                                            \
+            }                                                                                                    \
+            else                                                                                                 \
+            {                                                                                                    \
+                result = DAXA_RESULT_INVALID_##NAME##_ID;                                                        \
+            }                                                                                                    \
+        }                                                                                                        \
+        self->zombify_##name##s(zombified_ids);                                                                  \
+        return result;                                                                                           \
+    }
+
+_DAXA_DECL_BULK_DESTROY_FUNCTION(buffer, Buffer, BUFFER, buffer_slots)
+_DAXA_DECL_BULK_DESTROY_FUNCTION(image, Image, IMAGE, image_slots)
+_DAXA_DECL_BULK_DESTROY_FUNCTION(image_view, ImageView, IMAGE_VIEW, image_slots)
+_DAXA_DECL_BULK_DESTROY_FUNCTION(sampler, Sampler, SAMPLER, sampler_slots)
+
 auto daxa_dvc_buffer_device_address(daxa_Device self, daxa_BufferId id, daxa_DeviceAddress * out_addr) -> daxa_Result
 {
     if (!daxa_dvc_is_buffer_valid(self, id))
@@ -1055,132 +1562,129 @@ auto daxa_dvc_queue_count(daxa_Device self, daxa_QueueFamily queue_family, u32 *
 
 auto daxa_dvc_submit(daxa_Device self, daxa_CommandSubmitInfo const * info) -> daxa_Result
 {
-    if (!self->valid_queue(info->queue))
-    {
-        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_INVALID_QUEUE, DAXA_RESULT_ERROR_INVALID_QUEUE);
-    }
-
-    std::shared_lock lifetime_lock{self->gpu_sro_table.lifetime_lock};
+    return daxa_dvc_submit_batch(self, info, 1);
+}
 
-    if (static_cast<u32>(info->queue.index) >= self->queue_families[info->queue.family].queue_count)
+auto daxa_dvc_submit_batch(daxa_Device self, daxa_CommandSubmitInfo const * infos, u64 info_count) -> daxa_Result
+{
+    auto const batches = std::span{infos, info_count};
+    if (batches.empty())
     {
-        _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_INVALID_QUEUE, DAXA_RESULT_ERROR_INVALID_QUEUE);
+        return DAXA_RESULT_SUCCESS;
     }
-
-    for (daxa_ExecutableCommandList commands : std::span{info->command_lists, info->command_list_count})
+    // All batches go into a single vkQueueSubmit2 call, so they must target the same queue.
+    for (auto const & info : batches)
     {
-        if (commands->cmd_recorder->info.queue_family != info->queue.family)
-        {
-            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH, DAXA_RESULT_ERROR_CMD_LIST_SUBMIT_QUEUE_FAMILY_MISMATCH);
-        }
-        for (BufferId id : commands->data.used_buffers)
-        {
-            if (!daxa_dvc_is_buffer_valid(self, id))
-            {
-                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_BUFFER_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_BUFFER_ID);
-            }
-        }
-        for (ImageId id : commands->data.used_images)
-        {
-            if (!daxa_dvc_is_image_valid(self, id))
-            {
-                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_ID);
-            }
-        }
-        for (ImageViewId id : commands->data.used_image_views)
+        if (!self->valid_queue(info.queue) || info.queue.family != batches[0].queue.family || info.queue.index != batches[0].queue.index)
         {
-            if (!daxa_dvc_is_image_view_valid(self, id))
-            {
-                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_VIEW_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_IMAGE_VIEW_ID);
-            }
-        }
-        for (SamplerId id : commands->data.used_samplers)
-        {
-            if (!daxa_dvc_is_sampler_valid(self, id))
-            {
-                _DAXA_RETURN_IF_ERROR(DAXA_RESULT_COMMAND_REFERENCES_INVALID_SAMPLER_ID, DAXA_RESULT_COMMAND_REFERENCES_INVALID_SAMPLER_ID);
-            }
+            _DAXA_RETURN_IF_ERROR(DAXA_RESULT_ERROR_INVALID_QUEUE, DAXA_RESULT_ERROR_INVALID_QUEUE);
         }
     }
 
-    daxa_ImplDevice::ImplQueue & queue = self->get_queue(info->queue);
-    u64 const current_timeline_value = self->global_submit_timeline.fetch_add(1) + 1;
-    queue.latest_pending_submit_timeline_value.store(current_timeline_value);
+    std::shared_lock lifetime_lock{self->gpu_sro_table.lifetime_lock};
 
-    for (auto const & commands : std::span{info->command_lists, info->command_list_count})
+    u64 command_list_count = 0;
+    u64 signal_count = 0;
+    u64 wait_count = 0;
+    for (auto const & info : batches)
     {
-        executable_cmd_list_execute_deferred_destructions(self, commands->data);
+        auto result = validate_command_submit_info(self, info);
+        _DAXA_RETURN_IF_ERROR(result, result)
+        command_list_count += info.command_list_count;
+        signal_count += 1 + info.signal_timeline_semaphore_count + info.signal_binary_semaphore_count;
+        wait_count += info.wait_timeline_semaphore_count + info.wait_binary_semaphore_count;
     }
 
-    std::vector<VkCommandBuffer> submit_vk_command_buffers = {};
-    for (auto const & commands : std::span{info->command_lists, info->command_list_count})
+    // Each batch gets its own global timeline value, so zombies created between batches stay correctly ordered.
+    daxa_ImplDevice::ImplQueue & queue = self->get_queue(batches[0].queue);
+    u64 const first_timeline_value = self->global_submit_timeline.fetch_add(info_count) + 1;
+    queue.latest_pending_submit_timeline_value.store(first_timeline_value + info_count - 1);
+
+    for (auto const & info : batches)
     {
-        submit_vk_command_buffers.push_back(commands->data.vk_cmd_buffer);
+        for (auto const & commands : std::span{info.command_lists, info.command_list_count})
+        {
+            executable_cmd_list_execute_deferred_destructions(self, commands->data);
+        }
     }
 
-    std::vector<VkSemaphore> submit_semaphore_signals = {}; // All timeline semaphores come first, then binary semaphores follow.
-    std::vector<u64> submit_semaphore_signal_values = {};   // Used for timeline semaphores. Ignored (push dummy value) for binary semaphores.
-
-    // Add main queue timeline signaling as first timeline semaphore signaling:
-    submit_semaphore_signals.push_back(queue.gpu_queue_local_timeline);
-    submit_semaphore_signal_values.push_back(current_timeline_value);
+    // All resources created before this submit must be visible in the descriptor set.
+    self->gpu_sro_table.flush_descriptor_writes(self->vk_device);
 
-    for (auto const & pair : std::span{info->signal_timeline_semaphores, info->signal_timeline_semaphore_count})
+    auto const semaphore_submit_info = [](VkSemaphore semaphore, u64 value, VkPipelineStageFlags2 stages)
     {
-        submit_semaphore_signals.push_back(pair.semaphore->vk_semaphore);
-        submit_semaphore_signal_values.push_back(pair.value);
-    }
+        return VkSemaphoreSubmitInfo{
+            .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+            .pNext = nullptr,
+            .semaphore = semaphore,
+            .value = value, // Ignored for binary semaphores.
+            .stageMask = stages,
+            .deviceIndex = 0,
+        };
+    };
 
-    for (auto const & binary_semaphore : std::span{info->signal_binary_semaphores, info->signal_binary_semaphore_count})
-    {
-        submit_semaphore_signals.push_back(binary_semaphore->vk_semaphore);
-        submit_semaphore_signal_values.push_back(0); // The vulkan spec requires to have dummy values for binary semaphores.
-    }
+    InlineStorage<VkSubmitInfo2, SUBMIT_INLINE_CAPACITY> submit_infos{info_count};
+    InlineStorage<VkCommandBufferSubmitInfo, SUBMIT_INLINE_CAPACITY> command_buffer_infos{command_list_count};
+    InlineStorage<VkSemaphoreSubmitInfo, SUBMIT_INLINE_CAPACITY> signal_infos{signal_count};
+    InlineStorage<VkSemaphoreSubmitInfo, SUBMIT_INLINE_CAPACITY> wait_infos{wait_count};
+    u64 command_buffer_index = 0;
+    u64 signal_index = 0;
+    u64 wait_index = 0;
+    for (u64 batch_index = 0; batch_index < info_count; ++batch_index)
+    {
+        auto const & info = batches[batch_index];
+        u64 const batch_command_buffer_index = command_buffer_index;
+        u64 const batch_signal_index = signal_index;
+        u64 const batch_wait_index = wait_index;
+
+        for (auto const & commands : std::span{info.command_lists, info.command_list_count})
+        {
+            command_buffer_infos.data[command_buffer_index++] = VkCommandBufferSubmitInfo{
+                .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO,
+                .pNext = nullptr,
+                .commandBuffer = commands->data.vk_cmd_buffer,
+                .deviceMask = 0,
+            };
+        }
 
-    // used to synchronize with previous submits:
-    std::vector<VkSemaphore> submit_semaphore_waits = {}; // All timeline semaphores come first, then binary semaphores follow.
-    std::vector<VkPipelineStageFlags> submit_semaphore_wait_stage_masks = {};
-    std::vector<u64> submit_semaphore_wait_values = {}; // Used for timeline semaphores. Ignored (push dummy value) for binary semaphores.
+        // The queue local timeline is signaled first, then the timeline semaphores, then the binary semaphores.
+        signal_infos.data[signal_index++] = semaphore_submit_info(queue.gpu_queue_local_timeline, first_timeline_value + batch_index, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+        for (auto const & pair : std::span{info.signal_timeline_semaphores, info.signal_timeline_semaphore_count})
+        {
+            signal_infos.data[signal_index++] = semaphore_submit_info(pair.semaphore->vk_semaphore, pair.value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+        }
+        for (auto const & binary_semaphore : std::span{info.signal_binary_semaphores, info.signal_binary_semaphore_count})
+        {
+            signal_infos.data[signal_index++] = semaphore_submit_info(binary_semaphore->vk_semaphore, 0, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+        }
 
-    for (auto const & pair : std::span{info->wait_timeline_semaphores, info->wait_timeline_semaphore_count})
-    {
-        submit_semaphore_waits.push_back(pair.semaphore->vk_semaphore);
-        submit_semaphore_wait_stage_masks.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
-        submit_semaphore_wait_values.push_back(pair.value);
-    }
+        // used to synchronize with previous submits:
+        // No wait stages means the batch waits before any of its commands execute.
+        VkPipelineStageFlags2 const wait_stages = info.wait_stages != 0 ? info.wait_stages : VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        for (auto const & pair : std::span{info.wait_timeline_semaphores, info.wait_timeline_semaphore_count})
+        {
+            wait_infos.data[wait_index++] = semaphore_submit_info(pair.semaphore->vk_semaphore, pair.value, wait_stages);
+        }
+        for (auto const & binary_semaphore : std::span{info.wait_binary_semaphores, info.wait_binary_semaphore_count})
+        {
+            wait_infos.data[wait_index++] = semaphore_submit_info(binary_semaphore->vk_semaphore, 0, wait_stages);
+        }
 
-    for (auto const & binary_semaphore : std::span{info->wait_binary_semaphores, info->wait_binary_semaphore_count})
-    {
-        submit_semaphore_waits.push_back(binary_semaphore->vk_semaphore);
-        submit_semaphore_wait_stage_masks.push_back(VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
-        submit_semaphore_wait_values.push_back(0);
+        submit_infos.data[batch_index] = VkSubmitInfo2{
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2,
+            .pNext = nullptr,
+            .flags = {},
+            .waitSemaphoreInfoCount = static_cast<u32>(wait_index - batch_wait_index),
+            .pWaitSemaphoreInfos = wait_infos.data + batch_wait_index,
+            .commandBufferInfoCount = static_cast<u32>(command_buffer_index - batch_command_buffer_index),
+            .pCommandBufferInfos = command_buffer_infos.data + batch_command_buffer_index,
+            .signalSemaphoreInfoCount = static_cast<u32>(signal_index - batch_signal_index),
+            .pSignalSemaphoreInfos = signal_infos.data + batch_signal_index,
+        };
     }
-
-    VkTimelineSemaphoreSubmitInfo timeline_info{
-        .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
-        .pNext = nullptr,
-        .waitSemaphoreValueCount = static_cast<u32>(submit_semaphore_wait_values.size()),
-        .pWaitSemaphoreValues = submit_semaphore_wait_values.data(),
-        .signalSemaphoreValueCount = static_cast<u32>(submit_semaphore_signal_values.size()),
-        .pSignalSemaphoreValues = submit_semaphore_signal_values.data(),
-    };
-
-    VkSubmitInfo const vk_submit_info{
-        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        .pNext = r_cast<void *>(&timeline_info),
-        .waitSemaphoreCount = static_cast<u32>(submit_semaphore_waits.size()),
-        .pWaitSemaphores = submit_semaphore_waits.data(),
-        .pWaitDstStageMask = submit_semaphore_wait_stage_masks.data(),
-        .commandBufferCount = static_cast<u32>(submit_vk_command_buffers.size()),
-        .pCommandBuffers = submit_vk_command_buffers.data(),
-        .signalSemaphoreCount = static_cast<u32>(submit_semaphore_signals.size()),
-        .pSignalSemaphores = submit_semaphore_signals.data(),
-    };
-    auto result = static_cast<daxa_Result>(vkQueueSubmit(queue.vk_queue, 1, &vk_submit_info, VK_NULL_HANDLE));
+    auto result = static_cast<daxa_Result>(vkQueueSubmit2(queue.vk_queue, static_cast<u32>(info_count), submit_infos.data, VK_NULL_HANDLE));
     _DAXA_RETURN_IF_ERROR(result, result)
 
-    std::unique_lock const lock{self->zombies_mtx};
-
     return DAXA_RESULT_SUCCESS;
 }
 
@@ -1219,130 +1723,274 @@ auto daxa_dvc_present(daxa_Device self, daxa_PresentInfo const * info) -> daxa_R
     return std::bit_cast<daxa_Result>(result);
 }
 
-auto daxa_dvc_collect_garbage(daxa_Device self) -> daxa_Result
-{
-    std::unique_lock lifetime_lock{self->gpu_sro_table.lifetime_lock};
-    std::unique_lock lock{self->zombies_mtx};
+// Number of gpu resource zombies recycled per exclusive lock of the lifetime lock.
+// Keeps the time concurrent submits and command recorders wait on the garbage collection short.
+static constexpr usize GARBAGE_COLLECTION_CHUNK_SIZE = 64;
 
-    u64 min_pending_device_timeline_value_of_all_queues = std::numeric_limits<u64>::max();
-    for (auto & queue : self->queues)
+auto daxa_dvc_collect_garbage_incremental(daxa_Device self, daxa_GarbageCollectionBudget const * budget, daxa_Bool8 * out_done) -> daxa_Result
+{
+    auto const start = std::chrono::steady_clock::now();
+    u64 const max_objects = budget->max_objects != 0 ? budget->max_objects : std::numeric_limits<u64>::max();
+    u64 collected_objects = 0;
+    auto const budget_left = [&]() -> bool
     {
-        std::optional<u64> latest_pending_submit = {};
-        auto result = queue.get_oldest_pending_submit(self->vk_device, latest_pending_submit);
-        _DAXA_RETURN_IF_ERROR(result, result)
-
-        if (latest_pending_submit.has_value())
+        if (collected_objects >= max_objects)
         {
-            min_pending_device_timeline_value_of_all_queues = std::min(min_pending_device_timeline_value_of_all_queues, latest_pending_submit.value());
+            return false;
         }
-    }
+        if (budget->max_duration_nanos != 0)
+        {
+            auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            return static_cast<u64>(elapsed.count()) < budget->max_duration_nanos;
+        }
+        return true;
+    };
 
-    auto check_and_cleanup_gpu_resources = [&](auto & zombies, auto const & cleanup_fn)
+    // Submits advance the timelines while holding a shared lifetime lock.
+    // Taking the exclusive lock once here gives a consistent snapshot of the global and queue timelines.
+    // Zombies created after the snapshot always have a timeline value at or above it.
+    u64 min_pending_device_timeline_value_of_all_queues = {};
     {
-        while (!zombies.empty())
+        std::unique_lock lifetime_lock{self->gpu_sro_table.lifetime_lock};
+        min_pending_device_timeline_value_of_all_queues = self->global_submit_timeline.load(std::memory_order::relaxed) + 1;
+        for (auto & queue : self->queues)
         {
-            auto & [timeline_value, object] = zombies.back();
+            std::optional<u64> latest_pending_submit = {};
+            auto result = queue.get_oldest_pending_submit(self->vk_device, latest_pending_submit);
+            _DAXA_RETURN_IF_ERROR(result, result)
 
-            if (timeline_value >= min_pending_device_timeline_value_of_all_queues)
+            if (latest_pending_submit.has_value())
             {
-                break;
+                min_pending_device_timeline_value_of_all_queues = std::min(min_pending_device_timeline_value_of_all_queues, latest_pending_submit.value());
             }
-
-            cleanup_fn(object);
-            zombies.pop_back();
         }
+    }
+    auto const is_ready = [&](auto const & zombie_queue) -> bool
+    {
+        return !zombie_queue.drained.empty() && zombie_queue.drained.back().first < min_pending_device_timeline_value_of_all_queues;
     };
-    check_and_cleanup_gpu_resources(
-        self->buffer_zombies,
-        [&](auto id)
-        {
-            self->cleanup_buffer(id);
-        });
-    check_and_cleanup_gpu_resources(
-        self->image_view_zombies,
-        [&](auto id)
-        {
-            self->cleanup_image_view(id);
-        });
-    check_and_cleanup_gpu_resources(
-        self->image_zombies,
-        [&](auto id)
-        {
-            self->cleanup_image(id);
-        });
-    check_and_cleanup_gpu_resources(
-        self->sampler_zombies,
-        [&](auto id)
+    {
+        std::unique_lock lock{self->zombies_mtx};
+        self->command_list_zombies.drain();
+        self->buffer_zombies.drain();
+        self->image_zombies.drain();
+        self->image_view_zombies.drain();
+        self->sampler_zombies.drain();
+        self->tlas_zombies.drain();
+        self->blas_zombies.drain();
+        self->semaphore_zombies.drain();
+        self->split_barrier_zombies.drain();
+        self->pipeline_zombies.drain();
+        self->timeline_query_pool_zombies.drain();
+        self->memory_block_zombies.drain();
+    }
+
+    // Queued writes may still reference resources that are about to be destroyed.
+    self->gpu_sro_table.flush_descriptor_writes(self->vk_device);
+
+    // Only recycling the slots needs the exclusive lifetime lock.
+    // The vulkan objects are destroyed after releasing it, their ids are already invalid at that point.
+    std::vector<daxa_ImplDevice::DetachedResource> detached_resources = {};
+    detached_resources.reserve(GARBAGE_COLLECTION_CHUNK_SIZE);
+    bool chunk_full = true;
+    while (chunk_full && budget_left())
+    {
+        usize const chunk_size = static_cast<usize>(std::min<u64>(GARBAGE_COLLECTION_CHUNK_SIZE, max_objects - collected_objects));
         {
-            self->cleanup_sampler(id);
-        });
-    check_and_cleanup_gpu_resources(
-        self->tlas_zombies,
-        [&](auto id)
+            std::unique_lock lifetime_lock{self->gpu_sro_table.lifetime_lock};
+            std::unique_lock lock{self->zombies_mtx};
+            auto detach_gpu_resources = [&](auto & zombie_queue, auto const & cleanup_fn)
+            {
+                while (detached_resources.size() < chunk_size && is_ready(zombie_queue))
+                {
+                    detached_resources.push_back(cleanup_fn(zombie_queue.drained.back().second));
+                    zombie_queue.drained.pop_back();
+                }
+            };
+            detach_gpu_resources(
+                self->buffer_zombies,
+                [&](auto id)
+                {
+                    return self->cleanup_buffer(id);
+                });
+            detach_gpu_resources(
+                self->image_view_zombies,
+                [&](auto id)
+                {
+                    return self->cleanup_image_view(id);
+                });
+            detach_gpu_resources(
+                self->image_zombies,
+                [&](auto id)
+                {
+                    return self->cleanup_image(id);
+                });
+            detach_gpu_resources(
+                self->sampler_zombies,
+                [&](auto id)
+                {
+                    return self->cleanup_sampler(id);
+                });
+            detach_gpu_resources(
+                self->tlas_zombies,
+                [&](auto id)
+                {
+                    return self->cleanup_tlas(id);
+                });
+            detach_gpu_resources(
+                self->blas_zombies,
+                [&](auto id)
+                {
+                    return self->cleanup_blas(id);
+                });
+        }
+        chunk_full = detached_resources.size() == chunk_size;
+        for (auto const & resource : detached_resources)
         {
-            self->cleanup_tlas(id);
-        });
-    check_and_cleanup_gpu_resources(
-        self->blas_zombies,
-        [&](auto id)
+            self->destroy_detached_resource(resource);
+        }
+        collected_objects += detached_resources.size();
+        detached_resources.clear();
+    }
+    // Write the null descriptors of all cleaned up resources at once.
+    self->gpu_sro_table.flush_descriptor_writes(self->vk_device);
+
+    // Other objects have no slots, they only need the zombie lock.
+    auto check_and_cleanup = [&](auto & zombie_queue, auto const & cleanup_fn)
+    {
+        std::unique_lock lock{self->zombies_mtx};
+        while (budget_left() && is_ready(zombie_queue))
         {
-            self->cleanup_blas(id);
-        });
-    check_and_cleanup_gpu_resources(
+            cleanup_fn(zombie_queue.drained.back().second);
+            zombie_queue.drained.pop_back();
+            ++collected_objects;
+        }
+    };
+    check_and_cleanup(
         self->pipeline_zombies,
         [&](auto & pipeline_zombie)
         {
             vkDestroyPipeline(self->vk_device, pipeline_zombie.vk_pipeline, nullptr);
         });
-    check_and_cleanup_gpu_resources(
+    check_and_cleanup(
         self->semaphore_zombies,
         [&](auto & semaphore_zombie)
         {
             vkDestroySemaphore(self->vk_device, semaphore_zombie.vk_semaphore, nullptr);
         });
-    check_and_cleanup_gpu_resources(
+    check_and_cleanup(
         self->split_barrier_zombies,
         [&](auto & split_barrier_zombie)
         {
             vkDestroyEvent(self->vk_device, split_barrier_zombie.vk_event, nullptr);
         });
-    check_and_cleanup_gpu_resources(
+    check_and_cleanup(
         self->timeline_query_pool_zombies,
         [&](auto & timeline_query_pool_zombie)
         {
             vkDestroyQueryPool(self->vk_device, timeline_query_pool_zombie.vk_timeline_query_pool, nullptr);
         });
-    check_and_cleanup_gpu_resources(
+    check_and_cleanup(
         self->memory_block_zombies,
         [&](auto & memory_block_zombie)
         {
             vmaFreeMemory(self->vma_allocator, memory_block_zombie.allocation);
         });
     {
+        std::unique_lock lock{self->zombies_mtx};
         std::unique_lock const main_queue_lock{self->command_pool_pools[DAXA_QUEUE_FAMILY_MAIN].mtx};
         std::unique_lock const compute_queue_lock{self->command_pool_pools[DAXA_QUEUE_FAMILY_COMPUTE].mtx};
         std::unique_lock const transfer_queue_lock{self->command_pool_pools[DAXA_QUEUE_FAMILY_TRANSFER].mtx};
-        while (!self->command_list_zombies.empty())
+        // Zombies are sorted. When we see a single zombie that is too young, we can dismiss the rest as they are the same age or even younger.
+        while (budget_left() && is_ready(self->command_list_zombies))
         {
-            auto & [timeline_value, zombie] = self->command_list_zombies.back();
-
-            // Zombies are sorted. When we see a single zombie that is too young, we can dismiss the rest as they are the same age or even younger.
-            if (timeline_value >= min_pending_device_timeline_value_of_all_queues)
-            {
-                break;
-            }
-
+            auto & zombie = self->command_list_zombies.drained.back().second;
             vkFreeCommandBuffers(self->vk_device, zombie.vk_cmd_pool, static_cast<u32>(zombie.allocated_command_buffers.size()), zombie.allocated_command_buffers.data());
             auto result = static_cast<daxa_Result>(vkResetCommandPool(self->vk_device, zombie.vk_cmd_pool, {}));
             _DAXA_RETURN_IF_ERROR(result, result)
 
             self->command_pool_pools[zombie.queue_family].put_back(zombie.vk_cmd_pool);
-            self->command_list_zombies.pop_back();
+            self->command_list_zombies.drained.pop_back();
+            ++collected_objects;
+        }
+    }
+
+    if (out_done != nullptr)
+    {
+        std::unique_lock lock{self->zombies_mtx};
+        *out_done = static_cast<daxa_Bool8>(
+            !is_ready(self->buffer_zombies) && !is_ready(self->image_view_zombies) && !is_ready(self->image_zombies) &&
+            !is_ready(self->sampler_zombies) && !is_ready(self->tlas_zombies) && !is_ready(self->blas_zombies) &&
+            !is_ready(self->pipeline_zombies) && !is_ready(self->semaphore_zombies) && !is_ready(self->split_barrier_zombies) &&
+            !is_ready(self->timeline_query_pool_zombies) && !is_ready(self->memory_block_zombies) && !is_ready(self->command_list_zombies));
+    }
+    return DAXA_RESULT_SUCCESS;
+}
+
+auto daxa_dvc_collect_garbage(daxa_Device self) -> daxa_Result
+{
+    daxa_GarbageCollectionBudget const unlimited_budget = {};
+    return daxa_dvc_collect_garbage_incremental(self, &unlimited_budget, nullptr);
+}
+
+void daxa_dvc_flush_descriptor_writes(daxa_Device self)
+{
+    self->gpu_sro_table.flush_descriptor_writes(self->vk_device);
+}
+
+void daxa_dvc_descriptor_write_statistics(daxa_Device self, daxa_DescriptorWriteStatistics * out_statistics)
+{
+    std::unique_lock const lock{self->gpu_sro_table.descriptor_write_mtx};
+    *out_statistics = self->gpu_sro_table.descriptor_write_statistics;
+}
+
+auto daxa_dvc_save_pipeline_cache(daxa_Device self) -> daxa_Result
+{
+    if (self->pipeline_cache_path.empty())
+    {
+        return DAXA_RESULT_SUCCESS;
+    }
+    usize data_size = {};
+    std::vector<char> data = {};
+    auto result = DAXA_RESULT_INCOMPLETE;
+    // Pipelines created on other threads can grow the cache between the size query and the copy, the copy then returns VK_INCOMPLETE.
+    // A partial copy is not a valid cache, so the size is queried again until the copy is complete.
+    while (result == DAXA_RESULT_INCOMPLETE)
+    {
+        result = static_cast<daxa_Result>(vkGetPipelineCacheData(self->vk_device, self->vk_pipeline_cache, &data_size, nullptr));
+        _DAXA_RETURN_IF_ERROR(result, result)
+        data.resize(data_size);
+        result = static_cast<daxa_Result>(vkGetPipelineCacheData(self->vk_device, self->vk_pipeline_cache, &data_size, data.data()));
+    }
+    _DAXA_RETURN_IF_ERROR(result, result)
+
+    // Written to a temporary file first, so a crash while saving never leaves a truncated cache behind.
+    auto const header = make_pipeline_cache_file_header(self->properties, data_size);
+    auto const temporary_path = self->pipeline_cache_path + ".tmp";
+    {
+        auto file = std::ofstream{temporary_path, std::ios::binary | std::ios::trunc};
+        file.write(r_cast<char const *>(&header), sizeof(PipelineCacheFileHeader));
+        file.write(data.data(), static_cast<std::streamsize>(data_size));
+        if (!file)
+        {
+            return DAXA_RESULT_ERROR_FAILED_TO_WRITE_PIPELINE_CACHE;
         }
     }
+    std::error_code error = {};
+    std::filesystem::rename(temporary_path, self->pipeline_cache_path, error);
+    if (error)
+    {
+        return DAXA_RESULT_ERROR_FAILED_TO_WRITE_PIPELINE_CACHE;
+    }
     return DAXA_RESULT_SUCCESS;
 }
 
+void daxa_dvc_command_list_data_statistics(daxa_Device self, daxa_CommandListDataStatistics * out_statistics)
+{
+    std::unique_lock const lock{self->command_list_data_pool.mtx};
+    *out_statistics = self->command_list_data_pool.statistics;
+}
+
 auto daxa_dvc_properties(daxa_Device device) -> daxa_DeviceProperties const *
 {
     return &device->properties;
@@ -1377,6 +2025,11 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
     self->properties = properties;
     self->instance = instance;
     self->info = std::bit_cast<DeviceInfo2>(info);
+    if (info.pipeline_cache_path != nullptr)
+    {
+        self->pipeline_cache_path = info.pipeline_cache_path;
+    }
+    self->info.pipeline_cache_path = self->pipeline_cache_path.empty() ? nullptr : self->pipeline_cache_path.c_str();
 
     // Verify DeviceOptions:
     if (self->info.max_allowed_buffers > self->properties.limits.max_descriptor_set_storage_buffers || self->info.max_allowed_buffers == 0)
@@ -2017,6 +2670,36 @@ auto daxa_ImplDevice::create_2(daxa_Instance instance, daxa_DeviceInfo2 const &
     result = static_cast<daxa_Result>(vkDeviceWaitIdle(self->vk_device));
     _DAXA_RETURN_IF_ERROR(result, DAXA_RESULT_FAILED_TO_SUBMIT_DEVICE_INIT_COMMANDS)
 
+    {
+        std::vector<char> initial_data = {};
+        if (!self->pipeline_cache_path.empty())
+        {
+            initial_data = load_pipeline_cache_data(self->pipeline_cache_path, self->properties);
+        }
+        VkPipelineCacheCreateInfo vk_pipeline_cache_create_info{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = {},
+            .initialDataSize = initial_data.size(),
+            .pInitialData = initial_data.data(),
+        };
+        result = static_cast<daxa_Result>(vkCreatePipelineCache(self->vk_device, &vk_pipeline_cache_create_info, nullptr, &self->vk_pipeline_cache));
+        if (result != DAXA_RESULT_SUCCESS && !initial_data.empty())
+        {
+            // The driver rejected the cached data, start with an empty cache instead.
+            vk_pipeline_cache_create_info.initialDataSize = 0;
+            vk_pipeline_cache_create_info.pInitialData = nullptr;
+            result = static_cast<daxa_Result>(vkCreatePipelineCache(self->vk_device, &vk_pipeline_cache_create_info, nullptr, &self->vk_pipeline_cache));
+        }
+        _DAXA_RETURN_IF_ERROR(result, result)
+    }
+
+    if (self->info.background_garbage_collection_interval_ms != 0)
+    {
+        self->background_gc_thread = std::thread{[self]()
+                                                 { self->background_garbage_collection_loop(); }};
+    }
+
     return DAXA_RESULT_SUCCESS;
 }
 
@@ -2039,7 +2722,7 @@ auto daxa_ImplDevice::validate_image_slice(daxa_ImageMipArraySlice const & slice
 {
     if (slice.level_count == std::numeric_limits<u32>::max() || slice.level_count == 0)
     {
-        auto & image_info = this->slot(id).info;
+        auto & image_info = this->cold_slot(id).info;
         return daxa_ImageMipArraySlice{
             .base_mip_level = 0,
             .level_count = image_info.mip_level_count,
@@ -2057,7 +2740,7 @@ auto daxa_ImplDevice::validate_image_slice(daxa_ImageMipArraySlice const & slice
 {
     if (slice.level_count == std::numeric_limits<u32>::max() || slice.level_count == 0)
     {
-        return this->slot(id).info.slice;
+        return this->cold_slot(id).info.slice;
     }
     else
     {
@@ -2071,7 +2754,7 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
 
     auto slot_opt = this->gpu_sro_table.image_slots.try_create_slot();
     DAXA_DBG_ASSERT_TRUE_M(slot_opt.has_value(), "CRITICAL INTERNAL ERROR, EXCEEDED MAX IMAGES IN SWAPCHAIN CREATION");
-    auto [id, ret] = slot_opt.value();
+    auto [id, ret, ret_cold] = slot_opt.value();
     defer
     {
         if (result != DAXA_RESULT_SUCCESS)
@@ -2081,7 +2764,7 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
     };
 
     ret.vk_image = swapchain_image;
-    ret.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
+    ret_cold.view_slot.info = std::bit_cast<daxa_ImageViewInfo>(ImageViewInfo{
         .type = static_cast<ImageViewType>(image_info.dimensions - 1),
         .format = image_info.format,
         .image = {id},
@@ -2116,9 +2799,9 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
             .layerCount = 1,
         },
     };
-    ret.swapchain_image_index = static_cast<i32>(index);
+    ret_cold.swapchain_image_index = static_cast<i32>(index);
 
-    ret.info = *r_cast<daxa_ImageInfo const *>(&image_info);
+    ret_cold.info = *r_cast<daxa_ImageInfo const *>(&image_info);
     result = static_cast<daxa_Result>(vkCreateImageView(vk_device, &view_ci, nullptr, &ret.view_slot.vk_image_view));
     _DAXA_RETURN_IF_ERROR(result, result)
 
@@ -2145,9 +2828,8 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
     }
 
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(this->vk_device, this->gpu_sro_table.vk_descriptor_set, ret.view_slot.vk_image_view, usage, id.index);
+        // Queued, flushed before the next submit.
+        write_descriptor_set_image(this->gpu_sro_table, ret.view_slot.vk_image_view, usage, id.index);
     }
 
     *out = ImageId{id};
@@ -2155,96 +2837,146 @@ auto daxa_ImplDevice::new_swapchain_image(VkImage swapchain_image, VkFormat form
     return result;
 }
 
-void daxa_ImplDevice::cleanup_buffer(BufferId id)
+auto daxa_ImplDevice::cleanup_buffer(BufferId id) -> DetachedResource
 {
     auto gid = std::bit_cast<GPUResourceId>(id);
     ImplBufferSlot const & buffer_slot = this->gpu_sro_table.buffer_slots.unsafe_get(gid);
+    ImplBufferColdSlot const & buffer_slot_cold = this->gpu_sro_table.buffer_slots.unsafe_get_cold(gid);
     this->buffer_device_address_buffer_host_ptr[gid.index] = 0;
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_buffer(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_buffer, 0, VK_WHOLE_SIZE, gid.index);
+        // Queued, flushed at the end of collect_garbage.
+        write_descriptor_set_buffer(this->gpu_sro_table, this->vk_null_buffer, 0, VK_WHOLE_SIZE, gid.index);
     }
-    if (buffer_slot.opt_memory_block != nullptr)
+    DetachedResource ret = {.vk_buffer = buffer_slot.vk_buffer};
+    if (buffer_slot_cold.opt_memory_block == nullptr)
     {
-        vkDestroyBuffer(this->vk_device, buffer_slot.vk_buffer, {});
+        ret.vma_allocation = buffer_slot_cold.vma_allocation;
     }
-    else
-    {
-        vmaDestroyBuffer(this->vma_allocator, buffer_slot.vk_buffer, buffer_slot.vma_allocation);
-    }
-    gpu_sro_table.buffer_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
+    gpu_sro_table.buffer_slots.unsafe_destroy_zombie_slot(gid);
+    return ret;
 }
 
-void daxa_ImplDevice::cleanup_image(ImageId id)
+auto daxa_ImplDevice::cleanup_image(ImageId id) -> DetachedResource
 {
     _DAXA_TEST_PRINT("cleanup image\n");
     auto gid = std::bit_cast<GPUResourceId>(id);
     ImplImageSlot const & image_slot = gpu_sro_table.image_slots.unsafe_get(gid);
+    ImplImageColdSlot const & image_slot_cold = gpu_sro_table.image_slots.unsafe_get_cold(gid);
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
+        // Queued, flushed at the end of collect_garbage.
         write_descriptor_set_image(
-            this->vk_device,
-            this->gpu_sro_table.vk_descriptor_set,
+            this->gpu_sro_table,
             this->vk_null_image_view,
-            std::bit_cast<ImageUsageFlags>(image_slot.info.usage),
+            std::bit_cast<ImageUsageFlags>(image_slot_cold.info.usage),
             gid.index);
     }
-    vkDestroyImageView(vk_device, image_slot.view_slot.vk_image_view, nullptr);
-    if (image_slot.swapchain_image_index == NOT_OWNED_BY_SWAPCHAIN)
+    DetachedResource ret = {.vk_image_view = image_slot.view_slot.vk_image_view};
+    // Swapchain images are owned by the swapchain, only their default view is destroyed here.
+    if (image_slot_cold.swapchain_image_index == NOT_OWNED_BY_SWAPCHAIN)
     {
-        if (image_slot.opt_memory_block != nullptr)
-        {
-            vkDestroyImage(this->vk_device, image_slot.vk_image, {});
-        }
-        else
+        ret.vk_image = image_slot.vk_image;
+        if (image_slot_cold.opt_memory_block == nullptr)
         {
-            vmaDestroyImage(this->vma_allocator, image_slot.vk_image, image_slot.vma_allocation);
+            ret.vma_allocation = image_slot_cold.vma_allocation;
         }
     }
-    gpu_sro_table.image_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
+    gpu_sro_table.image_slots.unsafe_destroy_zombie_slot(gid);
+    return ret;
 }
 
-void daxa_ImplDevice::cleanup_image_view(ImageViewId id)
+auto daxa_ImplDevice::cleanup_image_view(ImageViewId id) -> DetachedResource
 {
     DAXA_DBG_ASSERT_TRUE_M(gpu_sro_table.image_slots.unsafe_get(std::bit_cast<GPUResourceId>(id)).vk_image == VK_NULL_HANDLE, "can not destroy default image view of image");
     ImplImageViewSlot const & image_slot = gpu_sro_table.image_slots.unsafe_get(std::bit_cast<GPUResourceId>(id)).view_slot;
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_image(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_image_view, ImageUsageFlagBits::SHADER_STORAGE | ImageUsageFlagBits::SHADER_SAMPLED, std::bit_cast<daxa::ImageViewId>(id).index);
+        // Queued, flushed at the end of collect_garbage.
+        write_descriptor_set_image(this->gpu_sro_table, this->vk_null_image_view, ImageUsageFlagBits::SHADER_STORAGE | ImageUsageFlagBits::SHADER_SAMPLED, std::bit_cast<daxa::ImageViewId>(id).index);
     }
-    vkDestroyImageView(vk_device, image_slot.vk_image_view, nullptr);
+    DetachedResource const ret = {.vk_image_view = image_slot.vk_image_view};
     gpu_sro_table.image_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
+    return ret;
 }
 
-void daxa_ImplDevice::cleanup_sampler(SamplerId id)
+auto daxa_ImplDevice::cleanup_sampler(SamplerId id) -> DetachedResource
 {
     ImplSamplerSlot const & sampler_slot = this->gpu_sro_table.sampler_slots.unsafe_get(std::bit_cast<GPUResourceId>(id));
     {
-        // Does not need external sync given we use update after bind.
-        // https://registry.khronos.org/vulkan/specs/1.3-extensions/man/html/VkDescriptorBindingFlagBits.html
-        write_descriptor_set_sampler(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_sampler, std::bit_cast<GPUResourceId>(id).index);
+        // Queued, flushed at the end of collect_garbage.
+        write_descriptor_set_sampler(this->gpu_sro_table, this->vk_null_sampler, std::bit_cast<GPUResourceId>(id).index);
     }
-    vkDestroySampler(this->vk_device, sampler_slot.vk_sampler, nullptr);
+    DetachedResource const ret = {.vk_sampler = sampler_slot.vk_sampler};
     gpu_sro_table.sampler_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
+    return ret;
 }
 
-void daxa_ImplDevice::cleanup_tlas(TlasId id)
+auto daxa_ImplDevice::cleanup_tlas(TlasId id) -> DetachedResource
 {
     ImplTlasSlot const & tlas_slot = this->gpu_sro_table.tlas_slots.unsafe_get(std::bit_cast<GPUResourceId>(id));
     // TODO(Raytracing): Add null acceleration structure:
-    // write_descriptor_set_acceleration_structure(this->vk_device, this->gpu_sro_table.vk_descriptor_set, this->vk_null_acceleration_structure, std::bit_cast<GPUResourceId>(id).index);
-    this->vkDestroyAccelerationStructureKHR(this->vk_device, tlas_slot.vk_acceleration_structure, nullptr);
+    // write_descriptor_set_acceleration_structure(this->gpu_sro_table, this->vk_null_acceleration_structure, std::bit_cast<GPUResourceId>(id).index);
+    DetachedResource const ret = {.vk_acceleration_structure = tlas_slot.vk_acceleration_structure};
     gpu_sro_table.tlas_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
+    return ret;
 }
 
-void daxa_ImplDevice::cleanup_blas(BlasId id)
+auto daxa_ImplDevice::cleanup_blas(BlasId id) -> DetachedResource
 {
     ImplBlasSlot const & blas_slot = this->gpu_sro_table.blas_slots.unsafe_get(std::bit_cast<GPUResourceId>(id));
-    this->vkDestroyAccelerationStructureKHR(this->vk_device, blas_slot.vk_acceleration_structure, nullptr);
+    DetachedResource const ret = {.vk_acceleration_structure = blas_slot.vk_acceleration_structure};
     gpu_sro_table.blas_slots.unsafe_destroy_zombie_slot(std::bit_cast<GPUResourceId>(id));
+    return ret;
+}
+
+void daxa_ImplDevice::destroy_detached_resource(DetachedResource const & resource)
+{
+    if (resource.vk_image_view != VK_NULL_HANDLE)
+    {
+        vkDestroyImageView(this->vk_device, resource.vk_image_view, nullptr);
+    }
+    if (resource.vk_image != VK_NULL_HANDLE)
+    {
+        if (resource.vma_allocation != nullptr)
+        {
+            vmaDestroyImage(this->vma_allocator, resource.vk_image, resource.vma_allocation);
+        }
+        else
+        {
+            vkDestroyImage(this->vk_device, resource.vk_image, nullptr);
+        }
+    }
+    if (resource.vk_buffer != VK_NULL_HANDLE)
+    {
+        if (resource.vma_allocation != nullptr)
+        {
+            vmaDestroyBuffer(this->vma_allocator, resource.vk_buffer, resource.vma_allocation);
+        }
+        else
+        {
+            vkDestroyBuffer(this->vk_device, resource.vk_buffer, nullptr);
+        }
+    }
+    if (resource.vk_sampler != VK_NULL_HANDLE)
+    {
+        vkDestroySampler(this->vk_device, resource.vk_sampler, nullptr);
+    }
+    if (resource.vk_acceleration_structure != VK_NULL_HANDLE)
+    {
+        this->vkDestroyAccelerationStructureKHR(this->vk_device, resource.vk_acceleration_structure, nullptr);
+    }
+}
+
+void daxa_ImplDevice::background_garbage_collection_loop()
+{
+    auto const interval = std::chrono::milliseconds{this->info.background_garbage_collection_interval_ms};
+    std::unique_lock lock{this->background_gc_mtx};
+    while (!this->background_gc_cv.wait_for(lock, interval, [&]()
+                                            { return this->background_gc_stop; }))
+    {
+        lock.unlock();
+        [[maybe_unused]] auto const result = daxa_dvc_collect_garbage(this);
+        DAXA_DBG_ASSERT_TRUE_M(result == DAXA_RESULT_SUCCESS, "background garbage collection failed");
+        lock.lock();
+    }
 }
 
 auto daxa_ImplDevice::slot(daxa_BufferId id) const -> ImplBufferSlot const &
@@ -2277,14 +3009,56 @@ auto daxa_ImplDevice::slot(daxa_BlasId id) const -> ImplBlasSlot const &
     return gpu_sro_table.blas_slots.unsafe_get(std::bit_cast<daxa::GPUResourceId>(id));
 }
 
+auto daxa_ImplDevice::cold_slot(daxa_BufferId id) const -> ImplBufferColdSlot const &
+{
+    return gpu_sro_table.buffer_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_ImageId id) const -> ImplImageColdSlot const &
+{
+    return gpu_sro_table.image_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_ImageViewId id) const -> ImplImageViewColdSlot const &
+{
+    return gpu_sro_table.image_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id)).view_slot;
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_SamplerId id) const -> ImplSamplerColdSlot const &
+{
+    return gpu_sro_table.sampler_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_TlasId id) const -> ImplTlasColdSlot const &
+{
+    return gpu_sro_table.tlas_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
+auto daxa_ImplDevice::cold_slot(daxa_BlasId id) const -> ImplBlasColdSlot const &
+{
+    return gpu_sro_table.blas_slots.unsafe_get_cold(std::bit_cast<daxa::GPUResourceId>(id));
+}
+
 void daxa_ImplDevice::zero_ref_callback(ImplHandle const * handle)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zero_ref_callback\n");
     auto self = rc_cast<daxa_Device>(handle);
+    if (self->background_gc_thread.joinable())
+    {
+        {
+            std::unique_lock const lock{self->background_gc_mtx};
+            self->background_gc_stop = true;
+        }
+        self->background_gc_cv.notify_one();
+        self->background_gc_thread.join();
+    }
     auto result = daxa_dvc_wait_idle(self);
     DAXA_DBG_ASSERT_TRUE_M(result == DAXA_RESULT_SUCCESS, "failed to wait idle");
     result = daxa_dvc_collect_garbage(self);
     DAXA_DBG_ASSERT_TRUE_M(result == DAXA_RESULT_SUCCESS, "failed to wait idle");
+    // Failing to write the cache only costs compile time on the next start.
+    [[maybe_unused]] auto const save_result = daxa_dvc_save_pipeline_cache(self);
+    vkDestroyPipelineCache(self->vk_device, self->vk_pipeline_cache, nullptr);
     for (auto & pool_pool : self->command_pool_pools)
     {
         pool_pool.cleanup(self);
@@ -2309,66 +3083,90 @@ void daxa_ImplDevice::zero_ref_callback(ImplHandle const * handle)
 }
 
 template <typename T>
-void zombiefy(daxa_Device self, T id, auto & slots, auto & zombies)
+void zombiefy(daxa_Device self, std::span<T const> ids, auto & slots, auto & zombies)
 {
-    [[maybe_unused]] auto & slot = slots.unsafe_get(std::bit_cast<GPUResourceId>(id));
-    if constexpr (std::is_same_v<T, BufferId> || std::is_same_v<T, ImageId>)
+    for (T const id : ids)
     {
-        if (slot.opt_memory_block != nullptr)
+        [[maybe_unused]] auto & slot = slots.unsafe_get_cold(std::bit_cast<GPUResourceId>(id));
+        if constexpr (std::is_same_v<T, BufferId> || std::is_same_v<T, ImageId>)
         {
-            slot.opt_memory_block->dec_weak_refcnt(
-                daxa_ImplMemoryBlock::zero_ref_callback,
-                self->instance);
+            if (slot.opt_memory_block != nullptr)
+            {
+                slot.opt_memory_block->dec_weak_refcnt(
+                    daxa_ImplMemoryBlock::zero_ref_callback,
+                    self->instance);
+            }
         }
-    }
-    if constexpr (std::is_same_v<T, TlasId> || std::is_same_v<T, BlasId>)
-    {
-        if (slot.owns_buffer)
+        if constexpr (std::is_same_v<T, TlasId> || std::is_same_v<T, BlasId>)
         {
-            self->zombify_buffer(slot.buffer_id);
+            if (slot.owns_buffer)
+            {
+                self->zombify_buffer(slot.buffer_id);
+            }
         }
     }
     u64 const submit_timeline_value = self->global_submit_timeline.load(std::memory_order::relaxed);
-    {
-        std::unique_lock const lock{self->zombies_mtx};
-        zombies.push_front(std::pair{submit_timeline_value, id});
-    }
+    zombies.push_range(submit_timeline_value, ids);
 }
 
 void daxa_ImplDevice::zombify_buffer(BufferId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_buffer\n");
-    zombiefy(this, id, gpu_sro_table.buffer_slots, this->buffer_zombies);
+    zombiefy<BufferId>(this, std::span{&id, 1}, gpu_sro_table.buffer_slots, this->buffer_zombies);
+}
+
+void daxa_ImplDevice::zombify_buffers(std::span<BufferId const> ids)
+{
+    _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_buffers\n");
+    zombiefy<BufferId>(this, ids, gpu_sro_table.buffer_slots, this->buffer_zombies);
 }
 
 void daxa_ImplDevice::zombify_image(ImageId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_image (%i,%i)\n", id.index, id.version);
-    zombiefy(this, id, gpu_sro_table.image_slots, this->image_zombies);
+    zombiefy<ImageId>(this, std::span{&id, 1}, gpu_sro_table.image_slots, this->image_zombies);
+}
+
+void daxa_ImplDevice::zombify_images(std::span<ImageId const> ids)
+{
+    _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_images\n");
+    zombiefy<ImageId>(this, ids, gpu_sro_table.image_slots, this->image_zombies);
 }
 
 void daxa_ImplDevice::zombify_image_view(ImageViewId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_image_view\n");
-    zombiefy(this, id, gpu_sro_table.image_slots, this->image_view_zombies);
+    zombiefy<ImageViewId>(this, std::span{&id, 1}, gpu_sro_table.image_slots, this->image_view_zombies);
+}
+
+void daxa_ImplDevice::zombify_image_views(std::span<ImageViewId const> ids)
+{
+    _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_image_views\n");
+    zombiefy<ImageViewId>(this, ids, gpu_sro_table.image_slots, this->image_view_zombies);
 }
 
 void daxa_ImplDevice::zombify_sampler(SamplerId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_sampler\n");
-    zombiefy(this, id, gpu_sro_table.sampler_slots, this->sampler_zombies);
+    zombiefy<SamplerId>(this, std::span{&id, 1}, gpu_sro_table.sampler_slots, this->sampler_zombies);
+}
+
+void daxa_ImplDevice::zombify_samplers(std::span<SamplerId const> ids)
+{
+    _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_samplers\n");
+    zombiefy<SamplerId>(this, ids, gpu_sro_table.sampler_slots, this->sampler_zombies);
 }
 
 void daxa_ImplDevice::zombify_tlas(TlasId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_tlas\n");
-    zombiefy(this, id, gpu_sro_table.tlas_slots, this->tlas_zombies);
+    zombiefy<TlasId>(this, std::span{&id, 1}, gpu_sro_table.tlas_slots, this->tlas_zombies);
 }
 
 void daxa_ImplDevice::zombify_blas(BlasId id)
 {
     _DAXA_TEST_PRINT("daxa_ImplDevice::zombify_blas\n");
-    zombiefy(this, id, gpu_sro_table.blas_slots, this->blas_zombies);
+    zombiefy<BlasId>(this, std::span{&id, 1}, gpu_sro_table.blas_slots, this->blas_zombies);
 }
 
 // --- End Internal Functions ---
\ No newline at end of file
@@ -13,6 +13,8 @@
 #include <daxa/c/device.h>
 
 #include <atomic>
+#include <thread>
+#include <condition_variable>
 
 using namespace daxa;
 
@@ -22,6 +24,80 @@ struct SubmitZombie
     std::vector<daxa_TimelineSemaphore> timeline_semaphores = {};
 };
 
+// Multi producer single consumer queue of zombies, each tagged with the global submit timeline value at zombification.
+// Destroying objects pushes lock free, so worker threads never wait on each other or on collect_garbage.
+// collect_garbage drains everything pushed so far into the drained deque and only processes that.
+template <typename T>
+struct ZombieQueue
+{
+    struct Node
+    {
+        u64 timeline_value;
+        T zombie;
+        Node * next;
+    };
+    std::atomic<Node *> pushed = {};
+    // Oldest zombies are at the back. Only accessed by collect_garbage while holding zombies_mtx.
+    std::deque<std::pair<u64, T>> drained = {};
+
+    ZombieQueue() = default;
+    ~ZombieQueue()
+    {
+        drain();
+    }
+
+    void push(u64 timeline_value, T zombie)
+    {
+        auto * node = new Node{timeline_value, std::move(zombie), nullptr};
+        push_chain(node, node);
+    }
+
+    void push_range(u64 timeline_value, std::span<T const> zombies)
+    {
+        Node * first = nullptr;
+        Node * last = nullptr;
+        for (T const & zombie : zombies)
+        {
+            first = new Node{timeline_value, zombie, first};
+            last = last == nullptr ? first : last;
+        }
+        if (first != nullptr)
+        {
+            push_chain(first, last);
+        }
+    }
+
+    void drain()
+    {
+        // Pushed nodes are linked newest first, reverse them so the oldest zombies end up at the back.
+        Node * node = pushed.exchange(nullptr, std::memory_order::acquire);
+        Node * reversed = nullptr;
+        while (node != nullptr)
+        {
+            Node * next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+        while (reversed != nullptr)
+        {
+            Node * next = reversed->next;
+            drained.emplace_front(reversed->timeline_value, std::move(reversed->zombie));
+            delete reversed;
+            reversed = next;
+        }
+    }
+
+    // first is the newest node of the chain, last the oldest one.
+    void push_chain(Node * first, Node * last)
+    {
+        last->next = pushed.load(std::memory_order::relaxed);
+        while (!pushed.compare_exchange_weak(last->next, first, std::memory_order::release, std::memory_order::relaxed))
+        {
+        }
+    }
+};
+
 static inline constexpr u64 MAX_PENDING_SUBMISSIONS_PER_QUEUE = 64;
 static inline constexpr u64 MAIN_QUEUE_INDEX = 0;
 static inline constexpr u64 FIRST_COMPUTE_QUEUE_IDX = 1;
@@ -37,6 +113,9 @@ struct daxa_ImplDevice final : public ImplHandle
     PhysicalDeviceFeaturesStruct physical_device_features = {};
     VkDevice vk_device = {};
     VmaAllocator vma_allocator = {};
+    VkPipelineCache vk_pipeline_cache = {};
+    // info.pipeline_cache_path points into this string.
+    std::string pipeline_cache_path = {};
 
     // Dynamic State:
     PFN_vkCmdSetRasterizationSamplesEXT vkCmdSetRasterizationSamplesEXT = {};
@@ -83,6 +162,7 @@ struct daxa_ImplDevice final : public ImplHandle
     // Command Buffer/Pool recycling:
     // Index with daxa_QueueFamily.
     std::array<CommandPoolPool, 3> command_pool_pools = {};
+    CommandListDataPool command_list_data_pool = {};
 
     // Gpu Shader Resource Object table:
     GPUShaderResourceTable gpu_sro_table = {};
@@ -93,19 +173,26 @@ struct daxa_ImplDevice final : public ImplHandle
     // When collect garbage is called, the zombies timeline values are compared against submits running in all queues.
     // If the zombies global submit index is smaller then global index of all submits currently in flight (on all queues), we can safely clean the resource up.
     std::atomic_uint64_t global_submit_timeline = {};
-    std::recursive_mutex zombies_mtx = {};
-    std::deque<std::pair<u64, CommandRecorderZombie>> command_list_zombies = {};
-    std::deque<std::pair<u64, BufferId>> buffer_zombies = {};
-    std::deque<std::pair<u64, ImageId>> image_zombies = {};
-    std::deque<std::pair<u64, ImageViewId>> image_view_zombies = {};
-    std::deque<std::pair<u64, SamplerId>> sampler_zombies = {};
-    std::deque<std::pair<u64, TlasId>> tlas_zombies = {};
-    std::deque<std::pair<u64, BlasId>> blas_zombies = {};
-    std::deque<std::pair<u64, SemaphoreZombie>> semaphore_zombies = {};
-    std::deque<std::pair<u64, EventZombie>> split_barrier_zombies = {};
-    std::deque<std::pair<u64, PipelineZombie>> pipeline_zombies = {};
-    std::deque<std::pair<u64, TimelineQueryPoolZombie>> timeline_query_pool_zombies = {};
-    std::deque<std::pair<u64, MemoryBlockZombie>> memory_block_zombies = {};
+    // Only taken by collect_garbage, pushing zombies is lock free.
+    std::mutex zombies_mtx = {};
+    ZombieQueue<CommandRecorderZombie> command_list_zombies = {};
+    ZombieQueue<BufferId> buffer_zombies = {};
+    ZombieQueue<ImageId> image_zombies = {};
+    ZombieQueue<ImageViewId> image_view_zombies = {};
+    ZombieQueue<SamplerId> sampler_zombies = {};
+    ZombieQueue<TlasId> tlas_zombies = {};
+    ZombieQueue<BlasId> blas_zombies = {};
+    ZombieQueue<SemaphoreZombie> semaphore_zombies = {};
+    ZombieQueue<EventZombie> split_barrier_zombies = {};
+    ZombieQueue<PipelineZombie> pipeline_zombies = {};
+    ZombieQueue<TimelineQueryPoolZombie> timeline_query_pool_zombies = {};
+    ZombieQueue<MemoryBlockZombie> memory_block_zombies = {};
+
+    // Background garbage collection, only started when info.background_garbage_collection_interval_ms is not 0:
+    std::thread background_gc_thread = {};
+    std::mutex background_gc_mtx = {};
+    std::condition_variable background_gc_cv = {};
+    bool background_gc_stop = {};
 
     // Queues
     struct ImplQueue
@@ -161,12 +248,35 @@ struct daxa_ImplDevice final : public ImplHandle
     auto slot(daxa_TlasId id) const -> ImplTlasSlot const &;
     auto slot(daxa_BlasId id) const -> ImplBlasSlot const &;
 
-    void cleanup_buffer(BufferId id);
-    void cleanup_image(ImageId id);
-    void cleanup_image_view(ImageViewId id);
-    void cleanup_sampler(SamplerId id);
-    void cleanup_tlas(TlasId id);
-    void cleanup_blas(BlasId id);
+    auto cold_slot(daxa_BufferId id) const -> ImplBufferColdSlot const &;
+    auto cold_slot(daxa_ImageId id) const -> ImplImageColdSlot const &;
+    auto cold_slot(daxa_ImageViewId id) const -> ImplImageViewColdSlot const &;
+    auto cold_slot(daxa_SamplerId id) const -> ImplSamplerColdSlot const &;
+    auto cold_slot(daxa_TlasId id) const -> ImplTlasColdSlot const &;
+    auto cold_slot(daxa_BlasId id) const -> ImplBlasColdSlot const &;
+
+    // Vulkan objects of a gpu resource whose slot was already recycled.
+    // They are destroyed after the exclusive lifetime lock is released again.
+    struct DetachedResource
+    {
+        VkBuffer vk_buffer = {};
+        VkImage vk_image = {};
+        VkImageView vk_image_view = {};
+        VkSampler vk_sampler = {};
+        VkAccelerationStructureKHR vk_acceleration_structure = {};
+        VmaAllocation vma_allocation = {};
+    };
+
+    // Recycle the slot of a zombie, returns the vulkan objects that still need to be destroyed.
+    // Must be called with the exclusive lifetime lock held.
+    auto cleanup_buffer(BufferId id) -> DetachedResource;
+    auto cleanup_image(ImageId id) -> DetachedResource;
+    auto cleanup_image_view(ImageViewId id) -> DetachedResource;
+    auto cleanup_sampler(SamplerId id) -> DetachedResource;
+    auto cleanup_tlas(TlasId id) -> DetachedResource;
+    auto cleanup_blas(BlasId id) -> DetachedResource;
+    void destroy_detached_resource(DetachedResource const & resource);
+    void background_garbage_collection_loop();
 
     void zombify_buffer(BufferId id);
     void zombify_image(ImageId id);
@@ -174,6 +284,10 @@ struct daxa_ImplDevice final : public ImplHandle
     void zombify_sampler(SamplerId id);
     void zombify_tlas(TlasId id);
     void zombify_blas(BlasId id);
+    void zombify_buffers(std::span<BufferId const> ids);
+    void zombify_images(std::span<ImageId const> ids);
+    void zombify_image_views(std::span<ImageViewId const> ids);
+    void zombify_samplers(std::span<SamplerId const> ids);
 
     static auto create_2(daxa_Instance instance, daxa_DeviceInfo2 const& info, ImplPhysicalDevice const & physical_device, daxa_DeviceProperties const & properties, daxa_Device device) -> daxa_Result;
     static auto create(daxa_Instance instance, daxa_DeviceInfo const & info, VkPhysicalDevice physical_device, daxa_Device device) -> daxa_Result;
@@ -338,24 +338,26 @@ namespace daxa
             {
                 if (page)
                 {
-                    for (auto & slot : *page)
+                    using HotT = typename std::remove_cvref_t<decltype(page->hot)>::value_type;
+                    for (usize i = 0; i < page->hot.size(); ++i)
                     {
+                        auto const & hot = page->hot[i];
                         bool handle_invalid = {};
-                        if constexpr (std::is_same_v<decltype(slot.first), ImplBufferSlot>)
+                        if constexpr (std::is_same_v<HotT, ImplBufferSlot>)
                         {
-                            handle_invalid = slot.first.vk_buffer == VK_NULL_HANDLE;
+                            handle_invalid = hot.vk_buffer == VK_NULL_HANDLE;
                         }
-                        if constexpr (std::is_same_v<decltype(slot.first), ImplImageSlot>)
+                        if constexpr (std::is_same_v<HotT, ImplImageSlot>)
                         {
-                            handle_invalid = slot.first.vk_image == VK_NULL_HANDLE;
+                            handle_invalid = hot.vk_image == VK_NULL_HANDLE;
                         }
-                        if constexpr (std::is_same_v<decltype(slot.first), ImplSamplerSlot>)
+                        if constexpr (std::is_same_v<HotT, ImplSamplerSlot>)
                         {
-                            handle_invalid = slot.first.vk_sampler == VK_NULL_HANDLE;
+                            handle_invalid = hot.vk_sampler == VK_NULL_HANDLE;
                         }
                         if (!handle_invalid)
                         {
-                            ret += fmt::format("debug name : \"{}\"", r_cast<SmallString const *>(&slot.first.info.name)->view());
+                            ret += fmt::format("debug name : \"{}\"", r_cast<SmallString const *>(&page->cold[i].info.name)->view());
                             ret += "\n";
                         }
                     }
@@ -363,9 +365,9 @@ namespace daxa
             }
             return ret;
         };
-        DAXA_DBG_ASSERT_TRUE_M(buffer_slots.free_index_stack.size() == buffer_slots.next_index, print_remaining("Detected leaked buffers; not all buffers have been destroyed before destroying the device;", buffer_slots.pages));
-        DAXA_DBG_ASSERT_TRUE_M(image_slots.free_index_stack.size() == image_slots.next_index, print_remaining("Detected leaked images; not all images have been destroyed before destroying the device;", image_slots.pages));
-        DAXA_DBG_ASSERT_TRUE_M(sampler_slots.free_index_stack.size() == sampler_slots.next_index, print_remaining("Detected leaked samplers; not all samplers have been destroyed before destroying the device;", sampler_slots.pages));
+        DAXA_DBG_ASSERT_TRUE_M(buffer_slots.free_index_count() == buffer_slots.next_index.load(std::memory_order_relaxed), print_remaining("Detected leaked buffers; not all buffers have been destroyed before destroying the device;", buffer_slots.pages));
+        DAXA_DBG_ASSERT_TRUE_M(image_slots.free_index_count() == image_slots.next_index.load(std::memory_order_relaxed), print_remaining("Detected leaked images; not all images have been destroyed before destroying the device;", image_slots.pages));
+        DAXA_DBG_ASSERT_TRUE_M(sampler_slots.free_index_count() == sampler_slots.next_index.load(std::memory_order_relaxed), print_remaining("Detected leaked samplers; not all samplers have been destroyed before destroying the device;", sampler_slots.pages));
         for (usize i = 0; i < PIPELINE_LAYOUT_COUNT; ++i)
         {
             vkDestroyPipelineLayout(device, pipeline_layouts.at(i), nullptr);
@@ -375,132 +377,173 @@ namespace daxa
         vkDestroyDescriptorPool(device, this->vk_descriptor_pool, nullptr);
     }
 
-    void write_descriptor_set_sampler(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkSampler vk_sampler, u32 index)
+    void GPUShaderResourceTable::queue_descriptor_write(ImplDescriptorWrite const & write)
     {
-        VkDescriptorImageInfo const vk_descriptor_image_info{
-            .sampler = vk_sampler,
-            .imageView = VK_NULL_HANDLE,
-            .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-        };
-
-        VkWriteDescriptorSet const vk_write_descriptor_set_storage{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_SAMPLER_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
-            .pImageInfo = &vk_descriptor_image_info,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
-        };
-
-        vkUpdateDescriptorSets(vk_device, 1, &vk_write_descriptor_set_storage, 0, nullptr);
+        this->queue_descriptor_writes(std::span{&write, 1});
     }
 
-    void write_descriptor_set_buffer(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkBuffer vk_buffer, VkDeviceSize offset, VkDeviceSize range, u32 index)
+    void GPUShaderResourceTable::queue_descriptor_writes(std::span<ImplDescriptorWrite const> writes)
     {
-        VkDescriptorBufferInfo const vk_descriptor_image_info{
-            .buffer = vk_buffer,
-            .offset = offset,
-            .range = range,
-        };
-
-        VkWriteDescriptorSet const vk_write_descriptor_set{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_STORAGE_BUFFER_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-            .pImageInfo = nullptr,
-            .pBufferInfo = &vk_descriptor_image_info,
-            .pTexelBufferView = nullptr,
-        };
+        if (writes.empty())
+        {
+            return;
+        }
+        std::unique_lock const lock{this->descriptor_write_mtx};
+        for (auto const & write : writes)
+        {
+            u64 const key = (static_cast<u64>(write.binding) << 32) | static_cast<u64>(write.index);
+            auto const [iter, inserted] = this->pending_descriptor_write_lookup.try_emplace(key, static_cast<u32>(this->pending_descriptor_writes.size()));
+            if (inserted)
+            {
+                this->pending_descriptor_writes.push_back(write);
+            }
+            else
+            {
+                // The queued write was never visible to the gpu, it can simply be replaced.
+                this->pending_descriptor_writes[iter->second] = write;
+                this->descriptor_write_statistics.replaced_write_count += 1;
+            }
+        }
+        this->pending_descriptor_write_count.store(static_cast<u32>(this->pending_descriptor_writes.size()), std::memory_order_release);
+    }
 
-        vkUpdateDescriptorSets(vk_device, 1, &vk_write_descriptor_set, 0, nullptr);
+    void GPUShaderResourceTable::flush_descriptor_writes(VkDevice device)
+    {
+        if (this->pending_descriptor_write_count.load(std::memory_order_acquire) == 0)
+        {
+            return;
+        }
+        std::unique_lock const lock{this->descriptor_write_mtx};
+        if (this->pending_descriptor_writes.empty())
+        {
+            return;
+        }
+        this->flush_vk_writes.clear();
+        this->flush_vk_as_writes.clear();
+        // The pointers into flush_vk_as_writes must stay stable while filling flush_vk_writes.
+        this->flush_vk_as_writes.reserve(this->pending_descriptor_writes.size());
+        for (auto const & write : this->pending_descriptor_writes)
+        {
+            VkWriteDescriptorSet vk_write{
+                .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                .pNext = nullptr,
+                .dstSet = this->vk_descriptor_set,
+                .dstBinding = write.binding,
+                .dstArrayElement = write.index,
+                .descriptorCount = 1,
+                .descriptorType = write.type,
+                .pImageInfo = nullptr,
+                .pBufferInfo = nullptr,
+                .pTexelBufferView = nullptr,
+            };
+            switch (write.type)
+            {
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                vk_write.pBufferInfo = &write.buffer_info;
+                break;
+            case VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR:
+                this->flush_vk_as_writes.push_back(VkWriteDescriptorSetAccelerationStructureKHR{
+                    .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR,
+                    .pNext = nullptr,
+                    .accelerationStructureCount = 1,
+                    .pAccelerationStructures = &write.acceleration_structure,
+                });
+                vk_write.pNext = &this->flush_vk_as_writes.back();
+                break;
+            default:
+                vk_write.pImageInfo = &write.image_info;
+                break;
+            }
+            this->flush_vk_writes.push_back(vk_write);
+        }
+        vkUpdateDescriptorSets(device, static_cast<u32>(this->flush_vk_writes.size()), this->flush_vk_writes.data(), 0, nullptr);
+
+        auto & statistics = this->descriptor_write_statistics;
+        statistics.flush_count += 1;
+        statistics.flushed_write_count += this->flush_vk_writes.size();
+        statistics.last_flush_write_count = this->flush_vk_writes.size();
+        this->pending_descriptor_writes.clear();
+        this->pending_descriptor_write_lookup.clear();
+        this->pending_descriptor_write_count.store(0, std::memory_order_release);
     }
 
-    void write_descriptor_set_image(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkImageView vk_image_view, ImageUsageFlags usage, u32 index)
+    static void queue_or_batch(GPUShaderResourceTable & table, std::vector<ImplDescriptorWrite> * opt_batch, ImplDescriptorWrite const & write)
     {
-        u32 descriptor_set_write_count = 0;
-        std::array<VkWriteDescriptorSet, 2> descriptor_set_writes = {};
+        if (opt_batch != nullptr)
+        {
+            opt_batch->push_back(write);
+        }
+        else
+        {
+            table.queue_descriptor_write(write);
+        }
+    }
 
-        VkDescriptorImageInfo const vk_descriptor_image_info{
-            .sampler = VK_NULL_HANDLE,
-            .imageView = vk_image_view,
-            .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
-        };
+    void write_descriptor_set_sampler(GPUShaderResourceTable & table, VkSampler vk_sampler, u32 index, std::vector<ImplDescriptorWrite> * opt_batch)
+    {
+        queue_or_batch(table, opt_batch, ImplDescriptorWrite{
+            .binding = DAXA_SAMPLER_BINDING,
+            .index = index,
+            .type = VK_DESCRIPTOR_TYPE_SAMPLER,
+            .image_info = {
+                .sampler = vk_sampler,
+                .imageView = VK_NULL_HANDLE,
+                .imageLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+            },
+        });
+    }
 
-        VkWriteDescriptorSet const vk_write_descriptor_set{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_STORAGE_IMAGE_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-            .pImageInfo = &vk_descriptor_image_info,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
-        };
+    void write_descriptor_set_buffer(GPUShaderResourceTable & table, VkBuffer vk_buffer, VkDeviceSize offset, VkDeviceSize range, u32 index, std::vector<ImplDescriptorWrite> * opt_batch)
+    {
+        queue_or_batch(table, opt_batch, ImplDescriptorWrite{
+            .binding = DAXA_STORAGE_BUFFER_BINDING,
+            .index = index,
+            .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .buffer_info = {
+                .buffer = vk_buffer,
+                .offset = offset,
+                .range = range,
+            },
+        });
+    }
 
+    void write_descriptor_set_image(GPUShaderResourceTable & table, VkImageView vk_image_view, ImageUsageFlags usage, u32 index, std::vector<ImplDescriptorWrite> * opt_batch)
+    {
         if ((usage & ImageUsageFlagBits::SHADER_STORAGE) != ImageUsageFlagBits::NONE)
         {
-            descriptor_set_writes.at(descriptor_set_write_count++) = vk_write_descriptor_set;
+            queue_or_batch(table, opt_batch, ImplDescriptorWrite{
+                .binding = DAXA_STORAGE_IMAGE_BINDING,
+                .index = index,
+                .type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                .image_info = {
+                    .sampler = VK_NULL_HANDLE,
+                    .imageView = vk_image_view,
+                    .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
+                },
+            });
         }
-
-        VkDescriptorImageInfo const vk_descriptor_image_info_sampled{
-            .sampler = VK_NULL_HANDLE,
-            .imageView = vk_image_view,
-            .imageLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL,
-        };
-
-        VkWriteDescriptorSet const vk_write_descriptor_set_sampled{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = nullptr,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_SAMPLED_IMAGE_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
-            .pImageInfo = &vk_descriptor_image_info_sampled,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
-        };
-
         if ((usage & ImageUsageFlagBits::SHADER_SAMPLED) != ImageUsageFlagBits::NONE)
         {
-            descriptor_set_writes.at(descriptor_set_write_count++) = vk_write_descriptor_set_sampled;
+            queue_or_batch(table, opt_batch, ImplDescriptorWrite{
+                .binding = DAXA_SAMPLED_IMAGE_BINDING,
+                .index = index,
+                .type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+                .image_info = {
+                    .sampler = VK_NULL_HANDLE,
+                    .imageView = vk_image_view,
+                    .imageLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL,
+                },
+            });
         }
-
-        vkUpdateDescriptorSets(vk_device, descriptor_set_write_count, descriptor_set_writes.data(), 0, nullptr);
     }
 
-    void write_descriptor_set_acceleration_structure(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkAccelerationStructureKHR vk_acceleration_structure, u32 index)
+    void write_descriptor_set_acceleration_structure(GPUShaderResourceTable & table, VkAccelerationStructureKHR vk_acceleration_structure, u32 index, std::vector<ImplDescriptorWrite> * opt_batch)
     {
-        VkWriteDescriptorSetAccelerationStructureKHR vk_write_descriptor_set_as = {
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR,
-            .pNext = nullptr,
-            .accelerationStructureCount = 1,
-            .pAccelerationStructures = &vk_acceleration_structure,
-        };
-
-        VkWriteDescriptorSet const vk_write_descriptor_set{
-            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .pNext = &vk_write_descriptor_set_as,
-            .dstSet = vk_descriptor_set,
-            .dstBinding = DAXA_ACCELERATION_STRUCTURE_BINDING,
-            .dstArrayElement = index,
-            .descriptorCount = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
-            .pImageInfo = nullptr,
-            .pBufferInfo = nullptr,
-            .pTexelBufferView = nullptr,
-        };
-
-        vkUpdateDescriptorSets(vk_device, 1, &vk_write_descriptor_set, 0, nullptr);
+        queue_or_batch(table, opt_batch, ImplDescriptorWrite{
+            .binding = DAXA_ACCELERATION_STRUCTURE_BINDING,
+            .index = index,
+            .type = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+            .acceleration_structure = vk_acceleration_structure,
+        });
     }
 } // namespace daxa
@@ -5,63 +5,93 @@
 #include <daxa/gpu_resources.hpp>
 
 #include <atomic>
+#include <tuple>
 
 namespace daxa
 {
+    // Resource slots are split into hot and cold data.
+    // Hot data is read when recording commands and resolving ids (vulkan handles, addresses).
+    // Cold data is only needed on creation, destruction and info queries (infos, debug names, allocations).
+
     struct ImplBufferSlot
     {
-        daxa_BufferInfo info = {};
         VkBuffer vk_buffer = {};
-        VmaAllocation vma_allocation = {};
-        daxa_MemoryBlock opt_memory_block = {};
         VkDeviceAddress device_address = {};
         void * host_address = {};
     };
 
+    struct ImplBufferColdSlot
+    {
+        daxa_BufferInfo info = {};
+        VmaAllocation vma_allocation = {};
+        daxa_MemoryBlock opt_memory_block = {};
+    };
+
     static inline constexpr i32 NOT_OWNED_BY_SWAPCHAIN = -1;
 
     struct ImplImageViewSlot
     {
-        daxa_ImageViewInfo info = {};
         VkImageView vk_image_view = {};
     };
 
+    struct ImplImageViewColdSlot
+    {
+        daxa_ImageViewInfo info = {};
+    };
+
     struct ImplImageSlot
     {
         ImplImageViewSlot view_slot = {};
-        daxa_ImageInfo info = {};
         VkImage vk_image = {};
+        VkImageAspectFlags aspect_flags = {}; // Inferred from format.
+    };
+
+    struct ImplImageColdSlot
+    {
+        ImplImageViewColdSlot view_slot = {};
+        daxa_ImageInfo info = {};
         VmaAllocation vma_allocation = {};
         daxa_MemoryBlock opt_memory_block = {};
         i32 swapchain_image_index = NOT_OWNED_BY_SWAPCHAIN;
-        VkImageAspectFlags aspect_flags = {}; // Inferred from format.
     };
 
     struct ImplSamplerSlot
     {
-        daxa_SamplerInfo info = {};
         VkSampler vk_sampler = {};
     };
 
+    struct ImplSamplerColdSlot
+    {
+        daxa_SamplerInfo info = {};
+    };
+
     struct ImplTlasSlot
     {
-        daxa_TlasInfo info = {};
         VkAccelerationStructureKHR vk_acceleration_structure = {};
+        VkDeviceAddress device_address = {};
+    };
+
+    struct ImplTlasColdSlot
+    {
+        daxa_TlasInfo info = {};
         VkBuffer vk_buffer = {};
         BufferId buffer_id = {};
         u64 offset = {};
-        VkDeviceAddress device_address = {};
         bool owns_buffer = {};
     };
 
     struct ImplBlasSlot
     {
-        daxa_BlasInfo info = {};
         VkAccelerationStructureKHR vk_acceleration_structure = {};
+        VkDeviceAddress device_address = {};
+    };
+
+    struct ImplBlasColdSlot
+    {
+        daxa_BlasInfo info = {};
         VkBuffer vk_buffer = {};
         BufferId buffer_id = {};
         u64 offset = {};
-        VkDeviceAddress device_address = {};
         bool owns_buffer = {};
     };
 
@@ -76,7 +106,7 @@ namespace daxa
      * To check if these assumptions are met at runtime, the debug define DAXA_GPU_ID_VALIDATION can be enabled.
      * The define enables runtime checking to detect use after free and double free at the cost of performance.
      */
-    template <typename ResourceT>
+    template <typename HotT, typename ColdT>
     struct GpuResourcePool
     {
         static constexpr inline usize MAX_RESOURCE_COUNT = 1u << 20u;
@@ -85,19 +115,82 @@ namespace daxa
         static constexpr inline usize PAGE_MASK = PAGE_SIZE - 1u;
         static constexpr inline usize PAGE_COUNT = MAX_RESOURCE_COUNT / PAGE_SIZE;
         using VersionAndRefcntT = std::atomic_uint64_t;
-        // TODO: split up slots into hot and cold data.
-        using PageT = std::array<std::pair<ResourceT, VersionAndRefcntT>, PAGE_SIZE>;
+        // Versions, hot and cold slot data live in separate arrays.
+        // Id validation only touches the versions, handle lookups only the hot data.
+        struct PageT
+        {
+            alignas(64) std::array<VersionAndRefcntT, PAGE_SIZE> versions = {};
+            alignas(64) std::array<HotT, PAGE_SIZE> hot = {};
+            alignas(64) std::array<ColdT, PAGE_SIZE> cold = {};
+        };
+        // Each free slot stores the free list link to the next free slot (index + 1, 0 marks the end of the list).
+        using FreeListPageT = std::array<std::atomic_uint32_t, PAGE_SIZE>;
 
-        // TODO: replace with lockless queue.
-        std::vector<u32> free_index_stack = {};
-        u32 next_index = {};
+        // Lockless free list of recycled slot indices.
+        // The head packs a 32 bit tag in the upper and the (index + 1) of the top free slot in the lower bits.
+        // Every push and pop increments the tag, which prevents ABA problems when racing pops and pushes.
+        static constexpr inline u64 FREE_LIST_INDEX_MASK = (1ull << 32ull) - 1ull;
+        static constexpr inline u64 FREE_LIST_TAG_INCREMENT = 1ull << 32ull;
+        std::atomic_uint64_t free_list_head = {};
+        std::atomic_uint32_t next_index = {};
         u32 max_resources = {};
 
-        mutable std::mutex mut = {};
         std::mutex page_alloc_mtx = {};
         std::array<std::unique_ptr<PageT>, PAGE_COUNT> pages = {};
+        std::array<std::unique_ptr<FreeListPageT>, PAGE_COUNT> free_list_pages = {};
         std::atomic_uint32_t valid_page_count = {};
 
+        auto free_list_link(u32 index) -> std::atomic_uint32_t &
+        {
+            return (*this->free_list_pages[static_cast<usize>(index) >> PAGE_BITS])[static_cast<usize>(index) & PAGE_MASK];
+        }
+
+        void push_free_index(u32 index)
+        {
+            u64 head = this->free_list_head.load(std::memory_order_relaxed);
+            u64 new_head = {};
+            do
+            {
+                this->free_list_link(index).store(static_cast<u32>(head & FREE_LIST_INDEX_MASK), std::memory_order_relaxed);
+                new_head = ((head & ~FREE_LIST_INDEX_MASK) + FREE_LIST_TAG_INCREMENT) | (static_cast<u64>(index) + 1ull);
+            } while (!this->free_list_head.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        auto try_pop_free_index() -> std::optional<u32>
+        {
+            u64 head = this->free_list_head.load(std::memory_order_acquire);
+            while ((head & FREE_LIST_INDEX_MASK) != 0)
+            {
+                u32 const index = static_cast<u32>(head & FREE_LIST_INDEX_MASK) - 1u;
+                // The link may be stale when another thread popped the index in the meantime.
+                // In that case the tag of the head changed and the cas fails.
+                u64 const next = this->free_list_link(index).load(std::memory_order_relaxed);
+                u64 const new_head = ((head & ~FREE_LIST_INDEX_MASK) + FREE_LIST_TAG_INCREMENT) | next;
+                if (this->free_list_head.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+                {
+                    return index;
+                }
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief   Counts the slots currently in the free list.
+         *
+         * NOT threadsafe, only intended for leak detection on device destruction.
+         */
+        auto free_index_count() -> u32
+        {
+            u32 count = 0;
+            u64 link = this->free_list_head.load(std::memory_order_acquire) & FREE_LIST_INDEX_MASK;
+            while (link != 0)
+            {
+                ++count;
+                link = this->free_list_link(static_cast<u32>(link - 1)).load(std::memory_order_relaxed);
+            }
+            return count;
+        }
+
         /**
          * @brief   Destroys a slot.
          *          After calling this function, the id of the slot will be forever invalid.
@@ -111,15 +204,15 @@ namespace daxa
         {
             auto const page = static_cast<usize>(id.index) >> PAGE_BITS;
             auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
-            auto const version = this->pages[page]->at(offset).second.load(std::memory_order_relaxed);
+            auto const version = this->pages[page]->versions[offset].load(std::memory_order_relaxed);
             // Slots that reached max version CAN NOT be recycled.
             // That is because we can not guarantee uniqueness of ids when the version wraps back to 0.
             // Clear slot MUST HAPPEN before pushing into free list.
-            this->pages[page]->at(offset).first = {};
+            this->pages[page]->hot[offset] = {};
+            this->pages[page]->cold[offset] = {};
             if (version != DAXA_ID_VERSION_MASK /* this is the maximum value a version is allowed to reach */)
             {
-                std::unique_lock l{mut};
-                this->free_index_stack.push_back(id.index);
+                this->push_free_index(static_cast<u32>(id.index));
             }
         }
 
@@ -127,29 +220,27 @@ namespace daxa
          * @brief   Creates a slot for a resource in the pool.
          *          Returned slots may be recycled but are guaranteed to have a unique index + version.
          *
-         * Must
-         * * mutable ptr to resource is only used in parallel
+         * Always threadsafe, never takes a lock unless a new page must be allocated.
          *
-         * @return The new resource slot and its id. Can fail if max resources is exceeded.
+         * @return The id, hot and cold data of the new resource slot. Can fail if max resources is exceeded.
          */
-        auto try_create_slot() -> std::optional<std::pair<GPUResourceId, ResourceT &>>
+        auto try_create_slot() -> std::optional<std::tuple<GPUResourceId, HotT &, ColdT &>>
         {
-            u32 index;
+            u32 index = {};
+            if (auto recycled_index = this->try_pop_free_index(); recycled_index.has_value())
+            {
+                index = recycled_index.value();
+            }
+            else
             {
-                std::unique_lock l{mut};
-                if (this->free_index_stack.empty())
+                index = this->next_index.load(std::memory_order_relaxed);
+                do
                 {
-                    index = this->next_index++;
                     if (index >= this->max_resources || index >= MAX_RESOURCE_COUNT)
                     {
                         return std::nullopt;
                     }
-                }
-                else
-                {
-                    index = this->free_index_stack.back();
-                    this->free_index_stack.pop_back();
-                }
+                } while (!this->next_index.compare_exchange_weak(index, index + 1, std::memory_order_relaxed, std::memory_order_relaxed));
             }
 
             auto const page = static_cast<usize>(index) >> PAGE_BITS;
@@ -158,21 +249,24 @@ namespace daxa
             if (page >= this->valid_page_count.load(std::memory_order_seq_cst))
             {
                 std::unique_lock l{page_alloc_mtx};
-                if (page >= this->valid_page_count.load(std::memory_order_relaxed))
+                // Pages are allocated in order, a thread may need to allocate pages of other threads that have not yet done so.
+                while (page >= this->valid_page_count.load(std::memory_order_relaxed))
                 {
-                    this->pages[page] = std::make_unique<PageT>();
+                    auto const new_page = this->valid_page_count.load(std::memory_order_relaxed);
+                    this->pages[new_page] = std::make_unique<PageT>();
+                    this->free_list_pages[new_page] = std::make_unique<FreeListPageT>();
                     for (u32 i = 0; i < PAGE_SIZE; ++i)
                     {
-                        this->pages[page]->at(i).second.store(1ull, std::memory_order_relaxed);
+                        this->pages[new_page]->versions[i].store(1ull, std::memory_order_relaxed);
                     }
                     // Needs to be sequential, so that the 0 writes to the versions are visible before the atomic op.
                     this->valid_page_count.fetch_add(1, std::memory_order_seq_cst);
                 }
             }
-            u64 version = this->pages[page]->at(offset).second.load(std::memory_order_relaxed);
+            u64 version = this->pages[page]->versions[offset].load(std::memory_order_relaxed);
 
             auto const id = GPUResourceId{.index = static_cast<u64>(index), .version = version};
-            return std::optional{std::pair<GPUResourceId, ResourceT &>(id, this->pages[page]->at(offset).first)};
+            return std::optional{std::tuple<GPUResourceId, HotT &, ColdT &>(id, this->pages[page]->hot[offset], this->pages[page]->cold[offset])};
         }
 
         auto try_zombify(GPUResourceId id) -> bool
@@ -185,7 +279,7 @@ namespace daxa
             auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
             u64 version = id.version;
             u64 const new_version = version + 1;
-            return (*this->pages[page])[offset].second.compare_exchange_strong(
+            return this->pages[page]->versions[offset].compare_exchange_strong(
                 version, new_version,
                 std::memory_order_relaxed,
                 std::memory_order_relaxed);
@@ -205,7 +299,7 @@ namespace daxa
             {
                 return false;
             }
-            u64 const slot_version = (*this->pages[page])[offset].second.load(std::memory_order_relaxed);
+            u64 const slot_version = this->pages[page]->versions[offset].load(std::memory_order_relaxed);
             return slot_version == id.version;
         }
 
@@ -218,25 +312,46 @@ namespace daxa
          *
          * @returns resource.
          */
-        auto unsafe_get(GPUResourceId id) const -> ResourceT const &
+        auto unsafe_get(GPUResourceId id) const -> HotT const &
         {
             auto page = static_cast<usize>(id.index) >> PAGE_BITS;
             // Even in an unsafe read we never want to read memory we do not own!
             // Clamp so we get some random slot in error case but never invalid memory!
             page = std::min(static_cast<usize>(this->valid_page_count.load(std::memory_order_relaxed)) - 1, page);
             auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
-            return pages[page]->at(offset).first;
+            return pages[page]->hot[offset];
+        }
+
+        /**
+         * @brief   Same as unsafe_get but returns the cold data of the slot (infos, allocations).
+         */
+        auto unsafe_get_cold(GPUResourceId id) const -> ColdT const &
+        {
+            auto page = static_cast<usize>(id.index) >> PAGE_BITS;
+            page = std::min(static_cast<usize>(this->valid_page_count.load(std::memory_order_relaxed)) - 1, page);
+            auto const offset = static_cast<usize>(id.index) & PAGE_MASK;
+            return pages[page]->cold[offset];
         }
     };
 
+    struct ImplDescriptorWrite
+    {
+        u32 binding = {};
+        u32 index = {};
+        VkDescriptorType type = {};
+        VkDescriptorImageInfo image_info = {};
+        VkDescriptorBufferInfo buffer_info = {};
+        VkAccelerationStructureKHR acceleration_structure = {};
+    };
+
     struct GPUShaderResourceTable
     {
         std::shared_mutex lifetime_lock = {};
-        GpuResourcePool<ImplBufferSlot> buffer_slots = {};
-        GpuResourcePool<ImplImageSlot> image_slots = {};
-        GpuResourcePool<ImplSamplerSlot> sampler_slots = {};
-        GpuResourcePool<ImplTlasSlot> tlas_slots = {};
-        GpuResourcePool<ImplBlasSlot> blas_slots = {};
+        GpuResourcePool<ImplBufferSlot, ImplBufferColdSlot> buffer_slots = {};
+        GpuResourcePool<ImplImageSlot, ImplImageColdSlot> image_slots = {};
+        GpuResourcePool<ImplSamplerSlot, ImplSamplerColdSlot> sampler_slots = {};
+        GpuResourcePool<ImplTlasSlot, ImplTlasColdSlot> tlas_slots = {};
+        GpuResourcePool<ImplBlasSlot, ImplBlasColdSlot> blas_slots = {};
 
         VkDescriptorSetLayout vk_descriptor_set_layout = {};
         VkDescriptorSet vk_descriptor_set = {};
@@ -246,6 +361,17 @@ namespace daxa
         // The first size is 0 word, second is 1 word, all others are a power of two (maximum is MAX_PUSH_CONSTANT_BYTE_SIZE).
         std::array<VkPipelineLayout, PIPELINE_LAYOUT_COUNT> pipeline_layouts = {};
 
+        // Descriptor writes are not issued immediately.
+        // They are queued and flushed in a single vkUpdateDescriptorSets call before the next submit.
+        // A later write to the same binding and array element replaces the queued one.
+        std::mutex descriptor_write_mtx = {};
+        std::atomic_uint32_t pending_descriptor_write_count = {};
+        std::vector<ImplDescriptorWrite> pending_descriptor_writes = {};
+        std::unordered_map<u64, u32> pending_descriptor_write_lookup = {};
+        std::vector<VkWriteDescriptorSet> flush_vk_writes = {};
+        std::vector<VkWriteDescriptorSetAccelerationStructureKHR> flush_vk_as_writes = {};
+        daxa_DescriptorWriteStatistics descriptor_write_statistics = {};
+
         auto initialize(
             u32 max_buffers, 
             u32 max_images, 
@@ -255,13 +381,21 @@ namespace daxa
             VkBuffer device_address_buffer, 
             PFN_vkSetDebugUtilsObjectNameEXT vkSetDebugUtilsObjectNameEXT) -> daxa_Result;
         void cleanup(VkDevice device);
+
+        void queue_descriptor_write(ImplDescriptorWrite const & write);
+        void queue_descriptor_writes(std::span<ImplDescriptorWrite const> writes);
+        // Threadsafe. Returns immediately when there are no queued writes.
+        void flush_descriptor_writes(VkDevice device);
     };
 
-    void write_descriptor_set_sampler(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkSampler vk_sampler, u32 index);
+    // All descriptor write functions only queue the write, see GPUShaderResourceTable::flush_descriptor_writes.
+    // When opt_batch is set, the writes are appended to it instead so that the caller can queue them all at once.
+
+    void write_descriptor_set_sampler(GPUShaderResourceTable & table, VkSampler vk_sampler, u32 index, std::vector<ImplDescriptorWrite> * opt_batch = nullptr);
 
-    void write_descriptor_set_buffer(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkBuffer vk_buffer, VkDeviceSize offset, VkDeviceSize range, u32 index);
+    void write_descriptor_set_buffer(GPUShaderResourceTable & table, VkBuffer vk_buffer, VkDeviceSize offset, VkDeviceSize range, u32 index, std::vector<ImplDescriptorWrite> * opt_batch = nullptr);
 
-    void write_descriptor_set_image(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkImageView vk_image_view, ImageUsageFlags usage, u32 index);
+    void write_descriptor_set_image(GPUShaderResourceTable & table, VkImageView vk_image_view, ImageUsageFlags usage, u32 index, std::vector<ImplDescriptorWrite> * opt_batch = nullptr);
 
-    void write_descriptor_set_acceleration_structure(VkDevice vk_device, VkDescriptorSet vk_descriptor_set, VkAccelerationStructureKHR vk_acceleration_structure, u32 index);
+    void write_descriptor_set_acceleration_structure(GPUShaderResourceTable & table, VkAccelerationStructureKHR vk_acceleration_structure, u32 index, std::vector<ImplDescriptorWrite> * opt_batch = nullptr);
 } // namespace daxa
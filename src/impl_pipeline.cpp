@@ -1,315 +1,498 @@
 #include "impl_device.hpp"
 #include "impl_pipeline.hpp"
 
-// --- Begin API Functions ---
+#include <thread>
 
-auto daxa_dvc_create_raster_pipeline(daxa_Device device, daxa_RasterPipelineInfo const * info, daxa_RasterPipeline * out_pipeline) -> daxa_Result
+namespace
 {
-    _DAXA_TEST_PRINT("daxa_dvc_create_raster_pipeline\n");
-    daxa_ImplRasterPipeline ret = {};
-    ret.device = device;
-    ret.info = *reinterpret_cast<RasterPipelineInfo const *>(info);
-    std::vector<VkShaderModule> vk_shader_modules = {};
-    // NOTE: Temporarily holds 0 terminated strings, incoming strings are data + size, not null terminated!
-    std::vector<std::unique_ptr<std::string>> entry_point_names = {};
-    std::vector<VkPipelineShaderStageCreateInfo> vk_pipeline_shader_stage_create_infos = {};
+    constexpr VkViewport DEFAULT_VIEWPORT{.x = 0, .y = 0, .width = 1, .height = 1, .minDepth = 0, .maxDepth = 0};
+    constexpr VkRect2D DEFAULT_SCISSOR{.offset = {0, 0}, .extent = {1, 1}};
+    constexpr VkPipelineVertexInputStateCreateInfo EMPTY_VERTEX_INPUT_STATE{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = {},
+        .vertexBindingDescriptionCount = 0,
+        .pVertexBindingDescriptions = nullptr,
+        .vertexAttributeDescriptionCount = 0,
+        .pVertexAttributeDescriptions = nullptr,
+    };
 
-    std::vector<VkPipelineShaderStageRequiredSubgroupSizeCreateInfo> require_subgroup_size_vkstructs = {};
-    // Necessary to prevent re-allocation
-    auto const MAXIMUM_GRAPHICS_STAGES = 6;
-    require_subgroup_size_vkstructs.reserve(MAXIMUM_GRAPHICS_STAGES);
+    // Holds all vulkan structs needed to create one raster pipeline.
+    // The create info points into the state itself, so the state must not move between init and pipeline creation.
+    struct RasterPipelineCreateState
+    {
+        std::vector<VkShaderModule> vk_shader_modules = {};
+        // NOTE: Temporarily holds 0 terminated strings, incoming strings are data + size, not null terminated!
+        std::vector<std::unique_ptr<std::string>> entry_point_names = {};
+        std::vector<VkPipelineShaderStageCreateInfo> vk_pipeline_shader_stage_create_infos = {};
+        std::vector<VkPipelineShaderStageRequiredSubgroupSizeCreateInfo> require_subgroup_size_vkstructs = {};
+        VkPipelineInputAssemblyStateCreateInfo vk_input_assembly_state = {};
+        VkPipelineTessellationDomainOriginStateCreateInfo vk_tesselation_domain_origin_state = {};
+        VkPipelineTessellationStateCreateInfo vk_tesselation_state = {};
+        VkPipelineMultisampleStateCreateInfo vk_multisample_state = {};
+        VkPipelineRasterizationStateCreateInfo vk_raster_state = {};
+        VkPipelineRasterizationConservativeStateCreateInfoEXT vk_conservative_raster_state = {};
+        VkPipelineDepthStencilStateCreateInfo vk_depth_stencil_state = {};
+        std::array<VkPipelineColorBlendAttachmentState, pipeline_manager_MAX_ATTACHMENTS> vk_pipeline_color_blend_attachment_blend_states = {};
+        std::array<VkFormat, pipeline_manager_MAX_ATTACHMENTS> vk_pipeline_color_attachment_formats = {};
+        VkPipelineColorBlendStateCreateInfo vk_color_blend_state = {};
+        VkPipelineViewportStateCreateInfo vk_viewport_state = {};
+        std::vector<VkDynamicState> dynamic_state = {};
+        VkPipelineDynamicStateCreateInfo vk_dynamic_state = {};
+        VkPipelineRenderingCreateInfo vk_pipeline_rendering = {};
+        VkGraphicsPipelineCreateInfo vk_create_info = {};
+
+        auto init(daxa_Device device, daxa_RasterPipelineInfo const * c_info) -> daxa_Result;
+        void destroy_shader_modules(daxa_Device device);
+    };
 
-    auto create_shader_module = [&](ShaderInfo const & shader_info, VkShaderStageFlagBits shader_stage) -> VkResult
+    auto RasterPipelineCreateState::init(daxa_Device device, daxa_RasterPipelineInfo const * c_info) -> daxa_Result
     {
-        VkShaderModule vk_shader_module = nullptr;
-        VkShaderModuleCreateInfo const vk_shader_module_create_info{
-            .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+        auto const & info = *reinterpret_cast<RasterPipelineInfo const *>(c_info);
+        // Necessary to prevent re-allocation
+        auto const MAXIMUM_GRAPHICS_STAGES = 6;
+        require_subgroup_size_vkstructs.reserve(MAXIMUM_GRAPHICS_STAGES);
+
+        auto create_shader_module = [&](ShaderInfo const & shader_info, VkShaderStageFlagBits shader_stage) -> VkResult
+        {
+            VkShaderModule vk_shader_module = nullptr;
+            VkShaderModuleCreateInfo const vk_shader_module_create_info{
+                .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = {},
+                .codeSize = static_cast<u32>(shader_info.byte_code_size * sizeof(u32)),
+                .pCode = shader_info.byte_code,
+            };
+            auto result = vkCreateShaderModule(device->vk_device, &vk_shader_module_create_info, nullptr, &vk_shader_module);
+            if (result != VK_SUCCESS)
+            {
+                return result;
+            }
+            vk_shader_modules.push_back(vk_shader_module);
+            entry_point_names.push_back(std::make_unique<std::string>(shader_info.entry_point.view().begin(), shader_info.entry_point.view().end()));
+            require_subgroup_size_vkstructs.push_back({
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO,
+                .pNext = nullptr,
+                .requiredSubgroupSize = shader_info.required_subgroup_size.value_or(0),
+            });
+            VkPipelineShaderStageCreateInfo const vk_pipeline_shader_stage_create_info{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                .pNext = shader_info.required_subgroup_size.has_value() ? &require_subgroup_size_vkstructs.back() : nullptr,
+                .flags = std::bit_cast<VkPipelineShaderStageCreateFlags>(shader_info.create_flags),
+                .stage = shader_stage,
+                .module = vk_shader_module,
+                .pName = entry_point_names.back()->c_str(),
+                .pSpecializationInfo = nullptr,
+            };
+            vk_pipeline_shader_stage_create_infos.push_back(vk_pipeline_shader_stage_create_info);
+            return result;
+        };
+
+#define DAXA_DECL_TRY_CREATE_MODULE(name, NAME)                                                                             \
+    if (info.name##_shader_info.has_value())                                                                                \
+    {                                                                                                                       \
+        auto result = create_shader_module(info.name##_shader_info.value(), VkShaderStageFlagBits::VK_SHADER_STAGE_##NAME); \
+        if (result != VK_SUCCESS)                                                                                           \
+        {                                                                                                                   \
+            return std::bit_cast<daxa_Result>(result);                                                                      \
+        }                                                                                                                   \
+    }
+        DAXA_DECL_TRY_CREATE_MODULE(vertex, VERTEX_BIT)
+        DAXA_DECL_TRY_CREATE_MODULE(tesselation_control, TESSELLATION_CONTROL_BIT)
+        DAXA_DECL_TRY_CREATE_MODULE(tesselation_evaluation, TESSELLATION_EVALUATION_BIT)
+        DAXA_DECL_TRY_CREATE_MODULE(fragment, FRAGMENT_BIT)
+        if ((device->properties.implicit_features & ImplicitFeatureFlagBits::MESH_SHADER) != DeviceFlagBits::NONE)
+        {
+            DAXA_DECL_TRY_CREATE_MODULE(task, TASK_BIT_EXT)
+            DAXA_DECL_TRY_CREATE_MODULE(mesh, MESH_BIT_EXT)
+        }
+        else
+        {
+            if (info.mesh_shader_info.has_value() || info.task_shader_info.has_value())
+            {
+                return DAXA_RESULT_MESH_SHADER_NOT_DEVICE_ENABLED;
+            }
+        }
+#undef DAXA_DECL_TRY_CREATE_MODULE
+
+        vk_input_assembly_state = VkPipelineInputAssemblyStateCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
             .pNext = nullptr,
             .flags = {},
-            .codeSize = static_cast<u32>(shader_info.byte_code_size * sizeof(u32)),
-            .pCode = shader_info.byte_code,
+            .topology = *reinterpret_cast<VkPrimitiveTopology const *>(&info.raster.primitive_topology),
+            .primitiveRestartEnable = static_cast<VkBool32>(info.raster.primitive_restart_enable),
         };
-        auto result = vkCreateShaderModule(ret.device->vk_device, &vk_shader_module_create_info, nullptr, &vk_shader_module);
-        if (result != VK_SUCCESS)
+        auto no_tess = TesselationInfo{};
+        vk_tesselation_domain_origin_state = VkPipelineTessellationDomainOriginStateCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_DOMAIN_ORIGIN_STATE_CREATE_INFO,
+            .pNext = nullptr,
+            .domainOrigin = *reinterpret_cast<VkTessellationDomainOrigin const *>(&info.tesselation.value_or(no_tess).origin),
+        };
+        vk_tesselation_state = VkPipelineTessellationStateCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO,
+            .pNext = reinterpret_cast<void const *>(&vk_tesselation_domain_origin_state),
+            .flags = {},
+            .patchControlPoints = info.tesselation.value_or(no_tess).control_points,
+        };
+        vk_multisample_state = VkPipelineMultisampleStateCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = {},
+            .rasterizationSamples =
+                c_info->raster.static_state_sample_count.has_value
+                    ? c_info->raster.static_state_sample_count.value
+                    : VK_SAMPLE_COUNT_1_BIT,
+            .sampleShadingEnable = VK_FALSE,
+            .minSampleShading = 1.0f,
+            .pSampleMask = {},
+            .alphaToCoverageEnable = {},
+            .alphaToOneEnable = {},
+        };
+        vk_raster_state = VkPipelineRasterizationStateCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = {},
+            .depthClampEnable = static_cast<VkBool32>(info.raster.depth_clamp_enable),
+            .rasterizerDiscardEnable = static_cast<VkBool32>(info.raster.rasterizer_discard_enable),
+            .polygonMode = *reinterpret_cast<VkPolygonMode const *>(&info.raster.polygon_mode),
+            .cullMode = *reinterpret_cast<VkCullModeFlags const *>(&info.raster.face_culling),
+            .frontFace = *reinterpret_cast<VkFrontFace const *>(&info.raster.front_face_winding),
+            .depthBiasEnable = static_cast<VkBool32>(info.raster.depth_bias_enable),
+            .depthBiasConstantFactor = info.raster.depth_bias_constant_factor,
+            .depthBiasClamp = info.raster.depth_bias_clamp,
+            .depthBiasSlopeFactor = info.raster.depth_bias_slope_factor,
+            .lineWidth = info.raster.line_width,
+        };
+        vk_conservative_raster_state = VkPipelineRasterizationConservativeStateCreateInfoEXT{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_CONSERVATIVE_STATE_CREATE_INFO_EXT,
+            .pNext = nullptr,
+            .flags = {},
+            .conservativeRasterizationMode = VK_CONSERVATIVE_RASTERIZATION_MODE_OVERESTIMATE_EXT,
+            .extraPrimitiveOverestimationSize = 0.0f,
+        };
+        if (
+            info.raster.conservative_raster_info.has_value() &&
+            (device->properties.implicit_features & DAXA_IMPLICIT_FEATURE_FLAG_CONSERVATIVE_RASTERIZATION))
         {
-            return result;
+            // TODO(grundlett): Ask Patrick why this doesn't work
+            // auto vk_instance = device->instance->vk_instance;
+            // PFN_vkGetPhysicalDeviceProperties2KHR vkGetPhysicalDeviceProperties2KHR =
+            //     reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(vkGetInstanceProcAddr(vk_instance, "vkGetPhysicalDeviceProperties2KHR"));
+            // DAXA_DBG_ASSERT_TRUE_M(vkGetPhysicalDeviceProperties2KHR != nullptr, "Failed to load this extension function function");
+            // VkPhysicalDeviceProperties2KHR device_props2{};
+            // VkPhysicalDeviceConservativeRasterizationPropertiesEXT conservative_raster_props{};
+            // conservative_raster_props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONSERVATIVE_RASTERIZATION_PROPERTIES_EXT;
+            // device_props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+            // device_props2.pNext = &conservative_raster_props;
+            // vkGetPhysicalDeviceProperties2KHR(device->vk_physical_device, &device_props2);
+            auto const & conservative_raster_info = info.raster.conservative_raster_info.value();
+            vk_conservative_raster_state.conservativeRasterizationMode = static_cast<VkConservativeRasterizationModeEXT>(conservative_raster_info.mode);
+            vk_conservative_raster_state.extraPrimitiveOverestimationSize = conservative_raster_info.size;
+            vk_raster_state.pNext = &vk_conservative_raster_state;
         }
-        vk_shader_modules.push_back(vk_shader_module);
-        entry_point_names.push_back(std::make_unique<std::string>(shader_info.entry_point.view().begin(), shader_info.entry_point.view().end()));
-        require_subgroup_size_vkstructs.push_back({
-            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO,
+        DepthTestInfo const no_depth = {};
+        vk_depth_stencil_state = VkPipelineDepthStencilStateCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
             .pNext = nullptr,
-            .requiredSubgroupSize = shader_info.required_subgroup_size.value_or(0),
-        });
-        VkPipelineShaderStageCreateInfo const vk_pipeline_shader_stage_create_info{
-            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-            .pNext = shader_info.required_subgroup_size.has_value() ? &require_subgroup_size_vkstructs.back() : nullptr,
-            .flags = std::bit_cast<VkPipelineShaderStageCreateFlags>(shader_info.create_flags),
-            .stage = shader_stage,
-            .module = vk_shader_module,
-            .pName = entry_point_names.back()->c_str(),
-            .pSpecializationInfo = nullptr,
+            .flags = {},
+            .depthTestEnable = static_cast<VkBool32>(info.depth_test.has_value()),
+            .depthWriteEnable = static_cast<VkBool32>(info.depth_test.value_or(no_depth).enable_depth_write),
+            .depthCompareOp = static_cast<VkCompareOp>(info.depth_test.value_or(no_depth).depth_test_compare_op),
+            .depthBoundsTestEnable = VK_FALSE,
+            .stencilTestEnable = VK_FALSE,
+            .front = {},
+            .back = {},
+            .minDepthBounds = info.depth_test.value_or(no_depth).min_depth_bounds,
+            .maxDepthBounds = info.depth_test.value_or(no_depth).max_depth_bounds,
         };
-        vk_pipeline_shader_stage_create_infos.push_back(vk_pipeline_shader_stage_create_info);
-        return result;
-    };
-
-#define DAXA_DECL_TRY_CREATE_MODULE(name, NAME)                                                                                 \
-    if (ret.info.name##_shader_info.has_value())                                                                                \
-    {                                                                                                                           \
-        auto result = create_shader_module(ret.info.name##_shader_info.value(), VkShaderStageFlagBits::VK_SHADER_STAGE_##NAME); \
-        if (result != VK_SUCCESS)                                                                                               \
-        {                                                                                                                       \
-            for (auto module : vk_shader_modules)                                                                               \
-            {                                                                                                                   \
-                vkDestroyShaderModule(ret.device->vk_device, module, nullptr);                                                  \
-            }                                                                                                                   \
-            return std::bit_cast<daxa_Result>(result);                                                                          \
-        }                                                                                                                       \
-    }
-    DAXA_DECL_TRY_CREATE_MODULE(vertex, VERTEX_BIT)
-    DAXA_DECL_TRY_CREATE_MODULE(tesselation_control, TESSELLATION_CONTROL_BIT)
-    DAXA_DECL_TRY_CREATE_MODULE(tesselation_evaluation, TESSELLATION_EVALUATION_BIT)
-    DAXA_DECL_TRY_CREATE_MODULE(fragment, FRAGMENT_BIT)
-    if ((ret.device->properties.implicit_features & ImplicitFeatureFlagBits::MESH_SHADER) != DeviceFlagBits::NONE)
-    {
-        DAXA_DECL_TRY_CREATE_MODULE(task, TASK_BIT_EXT)
-        DAXA_DECL_TRY_CREATE_MODULE(mesh, MESH_BIT_EXT)
+        // TODO(capi): DO NOT THROW IN C FUNCTION
+        // DAXA_DBG_ASSERT_TRUE_M(info.color_attachments.size() < pipeline_manager_MAX_ATTACHMENTS, "too many color attachments, make pull request to bump max");
+        auto no_blend = BlendInfo{};
+        for (FixedListSizeT i = 0; i < info.color_attachments.size(); ++i)
+        {
+            vk_pipeline_color_blend_attachment_blend_states.at(i) = VkPipelineColorBlendAttachmentState{
+                .blendEnable = static_cast<VkBool32>(info.color_attachments.at(i).blend.has_value()),
+                .srcColorBlendFactor = static_cast<VkBlendFactor>(info.color_attachments.at(i).blend.value_or(no_blend).src_color_blend_factor),
+                .dstColorBlendFactor = static_cast<VkBlendFactor>(info.color_attachments.at(i).blend.value_or(no_blend).dst_color_blend_factor),
+                .colorBlendOp = static_cast<VkBlendOp>(info.color_attachments.at(i).blend.value_or(no_blend).color_blend_op),
+                .srcAlphaBlendFactor = static_cast<VkBlendFactor>(info.color_attachments.at(i).blend.value_or(no_blend).src_alpha_blend_factor),
+                .dstAlphaBlendFactor = static_cast<VkBlendFactor>(info.color_attachments.at(i).blend.value_or(no_blend).dst_alpha_blend_factor),
+                .alphaBlendOp = static_cast<VkBlendOp>(info.color_attachments.at(i).blend.value_or(no_blend).alpha_blend_op),
+                .colorWriteMask = std::bit_cast<VkColorComponentFlags>(info.color_attachments.at(i).blend.value_or(no_blend).color_write_mask),
+            };
+        }
+        for (FixedListSizeT i = 0; i < info.color_attachments.size(); ++i)
+        {
+            vk_pipeline_color_attachment_formats.at(i) = std::bit_cast<VkFormat>(info.color_attachments.at(i).format);
+        }
+        vk_color_blend_state = VkPipelineColorBlendStateCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = {},
+            .logicOpEnable = VK_FALSE,
+            .logicOp = {},
+            .attachmentCount = static_cast<u32>(info.color_attachments.size()),
+            .pAttachments = vk_pipeline_color_blend_attachment_blend_states.data(),
+            .blendConstants = {1.0f, 1.0f, 1.0f, 1.0f},
+        };
+        vk_viewport_state = VkPipelineViewportStateCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = {},
+            .viewportCount = 1,
+            .pViewports = &DEFAULT_VIEWPORT,
+            .scissorCount = 1,
+            .pScissors = &DEFAULT_SCISSOR,
+        };
+        dynamic_state = std::vector{
+            VkDynamicState::VK_DYNAMIC_STATE_VIEWPORT,
+            VkDynamicState::VK_DYNAMIC_STATE_SCISSOR,
+            VkDynamicState::VK_DYNAMIC_STATE_DEPTH_BIAS,
+        };
+        if ((device->properties.implicit_features & DAXA_IMPLICIT_FEATURE_FLAG_DYNAMIC_STATE_3) &&
+            !c_info->raster.static_state_sample_count.has_value)
+        {
+            dynamic_state.push_back(VK_DYNAMIC_STATE_RASTERIZATION_SAMPLES_EXT);
+        }
+        vk_dynamic_state = VkPipelineDynamicStateCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = {},
+            .dynamicStateCount = static_cast<u32>(dynamic_state.size()),
+            .pDynamicStates = dynamic_state.data(),
+        };
+        vk_pipeline_rendering = VkPipelineRenderingCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
+            .pNext = nullptr,
+            .viewMask = {},
+            .colorAttachmentCount = static_cast<u32>(info.color_attachments.size()),
+            .pColorAttachmentFormats = vk_pipeline_color_attachment_formats.data(),
+            .depthAttachmentFormat = static_cast<VkFormat>(info.depth_test.value_or(no_depth).depth_attachment_format),
+            .stencilAttachmentFormat = {},
+        };
+        vk_create_info = VkGraphicsPipelineCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+            .pNext = &vk_pipeline_rendering,
+            .flags = {},
+            .stageCount = static_cast<u32>(vk_pipeline_shader_stage_create_infos.size()),
+            .pStages = vk_pipeline_shader_stage_create_infos.data(),
+            .pVertexInputState = &EMPTY_VERTEX_INPUT_STATE,
+            .pInputAssemblyState = &vk_input_assembly_state,
+            .pTessellationState = &vk_tesselation_state,
+            .pViewportState = &vk_viewport_state,
+            .pRasterizationState = &vk_raster_state,
+            .pMultisampleState = &vk_multisample_state,
+            .pDepthStencilState = &vk_depth_stencil_state,
+            .pColorBlendState = &vk_color_blend_state,
+            .pDynamicState = &vk_dynamic_state,
+            .layout = device->gpu_sro_table.pipeline_layouts.at((info.push_constant_size + 3) / 4),
+            .renderPass = nullptr,
+            .subpass = 0,
+            .basePipelineHandle = VK_NULL_HANDLE,
+            .basePipelineIndex = 0,
+        };
+        return DAXA_RESULT_SUCCESS;
     }
-    else
+
+    void RasterPipelineCreateState::destroy_shader_modules(daxa_Device device)
     {
-        if (ret.info.mesh_shader_info.has_value() || ret.info.task_shader_info.has_value())
+        for (auto & vk_shader_module : vk_shader_modules)
         {
-            for (auto module : vk_shader_modules)
-            {
-                vkDestroyShaderModule(ret.device->vk_device, module, nullptr);
-            }
-            return DAXA_RESULT_MESH_SHADER_NOT_DEVICE_ENABLED;
+            vkDestroyShaderModule(device->vk_device, vk_shader_module, nullptr);
         }
+        vk_shader_modules.clear();
     }
 
-    ret.vk_pipeline_layout = ret.device->gpu_sro_table.pipeline_layouts.at((ret.info.push_constant_size + 3) / 4);
-    constexpr VkPipelineVertexInputStateCreateInfo vk_vertex_input_state{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = {},
-        .vertexBindingDescriptionCount = 0,
-        .pVertexBindingDescriptions = nullptr,
-        .vertexAttributeDescriptionCount = 0,
-        .pVertexAttributeDescriptions = nullptr,
-    };
-    VkPipelineInputAssemblyStateCreateInfo const vk_input_assembly_state{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = {},
-        .topology = *reinterpret_cast<VkPrimitiveTopology const *>(&ret.info.raster.primitive_topology),
-        .primitiveRestartEnable = static_cast<VkBool32>(ret.info.raster.primitive_restart_enable),
-    };
-    auto no_tess = TesselationInfo{};
-    VkPipelineTessellationDomainOriginStateCreateInfo const vk_tesselation_domain_origin_state{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_DOMAIN_ORIGIN_STATE_CREATE_INFO,
-        .pNext = nullptr,
-        .domainOrigin = *reinterpret_cast<VkTessellationDomainOrigin const *>(&ret.info.tesselation.value_or(no_tess).origin),
-    };
-    VkPipelineTessellationStateCreateInfo const vk_tesselation_state{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO,
-        .pNext = reinterpret_cast<void const *>(&vk_tesselation_domain_origin_state),
-        .flags = {},
-        .patchControlPoints = ret.info.tesselation.value_or(no_tess).control_points,
-    };
-    VkPipelineMultisampleStateCreateInfo const vk_multisample_state{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = {},
-        .rasterizationSamples =
-            info->raster.static_state_sample_count.has_value
-                ? info->raster.static_state_sample_count.value
-                : VK_SAMPLE_COUNT_1_BIT,
-        .sampleShadingEnable = VK_FALSE,
-        .minSampleShading = 1.0f,
-        .pSampleMask = {},
-        .alphaToCoverageEnable = {},
-        .alphaToOneEnable = {},
-    };
-    VkPipelineRasterizationStateCreateInfo vk_raster_state{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = {},
-        .depthClampEnable = static_cast<VkBool32>(ret.info.raster.depth_clamp_enable),
-        .rasterizerDiscardEnable = static_cast<VkBool32>(ret.info.raster.rasterizer_discard_enable),
-        .polygonMode = *reinterpret_cast<VkPolygonMode const *>(&ret.info.raster.polygon_mode),
-        .cullMode = *reinterpret_cast<VkCullModeFlags const *>(&ret.info.raster.face_culling),
-        .frontFace = *reinterpret_cast<VkFrontFace const *>(&ret.info.raster.front_face_winding),
-        .depthBiasEnable = static_cast<VkBool32>(ret.info.raster.depth_bias_enable),
-        .depthBiasConstantFactor = ret.info.raster.depth_bias_constant_factor,
-        .depthBiasClamp = ret.info.raster.depth_bias_clamp,
-        .depthBiasSlopeFactor = ret.info.raster.depth_bias_slope_factor,
-        .lineWidth = ret.info.raster.line_width,
-    };
-    auto vk_conservative_raster_state = VkPipelineRasterizationConservativeStateCreateInfoEXT{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_CONSERVATIVE_STATE_CREATE_INFO_EXT,
-        .pNext = nullptr,
-        .flags = {},
-        .conservativeRasterizationMode = VK_CONSERVATIVE_RASTERIZATION_MODE_OVERESTIMATE_EXT,
-        .extraPrimitiveOverestimationSize = 0.0f,
-    };
-    if (
-        ret.info.raster.conservative_raster_info.has_value() &&
-        (device->properties.implicit_features & DAXA_IMPLICIT_FEATURE_FLAG_CONSERVATIVE_RASTERIZATION))
+    // Holds all vulkan structs needed to create one compute pipeline.
+    // The create info points into the state itself, so the state must not move between init and pipeline creation.
+    struct ComputePipelineCreateState
     {
-        // TODO(grundlett): Ask Patrick why this doesn't work
-        // auto vk_instance = ret.device->instance->vk_instance;
-        // PFN_vkGetPhysicalDeviceProperties2KHR vkGetPhysicalDeviceProperties2KHR =
-        //     reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(vkGetInstanceProcAddr(vk_instance, "vkGetPhysicalDeviceProperties2KHR"));
-        // DAXA_DBG_ASSERT_TRUE_M(vkGetPhysicalDeviceProperties2KHR != nullptr, "Failed to load this extension function function");
-        // VkPhysicalDeviceProperties2KHR device_props2{};
-        // VkPhysicalDeviceConservativeRasterizationPropertiesEXT conservative_raster_props{};
-        // conservative_raster_props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONSERVATIVE_RASTERIZATION_PROPERTIES_EXT;
-        // device_props2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
-        // device_props2.pNext = &conservative_raster_props;
-        // vkGetPhysicalDeviceProperties2KHR(ret.device->vk_physical_device, &device_props2);
-        auto const & conservative_raster_info = ret.info.raster.conservative_raster_info.value();
-        vk_conservative_raster_state.conservativeRasterizationMode = static_cast<VkConservativeRasterizationModeEXT>(conservative_raster_info.mode);
-        vk_conservative_raster_state.extraPrimitiveOverestimationSize = conservative_raster_info.size;
-        vk_raster_state.pNext = &vk_conservative_raster_state;
-    }
-    DepthTestInfo const no_depth = {};
-    VkPipelineDepthStencilStateCreateInfo const vk_depth_stencil_state{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = {},
-        .depthTestEnable = static_cast<VkBool32>(ret.info.depth_test.has_value()),
-        .depthWriteEnable = static_cast<VkBool32>(ret.info.depth_test.value_or(no_depth).enable_depth_write),
-        .depthCompareOp = static_cast<VkCompareOp>(ret.info.depth_test.value_or(no_depth).depth_test_compare_op),
-        .depthBoundsTestEnable = VK_FALSE,
-        .stencilTestEnable = VK_FALSE,
-        .front = {},
-        .back = {},
-        .minDepthBounds = ret.info.depth_test.value_or(no_depth).min_depth_bounds,
-        .maxDepthBounds = ret.info.depth_test.value_or(no_depth).max_depth_bounds,
+        VkShaderModule vk_shader_module = {};
+        VkPipelineShaderStageRequiredSubgroupSizeCreateInfo require_subgroup_size_vkstruct = {};
+        VkComputePipelineCreateInfo vk_create_info = {};
+
+        auto init(daxa_Device device, daxa_ComputePipelineInfo const * c_info) -> daxa_Result;
+        void destroy_shader_modules(daxa_Device device);
     };
-    // TODO(capi): DO NOT THROW IN C FUNCTION
-    // DAXA_DBG_ASSERT_TRUE_M(ret.info.color_attachments.size() < pipeline_manager_MAX_ATTACHMENTS, "too many color attachments, make pull request to bump max");
-    std::array<VkPipelineColorBlendAttachmentState, pipeline_manager_MAX_ATTACHMENTS> vk_pipeline_color_blend_attachment_blend_states = {};
-    auto no_blend = BlendInfo{};
-    for (FixedListSizeT i = 0; i < ret.info.color_attachments.size(); ++i)
+
+    auto ComputePipelineCreateState::init(daxa_Device device, daxa_ComputePipelineInfo const * c_info) -> daxa_Result
     {
-        vk_pipeline_color_blend_attachment_blend_states.at(i) = VkPipelineColorBlendAttachmentState{
-            .blendEnable = static_cast<VkBool32>(ret.info.color_attachments.at(i).blend.has_value()),
-            .srcColorBlendFactor = static_cast<VkBlendFactor>(ret.info.color_attachments.at(i).blend.value_or(no_blend).src_color_blend_factor),
-            .dstColorBlendFactor = static_cast<VkBlendFactor>(ret.info.color_attachments.at(i).blend.value_or(no_blend).dst_color_blend_factor),
-            .colorBlendOp = static_cast<VkBlendOp>(ret.info.color_attachments.at(i).blend.value_or(no_blend).color_blend_op),
-            .srcAlphaBlendFactor = static_cast<VkBlendFactor>(ret.info.color_attachments.at(i).blend.value_or(no_blend).src_alpha_blend_factor),
-            .dstAlphaBlendFactor = static_cast<VkBlendFactor>(ret.info.color_attachments.at(i).blend.value_or(no_blend).dst_alpha_blend_factor),
-            .alphaBlendOp = static_cast<VkBlendOp>(ret.info.color_attachments.at(i).blend.value_or(no_blend).alpha_blend_op),
-            .colorWriteMask = std::bit_cast<VkColorComponentFlags>(ret.info.color_attachments.at(i).blend.value_or(no_blend).color_write_mask),
+        auto const & info = *reinterpret_cast<ComputePipelineInfo const *>(c_info);
+        VkShaderModuleCreateInfo const shader_module_ci{
+            .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = {},
+            .codeSize = info.shader_info.byte_code_size * static_cast<u32>(sizeof(u32)),
+            .pCode = info.shader_info.byte_code,
         };
+        auto module_result = vkCreateShaderModule(device->vk_device, &shader_module_ci, nullptr, &vk_shader_module);
+        if (module_result != VK_SUCCESS)
+        {
+            return std::bit_cast<daxa_Result>(module_result);
+        }
+        require_subgroup_size_vkstruct = VkPipelineShaderStageRequiredSubgroupSizeCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO,
+            .pNext = nullptr,
+            .requiredSubgroupSize = info.shader_info.required_subgroup_size.value_or(0),
+        };
+        vk_create_info = VkComputePipelineCreateInfo{
+            .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = {},
+            .stage = VkPipelineShaderStageCreateInfo{
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                .pNext = info.shader_info.required_subgroup_size.has_value() ? &require_subgroup_size_vkstruct : nullptr,
+                .flags = std::bit_cast<VkPipelineShaderStageCreateFlags>(info.shader_info.create_flags),
+                .stage = VkShaderStageFlagBits::VK_SHADER_STAGE_COMPUTE_BIT,
+                .module = vk_shader_module,
+                .pName = info.shader_info.entry_point.data(),
+                .pSpecializationInfo = nullptr,
+            },
+            .layout = device->gpu_sro_table.pipeline_layouts.at((info.push_constant_size + 3) / 4),
+            .basePipelineHandle = VK_NULL_HANDLE,
+            .basePipelineIndex = 0,
+        };
+        return DAXA_RESULT_SUCCESS;
     }
-    std::array<VkFormat, pipeline_manager_MAX_ATTACHMENTS> vk_pipeline_color_attachment_formats = {};
-    for (FixedListSizeT i = 0; i < ret.info.color_attachments.size(); ++i)
-    {
-        vk_pipeline_color_attachment_formats.at(i) = std::bit_cast<VkFormat>(ret.info.color_attachments.at(i).format);
-    }
-    VkPipelineColorBlendStateCreateInfo const vk_color_blend_state{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = {},
-        .logicOpEnable = VK_FALSE,
-        .logicOp = {},
-        .attachmentCount = static_cast<u32>(ret.info.color_attachments.size()),
-        .pAttachments = vk_pipeline_color_blend_attachment_blend_states.data(),
-        .blendConstants = {1.0f, 1.0f, 1.0f, 1.0f},
-    };
-    constexpr VkViewport DEFAULT_VIEWPORT{.x = 0, .y = 0, .width = 1, .height = 1, .minDepth = 0, .maxDepth = 0};
-    constexpr VkRect2D DEFAULT_SCISSOR{.offset = {0, 0}, .extent = {1, 1}};
-    VkPipelineViewportStateCreateInfo const vk_viewport_state{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = {},
-        .viewportCount = 1,
-        .pViewports = &DEFAULT_VIEWPORT,
-        .scissorCount = 1,
-        .pScissors = &DEFAULT_SCISSOR,
-    };
-    auto dynamic_state = std::vector{
-        VkDynamicState::VK_DYNAMIC_STATE_VIEWPORT,
-        VkDynamicState::VK_DYNAMIC_STATE_SCISSOR,
-        VkDynamicState::VK_DYNAMIC_STATE_DEPTH_BIAS,
-    };
-    if ((device->properties.implicit_features & DAXA_IMPLICIT_FEATURE_FLAG_DYNAMIC_STATE_3) &&
-        !info->raster.static_state_sample_count.has_value)
-    {
-        dynamic_state.push_back(VK_DYNAMIC_STATE_RASTERIZATION_SAMPLES_EXT);
-    }
-    VkPipelineDynamicStateCreateInfo const vk_dynamic_state{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = {},
-        .dynamicStateCount = static_cast<u32>(dynamic_state.size()),
-        .pDynamicStates = dynamic_state.data(),
-    };
-    VkPipelineRenderingCreateInfo vk_pipeline_rendering{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR,
-        .pNext = nullptr,
-        .viewMask = {},
-        .colorAttachmentCount = static_cast<u32>(ret.info.color_attachments.size()),
-        .pColorAttachmentFormats = vk_pipeline_color_attachment_formats.data(),
-        .depthAttachmentFormat = static_cast<VkFormat>(ret.info.depth_test.value_or(no_depth).depth_attachment_format),
-        .stencilAttachmentFormat = {},
-    };
-    VkGraphicsPipelineCreateInfo const vk_graphics_pipeline_create_info{
-        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-        .pNext = &vk_pipeline_rendering,
-        .flags = {},
-        .stageCount = static_cast<u32>(vk_pipeline_shader_stage_create_infos.size()),
-        .pStages = vk_pipeline_shader_stage_create_infos.data(),
-        .pVertexInputState = &vk_vertex_input_state,
-        .pInputAssemblyState = &vk_input_assembly_state,
-        .pTessellationState = &vk_tesselation_state,
-        .pViewportState = &vk_viewport_state,
-        .pRasterizationState = &vk_raster_state,
-        .pMultisampleState = &vk_multisample_state,
-        .pDepthStencilState = &vk_depth_stencil_state,
-        .pColorBlendState = &vk_color_blend_state,
-        .pDynamicState = &vk_dynamic_state,
-        .layout = ret.vk_pipeline_layout,
-        .renderPass = nullptr,
-        .subpass = 0,
-        .basePipelineHandle = VK_NULL_HANDLE,
-        .basePipelineIndex = 0,
-    };
-    auto result = vkCreateGraphicsPipelines(
-        ret.device->vk_device,
-        VK_NULL_HANDLE,
-        1u,
-        &vk_graphics_pipeline_create_info,
-        nullptr,
-        &ret.vk_pipeline);
-    for (auto & vk_shader_module : vk_shader_modules)
+
+    void ComputePipelineCreateState::destroy_shader_modules(daxa_Device device)
     {
-        vkDestroyShaderModule(ret.device->vk_device, vk_shader_module, nullptr);
+        if (vk_shader_module != VK_NULL_HANDLE)
+        {
+            vkDestroyShaderModule(device->vk_device, vk_shader_module, nullptr);
+            vk_shader_module = VK_NULL_HANDLE;
+        }
     }
-    if (result != VK_SUCCESS)
+
+    void set_pipeline_debug_name(ImplPipeline const & pipeline, SmallString const & name)
     {
-        return std::bit_cast<daxa_Result>(result);
+        if ((pipeline.device->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && !name.view().empty())
+        {
+            auto name_cstr = name.c_str();
+            VkDebugUtilsObjectNameInfoEXT const name_info{
+                .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
+                .pNext = nullptr,
+                .objectType = VK_OBJECT_TYPE_PIPELINE,
+                .objectHandle = std::bit_cast<u64>(pipeline.vk_pipeline),
+                .pObjectName = name_cstr.data(),
+            };
+            pipeline.device->vkSetDebugUtilsObjectNameEXT(pipeline.device->vk_device, &name_info);
+        }
     }
-    if ((ret.device->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && !ret.info.name.empty())
-    {
-        auto name_cstr = ret.info.name.c_str();
-        VkDebugUtilsObjectNameInfoEXT const name_info{
-            .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
-            .pNext = nullptr,
-            .objectType = VK_OBJECT_TYPE_PIPELINE,
-            .objectHandle = std::bit_cast<u64>(ret.vk_pipeline),
-            .pObjectName = name_cstr.data(),
+
+    // Creates all pipelines of a batch.
+    // The create infos are split into one contiguous chunk per thread, each chunk is passed to a single vkCreate*Pipelines call.
+    // Vulkan allows creating pipelines from multiple threads and the pipeline cache is internally synchronized.
+    // Either all pipelines are created or none are.
+    template <typename CreateStateT, typename CInfoT, typename ImplPipelineT, typename VkCreatePipelinesFnT>
+    auto create_pipelines(
+        daxa_Device device,
+        CInfoT const * infos,
+        u32 count,
+        u32 thread_count,
+        ImplPipelineT ** out_pipelines,
+        VkCreatePipelinesFnT vk_create_pipelines) -> daxa_Result
+    {
+        std::vector<CreateStateT> states(count);
+        for (u32 i = 0; i < count; ++i)
+        {
+            auto const result = states[i].init(device, &infos[i]);
+            if (result != DAXA_RESULT_SUCCESS)
+            {
+                for (u32 j = 0; j <= i; ++j)
+                {
+                    states[j].destroy_shader_modules(device);
+                }
+                return result;
+            }
+        }
+        std::vector<decltype(CreateStateT::vk_create_info)> vk_create_infos(count);
+        for (u32 i = 0; i < count; ++i)
+        {
+            vk_create_infos[i] = states[i].vk_create_info;
+        }
+        std::vector<VkPipeline> vk_pipelines(count, VK_NULL_HANDLE);
+
+        if (thread_count == 0)
+        {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+        thread_count = std::min(thread_count, count);
+        std::vector<VkResult> chunk_results(thread_count, VK_SUCCESS);
+        auto create_chunk = [&](u32 chunk)
+        {
+            u32 const first = static_cast<u32>(static_cast<u64>(chunk) * count / thread_count);
+            u32 const end = static_cast<u32>(static_cast<u64>(chunk + 1) * count / thread_count);
+            chunk_results[chunk] = vk_create_pipelines(
+                device->vk_device,
+                device->vk_pipeline_cache,
+                end - first,
+                vk_create_infos.data() + first,
+                nullptr,
+                vk_pipelines.data() + first);
         };
-        ret.device->vkSetDebugUtilsObjectNameEXT(ret.device->vk_device, &name_info);
+        std::vector<std::thread> threads = {};
+        for (u32 chunk = 1; chunk < thread_count; ++chunk)
+        {
+            threads.push_back(std::thread{create_chunk, chunk});
+        }
+        if (thread_count > 0)
+        {
+            create_chunk(0);
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+
+        for (auto & state : states)
+        {
+            state.destroy_shader_modules(device);
+        }
+        for (auto const chunk_result : chunk_results)
+        {
+            if (chunk_result != VK_SUCCESS)
+            {
+                // Failed calls still return the pipelines that were created successfully.
+                for (auto vk_pipeline : vk_pipelines)
+                {
+                    if (vk_pipeline != VK_NULL_HANDLE)
+                    {
+                        vkDestroyPipeline(device->vk_device, vk_pipeline, nullptr);
+                    }
+                }
+                return std::bit_cast<daxa_Result>(chunk_result);
+            }
+        }
+
+        for (u32 i = 0; i < count; ++i)
+        {
+            auto * pipeline = new ImplPipelineT{};
+            pipeline->device = device;
+            pipeline->info = *reinterpret_cast<decltype(pipeline->info) const *>(&infos[i]);
+            pipeline->vk_pipeline = vk_pipelines[i];
+            pipeline->vk_pipeline_layout = vk_create_infos[i].layout;
+            set_pipeline_debug_name(*pipeline, pipeline->info.name);
+            pipeline->strong_count = 1;
+            device->inc_weak_refcnt();
+            out_pipelines[i] = pipeline;
+        }
+        return DAXA_RESULT_SUCCESS;
     }
-    ret.strong_count = 1;
-    device->inc_weak_refcnt();
-    *out_pipeline = new daxa_ImplRasterPipeline{};
-    **out_pipeline = ret;
-    return DAXA_RESULT_SUCCESS;
+} // namespace
+
+// --- Begin API Functions ---
+
+auto daxa_dvc_create_raster_pipeline(daxa_Device device, daxa_RasterPipelineInfo const * info, daxa_RasterPipeline * out_pipeline) -> daxa_Result
+{
+    _DAXA_TEST_PRINT("daxa_dvc_create_raster_pipeline\n");
+    return daxa_dvc_create_raster_pipelines(device, info, 1, 1, out_pipeline);
+}
+
+auto daxa_dvc_create_raster_pipelines(daxa_Device device, daxa_RasterPipelineInfo const * infos, u32 count, u32 thread_count, daxa_RasterPipeline * out_pipelines) -> daxa_Result
+{
+    _DAXA_TEST_PRINT("daxa_dvc_create_raster_pipelines\n");
+    return create_pipelines<RasterPipelineCreateState>(device, infos, count, thread_count, out_pipelines, vkCreateGraphicsPipelines);
 }
 
 auto daxa_raster_pipeline_info(daxa_RasterPipeline self) -> daxa_RasterPipelineInfo const *
@@ -332,74 +515,13 @@ auto daxa_raster_pipeline_dec_refcnt(daxa_RasterPipeline self) -> u64
 auto daxa_dvc_create_compute_pipeline(daxa_Device device, daxa_ComputePipelineInfo const * info, daxa_ComputePipeline * out_pipeline) -> daxa_Result
 {
     _DAXA_TEST_PRINT("daxa_dvc_create_compute_pipeline\n");
-    daxa_ImplComputePipeline ret = {};
-    ret.device = device;
-    ret.info = *reinterpret_cast<ComputePipelineInfo const *>(info);
-    VkShaderModule vk_shader_module = {};
-    VkShaderModuleCreateInfo const shader_module_ci{
-        .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = {},
-        .codeSize = ret.info.shader_info.byte_code_size * static_cast<u32>(sizeof(u32)),
-        .pCode = ret.info.shader_info.byte_code,
-    };
-    auto module_result = vkCreateShaderModule(ret.device->vk_device, &shader_module_ci, nullptr, &vk_shader_module);
-    if (module_result != VK_SUCCESS)
-    {
-        return std::bit_cast<daxa_Result>(module_result);
-    }
-    ret.vk_pipeline_layout = ret.device->gpu_sro_table.pipeline_layouts.at((ret.info.push_constant_size + 3) / 4);
-    VkPipelineShaderStageRequiredSubgroupSizeCreateInfo require_subgroup_size_vkstruct{
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_REQUIRED_SUBGROUP_SIZE_CREATE_INFO,
-        .pNext = nullptr,
-        .requiredSubgroupSize = ret.info.shader_info.required_subgroup_size.value_or(0),
-    };
-    VkComputePipelineCreateInfo const vk_compute_pipeline_create_info{
-        .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = {},
-        .stage = VkPipelineShaderStageCreateInfo{
-            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-            .pNext = ret.info.shader_info.required_subgroup_size.has_value() ? &require_subgroup_size_vkstruct : nullptr,
-            .flags = std::bit_cast<VkPipelineShaderStageCreateFlags>(ret.info.shader_info.create_flags),
-            .stage = VkShaderStageFlagBits::VK_SHADER_STAGE_COMPUTE_BIT,
-            .module = vk_shader_module,
-            .pName = ret.info.shader_info.entry_point.data(),
-            .pSpecializationInfo = nullptr,
-        },
-        .layout = ret.vk_pipeline_layout,
-        .basePipelineHandle = VK_NULL_HANDLE,
-        .basePipelineIndex = 0,
-    };
-    auto pipeline_result = vkCreateComputePipelines(
-        ret.device->vk_device,
-        VK_NULL_HANDLE,
-        1u,
-        &vk_compute_pipeline_create_info,
-        nullptr,
-        &ret.vk_pipeline);
-    vkDestroyShaderModule(ret.device->vk_device, vk_shader_module, nullptr);
-    if (pipeline_result != VK_SUCCESS)
-    {
-        return std::bit_cast<daxa_Result>(pipeline_result);
-    }
-    if ((ret.device->instance->info.flags & InstanceFlagBits::DEBUG_UTILS) != InstanceFlagBits::NONE && !ret.info.name.view().empty())
-    {
-        auto name_cstr = ret.info.name.c_str();
-        VkDebugUtilsObjectNameInfoEXT const name_info{
-            .sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT,
-            .pNext = nullptr,
-            .objectType = VK_OBJECT_TYPE_PIPELINE,
-            .objectHandle = std::bit_cast<uint64_t>(ret.vk_pipeline),
-            .pObjectName = name_cstr.data(),
-        };
-        ret.device->vkSetDebugUtilsObjectNameEXT(ret.device->vk_device, &name_info);
-    }
-    ret.strong_count = 1;
-    device->inc_weak_refcnt();
-    *out_pipeline = new daxa_ImplComputePipeline{};
-    **out_pipeline = ret;
-    return DAXA_RESULT_SUCCESS;
+    return daxa_dvc_create_compute_pipelines(device, info, 1, 1, out_pipeline);
+}
+
+auto daxa_dvc_create_compute_pipelines(daxa_Device device, daxa_ComputePipelineInfo const * infos, u32 count, u32 thread_count, daxa_ComputePipeline * out_pipelines) -> daxa_Result
+{
+    _DAXA_TEST_PRINT("daxa_dvc_create_compute_pipelines\n");
+    return create_pipelines<ComputePipelineCreateState>(device, infos, count, thread_count, out_pipelines, vkCreateComputePipelines);
 }
 
 auto daxa_compute_pipeline_info(daxa_ComputePipeline self) -> daxa_ComputePipelineInfo const *
@@ -587,7 +709,7 @@ auto daxa_dvc_create_ray_tracing_pipeline(daxa_Device device, daxa_RayTracingPip
     auto pipeline_result = ret.device->vkCreateRayTracingPipelinesKHR(
         ret.device->vk_device,
         VK_NULL_HANDLE,
-        VK_NULL_HANDLE,
+        ret.device->vk_pipeline_cache,
         1u,
         &vk_ray_tracing_pipeline_create_info,
         nullptr,
@@ -855,9 +977,8 @@ void ImplPipeline::zero_ref_callback(ImplHandle const * handle)
 {
     _DAXA_TEST_PRINT("ImplPipeline::zero_ref_callback\n");
     auto * self = rc_cast<ImplPipeline *>(handle);
-    std::unique_lock const lock{self->device->zombies_mtx};
     u64 const submit_timeline_value = self->device->global_submit_timeline.load(std::memory_order::relaxed);
-    self->device->pipeline_zombies.emplace_front(
+    self->device->pipeline_zombies.push(
         submit_timeline_value,
         PipelineZombie{
             .vk_pipeline = self->vk_pipeline,
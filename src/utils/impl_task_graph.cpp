@@ -1,8 +1,14 @@
 #if DAXA_BUILT_WITH_UTILS_TASK_GRAPH
 
 #include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <exception>
 #include <iostream>
+#include <numeric>
 #include <set>
+#include <thread>
 
 #include <utility>
 
@@ -802,16 +808,83 @@ namespace daxa
             nullptr);
     }
 
-    TaskGraph::TaskGraph(TaskGraphInfo const & info)
+    ImplTransientHeap::ImplTransientHeap(TransientHeapInfo a_info)
+        : info{std::move(a_info)}
     {
-        this->object = new ImplTaskGraph(info);
-        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
-        impl.permutations.resize(usize{1} << info.permutation_condition_count);
-        for (auto & permutation : impl.permutations)
+    }
+
+    void ImplTransientHeap::reserve(MemoryRequirements const & new_requirements)
+    {
+        if (new_requirements.size == 0)
+        {
+            return;
+        }
+        MemoryRequirements const grown = {
+            .size = std::max(requirements.size, new_requirements.size),
+            .alignment = std::max(requirements.alignment, new_requirements.alignment),
+            .memory_type_bits = requirements.memory_type_bits & new_requirements.memory_type_bits,
+        };
+        DAXA_DBG_ASSERT_TRUE_M(grown.memory_type_bits != 0, "transient resources of the task graphs sharing this heap have no common memory type");
+        bool const fits =
+            grown.size == requirements.size &&
+            grown.alignment == requirements.alignment &&
+            grown.memory_type_bits == requirements.memory_type_bits;
+        if (fits)
         {
-            permutation.batch_submit_scopes.push_back({});
+            return;
         }
-        impl.update_active_permutations();
+        requirements = grown;
+        // The old block is kept alive by the resources created in it until they are recreated.
+        memory_block = info.device.create_memory({
+            .requirements = requirements,
+            .flags = MemoryFlagBits::DEDICATED_MEMORY,
+        });
+        generation += 1;
+    }
+
+    void ImplTransientHeap::zero_ref_callback(ImplHandle const * handle)
+    {
+        auto * self = rc_cast<ImplTransientHeap *>(handle);
+        delete self;
+    }
+
+    TransientHeap::TransientHeap(TransientHeapInfo const & info)
+    {
+        this->object = new ImplTransientHeap(info);
+    }
+
+    auto TransientHeap::info() const -> TransientHeapInfo const &
+    {
+        auto const & impl = *r_cast<ImplTransientHeap const *>(this->object);
+        return impl.info;
+    }
+
+    auto TransientHeap::size() const -> usize
+    {
+        auto const & impl = *r_cast<ImplTransientHeap const *>(this->object);
+        return impl.requirements.size;
+    }
+
+    auto TransientHeap::inc_refcnt(ImplHandle const * object) -> u64
+    {
+        return object->inc_refcnt();
+    }
+
+    auto TransientHeap::dec_refcnt(ImplHandle const * object) -> u64
+    {
+        return object->dec_refcnt(
+            ImplTransientHeap::zero_ref_callback,
+            nullptr);
+    }
+
+    TaskGraph::TaskGraph(TaskGraphInfo const & info)
+    {
+        DAXA_DBG_ASSERT_TRUE_M(info.permutation_condition_count <= DAXA_TASK_GRAPH_MAX_CONDITIONALS, "too many permutation conditions");
+        DAXA_DBG_ASSERT_TRUE_M(info.frames_in_flight >= 1, "task graphs need at least one frame in flight");
+        DAXA_DBG_ASSERT_TRUE_M(info.frames_in_flight == 1 || !info.transient_heap.has_value(), "frames in flight can not be combined with a transient heap");
+        DAXA_DBG_ASSERT_TRUE_M(info.frames_in_flight == 1 || !info.static_execution, "frames in flight can not be combined with static execution");
+        DAXA_DBG_ASSERT_TRUE_M(!info.swapchain.has_value() || !info.static_execution, "swapchains can not be combined with static execution, the acquired swapchain image changes every frame");
+        this->object = new ImplTaskGraph(info);
     }
     TaskGraph::~TaskGraph() = default;
 
@@ -822,13 +895,7 @@ namespace daxa
         DAXA_DBG_ASSERT_TRUE_M(!impl.buffer_name_to_id.contains(buffer.info().name), "task buffer names must be unique");
         TaskBufferView const task_buffer_id{{.task_graph_index = impl.unique_index, .index = static_cast<u32>(impl.global_buffer_infos.size())}};
 
-        for (auto & permutation : impl.permutations)
-        {
-            permutation.buffer_infos.push_back(PerPermTaskBuffer{
-                .valid = false,
-            });
-        }
-
+        impl.record_command(RecordedResourceDeclaration{.is_image = false, .index = task_buffer_id.index});
         impl.global_buffer_infos.emplace_back(PermIndepTaskBufferInfo{
             .task_buffer_data = PermIndepTaskBufferInfo::Persistent{
                 .buffer_blas_tlas = buffer,
@@ -845,13 +912,7 @@ namespace daxa
         DAXA_DBG_ASSERT_TRUE_M(!impl.blas_name_to_id.contains(blas.info().name), "task blas names must be unique");
         TaskBlasView const task_blas_id{{.task_graph_index = impl.unique_index, .index = static_cast<u32>(impl.global_buffer_infos.size())}};
 
-        for (auto & permutation : impl.permutations)
-        {
-            permutation.buffer_infos.push_back(PerPermTaskBuffer{
-                .valid = false,
-            });
-        }
-
+        impl.record_command(RecordedResourceDeclaration{.is_image = false, .index = task_blas_id.index});
         impl.global_buffer_infos.emplace_back(PermIndepTaskBufferInfo{
             .task_buffer_data = PermIndepTaskBufferInfo::Persistent{
                 .buffer_blas_tlas = blas,
@@ -868,13 +929,7 @@ namespace daxa
         DAXA_DBG_ASSERT_TRUE_M(!impl.tlas_name_to_id.contains(tlas.info().name), "task tlas names must be unique");
         TaskTlasView const task_tlas_id{{.task_graph_index = impl.unique_index, .index = static_cast<u32>(impl.global_buffer_infos.size())}};
 
-        for (auto & permutation : impl.permutations)
-        {
-            permutation.buffer_infos.push_back(PerPermTaskBuffer{
-                .valid = false,
-            });
-        }
-
+        impl.record_command(RecordedResourceDeclaration{.is_image = false, .index = task_tlas_id.index});
         impl.global_buffer_infos.emplace_back(PermIndepTaskBufferInfo{
             .task_buffer_data = PermIndepTaskBufferInfo::Persistent{
                 .buffer_blas_tlas = tlas,
@@ -891,16 +946,7 @@ namespace daxa
         DAXA_DBG_ASSERT_TRUE_M(!impl.image_name_to_id.contains(image.info().name), "task image names must be unique");
         TaskImageView const task_image_id{{.task_graph_index = impl.unique_index, .index = static_cast<u32>(impl.global_image_infos.size())}};
 
-        for (auto & permutation : impl.permutations)
-        {
-            // For non-persistent resources task graph will synch on the initial to first use every execution.
-            permutation.image_infos.emplace_back();
-            if (image.info().swapchain_image)
-            {
-                DAXA_DBG_ASSERT_TRUE_M(permutation.swapchain_image.is_empty(), "can only register one swapchain image per task graph permutation");
-                permutation.swapchain_image = task_image_id;
-            }
-        }
+        impl.record_command(RecordedResourceDeclaration{.is_image = true, .index = task_image_id.index});
 
         impl.global_image_infos.emplace_back(PermIndepTaskImageInfo{
             .task_image_data = PermIndepTaskImageInfo::Persistent{
@@ -917,12 +963,7 @@ namespace daxa
         DAXA_DBG_ASSERT_TRUE_M(!impl.buffer_name_to_id.contains(info.name), "task buffer names must be unique");
         TaskBufferView task_buffer_id{{.task_graph_index = impl.unique_index, .index = static_cast<u32>(impl.global_buffer_infos.size())}};
 
-        for (auto & permutation : impl.permutations)
-        {
-            permutation.buffer_infos.push_back(PerPermTaskBuffer{
-                .valid = permutation.active,
-            });
-        }
+        impl.record_command(RecordedResourceDeclaration{.is_image = false, .index = task_buffer_id.index});
         auto const & info_copy = info; // NOTE: (HACK) we must do this because msvc designated init bugs causing it to not generate copy constructors.
         impl.global_buffer_infos.emplace_back(PermIndepTaskBufferInfo{
             .task_buffer_data = PermIndepTaskBufferInfo::Transient{.info = info_copy}});
@@ -945,13 +986,7 @@ namespace daxa
             .layer_count = info.array_layer_count,
         };
 
-        for (auto & permutation : impl.permutations)
-        {
-            permutation.image_infos.emplace_back(PerPermTaskImage{
-                .valid = permutation.active,
-                .swapchain_semaphore_waited_upon = false,
-            });
-        }
+        impl.record_command(RecordedResourceDeclaration{.is_image = true, .index = task_image_view.index});
 
         auto info_copy = info; // NOTE: (HACK) we must do this because msvc designated init bugs causing it to not generate copy constructors.
         impl.global_image_infos.emplace_back(PermIndepTaskImageInfo{
@@ -1033,19 +1068,436 @@ namespace daxa
         }
     }
 
-    void ImplTaskGraph::update_active_permutations()
+    void ImplTaskGraph::record_command(RecordedCommandData const & command)
+    {
+        recorded_commands.push_back(RecordedCommand{
+            .active_conditional_scopes = record_active_conditional_scopes,
+            .conditional_states = record_conditional_states,
+            .command = command,
+        });
+    }
+
+    // Attachment access as seen by the barrier minimizing scheduler.
+    struct ScheduledAccess
+    {
+        usize task = {};
+        bool is_image = {};
+        u32 index = {};
+        ImageMipArraySlice slice = {};
+        ImageLayout layout = {};
+        Access access = {};
+        TaskAccessConcurrency concurrency = {};
+        usize queue_index = {};
+    };
+
+    // Mirrors the rules of schedule_task. Two accesses may only share a batch when both are reads or both are concurrent read writes,
+    // in the same layout and on the same queue. All other overlapping accesses must be ordered into separate batches.
+    auto scheduled_accesses_conflict(ScheduledAccess const & previous, ScheduledAccess const & current) -> bool
+    {
+        if (previous.is_image != current.is_image || previous.index != current.index)
+        {
+            return false;
+        }
+        if (current.is_image && !previous.slice.intersects(current.slice))
+        {
+            return false;
+        }
+        if (!current.is_image && previous.access.type == AccessTypeFlagBits::NONE)
+        {
+            return false;
+        }
+        bool const both_read = previous.access.type == AccessTypeFlagBits::READ && current.access.type == AccessTypeFlagBits::READ;
+        bool const both_rw_concurrent =
+            previous.access.type == AccessTypeFlagBits::READ_WRITE && previous.concurrency == TaskAccessConcurrency::CONCURRENT &&
+            current.access.type == AccessTypeFlagBits::READ_WRITE && current.concurrency == TaskAccessConcurrency::CONCURRENT;
+        return !((both_read || both_rw_concurrent) && previous.layout == current.layout && previous.queue_index == current.queue_index);
+    }
+
+    // List schedules the tasks of one submit scope, returning the planned batch of each task.
+    // Only conflicting accesses create dependencies, so unlike the default scheduler, reads are not ordered behind each other.
+    // The number of batches is the length of the longest dependency chain, each batch after the first is a barrier point.
+    // Tasks with dependencies are placed in the batch after their last dependency.
+    // Tasks without dependencies are delayed to the batch before their first dependent task.
+    // This shortens transient lifetimes and replaces their split barriers with pipeline barriers merged into the barrier point of the dependent batch.
+    auto plan_minimal_barrier_batches(ImplTaskGraph & impl, std::span<TaskId const> task_ids) -> std::vector<usize>
+    {
+        usize const task_count = task_ids.size();
+        std::vector<ScheduledAccess> accesses = {};
+        std::vector<std::vector<usize>> buffer_accesses(impl.global_buffer_infos.size());
+        std::vector<std::vector<usize>> image_accesses(impl.global_image_infos.size());
+        std::vector<std::vector<usize>> dependencies(task_count);
+        for (usize task_index = 0; task_index < task_count; ++task_index)
+        {
+            ImplTask & impl_task = impl.tasks[task_ids[task_index]];
+            usize const queue_index = queue_flat_index(impl_task.queue);
+            auto const add_access = [&](std::vector<usize> & resource_accesses, ScheduledAccess const & access)
+            {
+                for (usize const previous_index : resource_accesses)
+                {
+                    ScheduledAccess const & previous = accesses[previous_index];
+                    if (previous.task != task_index && scheduled_accesses_conflict(previous, access))
+                    {
+                        dependencies[task_index].push_back(previous.task);
+                    }
+                }
+                resource_accesses.push_back(accesses.size());
+                accesses.push_back(access);
+            };
+            for_each(
+                impl_task.base_task->attachments(),
+                [&](u32, auto const & attach)
+                {
+                    if (attach.view.is_null()) return;
+                    auto [access, concurrency] = task_buffer_access_to_access(static_cast<TaskBufferAccess>(attach.access));
+                    add_access(buffer_accesses[attach.translated_view.index], ScheduledAccess{
+                                                                                  .task = task_index,
+                                                                                  .is_image = false,
+                                                                                  .index = attach.translated_view.index,
+                                                                                  .access = access,
+                                                                                  .concurrency = concurrency,
+                                                                                  .queue_index = queue_index,
+                                                                              });
+                },
+                [&](u32, TaskImageAttachmentInfo const & attach)
+                {
+                    if (attach.view.is_null()) return;
+                    auto [layout, access, concurrency] = task_image_access_to_layout_access(attach.access);
+                    add_access(image_accesses[attach.translated_view.index], ScheduledAccess{
+                                                                                 .task = task_index,
+                                                                                 .is_image = true,
+                                                                                 .index = attach.translated_view.index,
+                                                                                 .slice = attach.translated_view.slice,
+                                                                                 .layout = layout,
+                                                                                 .access = access,
+                                                                                 .concurrency = concurrency,
+                                                                                 .queue_index = queue_index,
+                                                                             });
+                });
+        }
+
+        // Tasks are recorded in a valid order, dependencies always point to earlier tasks.
+        std::vector<usize> earliest_batches(task_count, 0);
+        usize last_batch = 0;
+        for (usize task_index = 0; task_index < task_count; ++task_index)
+        {
+            for (usize const dependency : dependencies[task_index])
+            {
+                earliest_batches[task_index] = std::max(earliest_batches[task_index], earliest_batches[dependency] + 1);
+            }
+            last_batch = std::max(last_batch, earliest_batches[task_index]);
+        }
+        std::vector<usize> latest_batches(task_count, last_batch);
+        for (usize task_index = task_count; task_index > 0; --task_index)
+        {
+            for (usize const dependency : dependencies[task_index - 1])
+            {
+                latest_batches[dependency] = std::min(latest_batches[dependency], latest_batches[task_index - 1] - 1);
+            }
+        }
+        // Placing dependent tasks directly after their dependencies never exceeds their latest batch,
+        // so the planned schedule keeps the minimal batch count.
+        std::vector<usize> batches(task_count, 0);
+        for (usize task_index = 0; task_index < task_count; ++task_index)
+        {
+            if (dependencies[task_index].empty())
+            {
+                batches[task_index] = latest_batches[task_index];
+            }
+            for (usize const dependency : dependencies[task_index])
+            {
+                batches[task_index] = std::max(batches[task_index], batches[dependency] + 1);
+            }
+        }
+        return batches;
+    }
+
+    auto schedule_statistics(TaskGraphPermutation const & permutation) -> TaskScheduleStatistics
+    {
+        TaskScheduleStatistics ret = {
+            .pipeline_barrier_count = permutation.barriers.size(),
+            .split_barrier_count = permutation.split_barriers.size(),
+        };
+        ret.batch_count = permutation.task_batches.size();
+        for (auto const & submit_scope : permutation.batch_submit_scopes)
+        {
+            for (auto const & task_batch : permutation.submit_scope_batches(submit_scope))
+            {
+                if (!task_batch.pipeline_barrier_indices.empty() || !task_batch.wait_split_barrier_indices.empty())
+                {
+                    ret.barrier_point_count += 1;
+                }
+            }
+        }
+        return ret;
+    }
+
+    struct DeadTaskCulling
+    {
+        // Indexed by task id.
+        std::vector<bool> culled_tasks = {};
+        // Resources accessed by the remaining tasks, indexed by the local resource index.
+        std::vector<bool> used_buffers = {};
+        std::vector<bool> used_images = {};
+    };
+
+    // Walks the tasks of the permutation backwards, keeping a task when it is a root or when a kept task after it reads a resource it writes.
+    // Roots are tasks with side effects, tasks writing persistent resources and tasks without any writes, as their effects are invisible to the graph.
+    // Reads are tracked per resource, not per image slice, so a task is never culled when a kept task reads any part of its outputs.
+    auto cull_dead_tasks(ImplTaskGraph & impl, u32 permutation_index) -> DeadTaskCulling
+    {
+        std::vector<TaskId> task_ids = {};
+        for (RecordedCommand const & recorded : impl.recorded_commands)
+        {
+            bool const active = (recorded.active_conditional_scopes & permutation_index) == (recorded.active_conditional_scopes & recorded.conditional_states);
+            if (auto const * recorded_task = std::get_if<RecordedTask>(&recorded.command); recorded_task != nullptr && active)
+            {
+                task_ids.push_back(recorded_task->task_id);
+            }
+        }
+        DeadTaskCulling ret = {
+            .culled_tasks = std::vector<bool>(impl.tasks.size(), false),
+            .used_buffers = std::vector<bool>(impl.global_buffer_infos.size(), false),
+            .used_images = std::vector<bool>(impl.global_image_infos.size(), false),
+        };
+        std::vector<bool> read_buffers(impl.global_buffer_infos.size(), false);
+        std::vector<bool> read_images(impl.global_image_infos.size(), false);
+        for (auto task_id_iter = task_ids.rbegin(); task_id_iter != task_ids.rend(); ++task_id_iter)
+        {
+            ImplTask const & impl_task = impl.tasks[*task_id_iter];
+            bool writes = false;
+            bool live = impl_task.has_side_effects;
+            auto const visit_access = [&](Access const & access, bool is_persistent, bool read_later)
+            {
+                if ((access.type & AccessTypeFlagBits::WRITE) != AccessTypeFlagBits::NONE)
+                {
+                    writes = true;
+                    live = live || is_persistent || read_later;
+                }
+            };
+            for_each(
+                impl_task.base_task->attachments(),
+                [&](u32, auto const & attach)
+                {
+                    if (attach.view.is_null()) return;
+                    auto const [access, concurrency] = task_buffer_access_to_access(static_cast<TaskBufferAccess>(attach.access));
+                    u32 const index = attach.translated_view.index;
+                    visit_access(access, impl.global_buffer_infos[index].is_persistent(), read_buffers[index]);
+                },
+                [&](u32, TaskImageAttachmentInfo const & attach)
+                {
+                    if (attach.view.is_null()) return;
+                    auto const [layout, access, concurrency] = task_image_access_to_layout_access(attach.access);
+                    u32 const index = attach.translated_view.index;
+                    visit_access(access, impl.global_image_infos[index].is_persistent(), read_images[index]);
+                });
+            if (writes && !live)
+            {
+                ret.culled_tasks[*task_id_iter] = true;
+                continue;
+            }
+            for_each(
+                impl_task.base_task->attachments(),
+                [&](u32, auto const & attach)
+                {
+                    if (attach.view.is_null()) return;
+                    auto const [access, concurrency] = task_buffer_access_to_access(static_cast<TaskBufferAccess>(attach.access));
+                    u32 const index = attach.translated_view.index;
+                    ret.used_buffers[index] = true;
+                    read_buffers[index] = read_buffers[index] || (access.type & AccessTypeFlagBits::READ) != AccessTypeFlagBits::NONE;
+                },
+                [&](u32, TaskImageAttachmentInfo const & attach)
+                {
+                    if (attach.view.is_null()) return;
+                    auto const [layout, access, concurrency] = task_image_access_to_layout_access(attach.access);
+                    u32 const index = attach.translated_view.index;
+                    ret.used_images[index] = true;
+                    read_images[index] = read_images[index] || (access.type & AccessTypeFlagBits::READ) != AccessTypeFlagBits::NONE;
+                });
+        }
+        return ret;
+    }
+
+    void ImplTaskGraph::compile_permutation(TaskGraphPermutation & permutation, u32 permutation_index, bool minimize_barriers)
+    {
+        std::optional<DeadTaskCulling> culling = {};
+        if (info.cull_dead_tasks)
+        {
+            culling = cull_dead_tasks(*this, permutation_index);
+            for (TaskId task_id = 0; task_id < tasks.size(); ++task_id)
+            {
+                if (culling->culled_tasks[task_id])
+                {
+                    permutation.culled_tasks.push_back(task_id);
+                }
+            }
+        }
+        // With barrier minimization, the tasks of a submit scope are collected and scheduled together at the next submit.
+        std::vector<TaskId> scope_task_ids = {};
+        auto const add_scope_tasks = [&]()
+        {
+            if (scope_task_ids.empty())
+            {
+                return;
+            }
+            std::vector<usize> const batches = plan_minimal_barrier_batches(*this, scope_task_ids);
+            std::vector<usize> order(scope_task_ids.size());
+            std::iota(order.begin(), order.end(), usize{0});
+            std::stable_sort(order.begin(), order.end(), [&](usize first, usize second)
+                             { return batches[first] < batches[second]; });
+            // Adding the tasks in batch order keeps the accesses of each resource in a valid order for the default barrier generation.
+            for (usize const task_index : order)
+            {
+                TaskId const task_id = scope_task_ids[task_index];
+                permutation.add_task(*this, tasks[task_id], task_id, batches[task_index]);
+            }
+            scope_task_ids.clear();
+        };
+        permutation.batch_submit_scopes.push_back({});
+        for (RecordedCommand const & recorded : recorded_commands)
+        {
+            permutation.active = (recorded.active_conditional_scopes & permutation_index) == (recorded.active_conditional_scopes & recorded.conditional_states);
+            if (auto const * declaration = std::get_if<RecordedResourceDeclaration>(&recorded.command))
+            {
+                // Every permutation has all resources.
+                // Transient resources are only valid in the permutations that were active when they were created.
+                // Persistent resources become valid in a permutation when a task uses them.
+                if (declaration->is_image)
+                {
+                    bool const is_persistent = global_image_infos[declaration->index].is_persistent();
+                    // Transient resources only used by culled tasks are never created.
+                    bool const used = !culling.has_value() || culling->used_images[declaration->index];
+                    permutation.image_infos.push_back(PerPermTaskImage{
+                        .valid = !is_persistent && permutation.active && used,
+                        .swapchain_semaphore_waited_upon = false,
+                    });
+                    if (is_persistent && global_image_infos[declaration->index].get_persistent().info.swapchain_image)
+                    {
+                        DAXA_DBG_ASSERT_TRUE_M(permutation.swapchain_image.is_empty(), "can only register one swapchain image per task graph permutation");
+                        permutation.swapchain_image = TaskImageView{{.task_graph_index = unique_index, .index = declaration->index}};
+                    }
+                }
+                else
+                {
+                    bool const is_persistent = global_buffer_infos[declaration->index].is_persistent();
+                    bool const used = !culling.has_value() || culling->used_buffers[declaration->index];
+                    permutation.buffer_infos.push_back(PerPermTaskBuffer{
+                        .valid = !is_persistent && permutation.active && used,
+                    });
+                }
+                continue;
+            }
+            if (!permutation.active)
+            {
+                continue;
+            }
+            if (auto const * recorded_task = std::get_if<RecordedTask>(&recorded.command))
+            {
+                if (culling.has_value() && culling->culled_tasks[recorded_task->task_id])
+                {
+                    continue;
+                }
+                if (minimize_barriers)
+                {
+                    scope_task_ids.push_back(recorded_task->task_id);
+                }
+                else
+                {
+                    permutation.add_task(*this, tasks[recorded_task->task_id], recorded_task->task_id);
+                }
+            }
+            else if (auto const * submit_info = std::get_if<TaskSubmitInfo>(&recorded.command))
+            {
+                add_scope_tasks();
+                permutation.submit(*submit_info);
+            }
+            else if (auto const * present_info = std::get_if<TaskPresentInfo>(&recorded.command))
+            {
+                add_scope_tasks();
+                permutation.present(*present_info);
+            }
+        }
+        add_scope_tasks();
+
+        permutation.scheduling_statistics.scheduled = schedule_statistics(permutation);
+        permutation.scheduling_statistics.earliest_batch = permutation.scheduling_statistics.scheduled;
+        if (minimize_barriers && info.record_debug_information)
+        {
+            // Compiles the permutation again with the default scheduler to report the difference.
+            // This doubles the compile time, so it is only done when debug information is requested.
+            TaskGraphPermutation earliest_batch_permutation = {};
+            compile_permutation(earliest_batch_permutation, permutation_index, false);
+            permutation.scheduling_statistics.earliest_batch = earliest_batch_permutation.scheduling_statistics.scheduled;
+        }
+    }
+
+    auto ImplTaskGraph::get_jit_permutation(u32 permutation_index) -> TaskGraphPermutation &
     {
-        record_active_permutations.clear();
+        jit_execution_counter += 1;
+        jit_statistics.last_compile_nanos = 0;
+        auto cached = jit_permutations.find(permutation_index);
+        if (cached != jit_permutations.end())
+        {
+            cached->second.last_execution = jit_execution_counter;
+            return cached->second.permutation;
+        }
 
-        for (u32 permutation_i = 0; permutation_i < permutations.size(); ++permutation_i)
+        if (info.jit_max_cached_permutations != 0 && jit_permutations.size() >= info.jit_max_cached_permutations)
         {
-            bool const active = (record_active_conditional_scopes & permutation_i) == (record_active_conditional_scopes & record_conditional_states);
-            permutations[permutation_i].active = active;
-            if (active)
+            auto least_recent = std::min_element(
+                jit_permutations.begin(), jit_permutations.end(),
+                [](auto const & first, auto const & second)
+                { return first.second.last_execution < second.second.last_execution; });
+            // The device defers the destruction until the gpu is done with the previous executions.
+            destroy_transient_runtime_resources(least_recent->second.permutation);
+            jit_permutations.erase(least_recent);
+            jit_statistics.evicted_permutations += 1;
+        }
+
+        auto const compile_start = std::chrono::steady_clock::now();
+        JitCompiledPermutation & jit_permutation = jit_permutations[permutation_index];
+        jit_permutation.last_execution = jit_execution_counter;
+        compile_permutation(jit_permutation.permutation, permutation_index, info.minimize_barriers && info.reorder_tasks);
+        MemoryRequirements const requirements = place_transient_resources(jit_permutation.permutation);
+        jit_permutation.transient_memory_size = requirements.size;
+        if (ImplTransientHeap * heap = transient_heap())
+        {
+            // Permutations placed into a shared heap alias each other, executions of one graph never overlap on the gpu timeline.
+            heap->reserve(requirements);
+            complete_permutation(jit_permutation.permutation, {&heap->memory_block, 1});
+            jit_permutation.permutation.transient_heap_generation = heap->generation;
+        }
+        else
+        {
+            // Each jit permutation gets its own transient memory, so compiling a new permutation never invalidates the cached ones.
+            jit_permutation.transient_memory_blocks.resize(info.frames_in_flight);
+            if (requirements.size != 0)
             {
-                record_active_permutations.push_back(&permutations[permutation_i]);
+                for (auto & memory_block : jit_permutation.transient_memory_blocks)
+                {
+                    memory_block = info.device.create_memory({
+                        .requirements = requirements,
+                        .flags = MemoryFlagBits::DEDICATED_MEMORY,
+                    });
+                }
             }
+            complete_permutation(jit_permutation.permutation, jit_permutation.transient_memory_blocks);
+        }
+        u64 const compile_nanos = static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - compile_start).count());
+
+        jit_statistics.compiled_permutations += 1;
+        jit_statistics.cached_permutations = static_cast<u32>(jit_permutations.size());
+        jit_statistics.last_compile_nanos = compile_nanos;
+        jit_statistics.total_compile_nanos += compile_nanos;
+        return jit_permutation.permutation;
+    }
+
+    auto ImplTaskGraph::get_executed_permutation(u32 permutation_index) -> TaskGraphPermutation &
+    {
+        if (info.jit_compile_permutations)
+        {
+            return jit_permutations.at(permutation_index).permutation;
         }
+        return permutations[permutation_index];
     }
 
     void validate_runtime_image_slice(ImplTaskGraph & impl, TaskGraphPermutation const & perm, u32 use_index, u32 task_image_index, ImageMipArraySlice const & access_slice)
@@ -1090,8 +1542,9 @@ namespace daxa
             {
                 // TODO:
                 // Replace the validity check with a comparison of last execution actual images vs this frame actual images.
-                auto & view_cache = task.image_view_cache[task_image_attach_index];
-                auto & imgs_last_exec = task.runtime_images_last_execution[task_image_attach_index];
+                TaskImageViewCache & frame_view_cache = task.frame_view_caches[transient_frame_index];
+                auto & view_cache = frame_view_cache.image_view_cache[task_image_attach_index];
+                auto & imgs_last_exec = frame_view_cache.runtime_images_last_execution[task_image_attach_index];
 
                 if (image_attach.view.is_null())
                 {
@@ -1386,8 +1839,10 @@ namespace daxa
             [&](u32 index, TaskImageAttachmentInfo & attach)
             {
                 attach.ids = this->get_actual_images(attach.translated_view, permutation);
-                attach.view_ids = std::span{task.image_view_cache[index].data(), task.image_view_cache[index].size()};
+                auto const & view_cache = task.frame_view_caches[this->transient_frame_index].image_view_cache[index];
+                attach.view_ids = std::span{view_cache.data(), view_cache.size()};
                 validate_task_image_runtime_data(task, attach);
+                validate_task_image_queue_sharing(this->info.device, task, attach);
             });
         std::vector<std::byte> attachment_shader_blob = write_attachment_shader_blob(
             info.device,
@@ -1402,7 +1857,7 @@ namespace daxa
             .device = this->info.device,
             .recorder = impl_runtime.recorder,
             .attachment_infos = task.base_task->attachments(),
-            .allocator = this->staging_memory.has_value() ? &this->staging_memory.value() : nullptr,
+            .allocator = impl_runtime.staging_memory,
             .attachment_shader_blob = attachment_shader_blob,
         });
         impl_runtime.recorder.end_label();
@@ -1418,65 +1873,256 @@ namespace daxa
                                fmt::format("Detected invalid conditional index {}; conditional indices must all be smaller then the conditional count given in construction", conditional_info.condition_index));
         // Set conditional scope to active.
         impl.record_active_conditional_scopes |= 1u << conditional_info.condition_index;
-        impl.update_active_permutations();
         // Set the conditional state to active.
         impl.record_conditional_states |= 1u << conditional_info.condition_index;
-        impl.update_active_permutations();
         if (conditional_info.when_true)
         {
             conditional_info.when_true();
         }
         // Set the conditional state to false.
         impl.record_conditional_states &= ~(1u << conditional_info.condition_index);
-        impl.update_active_permutations();
         if (conditional_info.when_false)
         {
             conditional_info.when_false();
         }
         // Set conditional scope to inactive.
         impl.record_active_conditional_scopes &= ~(1u << conditional_info.condition_index);
-        impl.update_active_permutations();
     }
 
-    template <typename TrackedState>
-    struct AccessRelation
+    auto same_tracked_state(ExtendedImageSliceState const & a, ExtendedImageSliceState const & b) -> bool
     {
-        bool is_previous_none = {};
-        bool is_previous_read = {};
-        bool is_current_read = {};
-        bool is_previous_rw_concurrent = {};
-        bool is_current_rw_concurrent = {};
-        bool is_current_concurrent = {};
-        bool are_both_read = {};
-        bool are_both_rw_concurrent = {};
-        bool are_layouts_identical = {};
-        bool are_both_read_and_same_layout = {};
-        bool are_both_rw_concurrent_and_same_layout = {};
-        bool are_both_concurrent = {};
-        bool are_both_concurrent_and_same_layout = {};
-        AccessRelation(TrackedState latest, Access new_access, TaskAccessConcurrency new_concurrency, ImageLayout latest_layout = ImageLayout::UNDEFINED, ImageLayout new_layout = ImageLayout::UNDEFINED)
+        auto const concurrent_access_barrier = [](ExtendedImageSliceState const & slice_state) -> std::pair<u32, usize>
         {
-            if constexpr (requires { latest.latest_access; })
+            if (auto const * split_index = daxa::get_if<LastConcurrentAccessSplitBarrierIndex>(&slice_state.latest_concurrent_access_barrer_index))
             {
-                is_previous_none = latest.latest_access.type == AccessTypeFlagBits::NONE;
-                is_previous_read = latest.latest_access.type == AccessTypeFlagBits::READ;
-                is_previous_rw_concurrent =
-                    latest.latest_access.type == AccessTypeFlagBits::READ_WRITE &&
-                    latest.latest_access_concurrent == TaskAccessConcurrency::CONCURRENT;
+                return {1, split_index->index};
             }
-            if constexpr (requires { latest.state.latest_access; })
+            if (auto const * barrier_index = daxa::get_if<LastConcurrentAccessBarrierIndex>(&slice_state.latest_concurrent_access_barrer_index))
             {
-                is_previous_none = latest.state.latest_access.type == AccessTypeFlagBits::NONE;
-                is_previous_read = latest.state.latest_access.type == AccessTypeFlagBits::READ;
-                is_previous_rw_concurrent =
-                    latest.state.latest_access.type == AccessTypeFlagBits::READ_WRITE &&
-                    latest.latest_access_concurrent == TaskAccessConcurrency::CONCURRENT;
+                return {2, barrier_index->index};
             }
-            is_current_read = new_access.type == AccessTypeFlagBits::READ;
-            is_current_rw_concurrent =
-                new_access.type == AccessTypeFlagBits::READ_WRITE &&
-                new_concurrency == TaskAccessConcurrency::CONCURRENT;
-            is_current_concurrent = is_current_read || is_current_rw_concurrent;
+            return {0, 0};
+        };
+        return a.state.latest_access == b.state.latest_access &&
+               a.state.latest_layout == b.state.latest_layout &&
+               a.latest_access_concurrent == b.latest_access_concurrent &&
+               a.latest_access_batch_index == b.latest_access_batch_index &&
+               a.latest_access_submit_scope_index == b.latest_access_submit_scope_index &&
+               concurrent_access_barrier(a) == concurrent_access_barrier(b);
+    }
+
+    auto end_array_layer(ImageMipArraySlice const & slice) -> u32
+    {
+        return slice.base_array_layer + slice.layer_count;
+    }
+
+    // Indices into the output of the slices ending at the previous mip level, ordered by base array layer.
+    thread_local std::vector<usize> tl_open_slice_indices = {};
+    thread_local std::vector<usize> tl_next_open_slice_indices = {};
+    thread_local std::vector<ExtendedImageSliceState> tl_mip_intervals = {};
+    // Appends the intervals of one mip level to out.
+    // Slices of the previous mip level with the same layers and state are extended by one mip level instead.
+    // Must be called for every mip level in ascending order, the open slice indices must be cleared before the first one.
+    void append_mip_intervals(std::span<ExtendedImageSliceState const> intervals, std::vector<ExtendedImageSliceState> & out)
+    {
+        usize open_i = 0;
+        for (auto const & interval : intervals)
+        {
+            while (open_i < tl_open_slice_indices.size() &&
+                   out[tl_open_slice_indices[open_i]].state.slice.base_array_layer < interval.state.slice.base_array_layer)
+            {
+                ++open_i;
+            }
+            if (open_i < tl_open_slice_indices.size())
+            {
+                auto & open_slice = out[tl_open_slice_indices[open_i]];
+                bool const extends_open_slice =
+                    open_slice.state.slice.base_array_layer == interval.state.slice.base_array_layer &&
+                    open_slice.state.slice.layer_count == interval.state.slice.layer_count &&
+                    open_slice.state.slice.base_mip_level + open_slice.state.slice.level_count == interval.state.slice.base_mip_level &&
+                    same_tracked_state(open_slice, interval);
+                if (extends_open_slice)
+                {
+                    open_slice.state.slice.level_count += 1;
+                    tl_next_open_slice_indices.push_back(tl_open_slice_indices[open_i]);
+                    ++open_i;
+                    continue;
+                }
+            }
+            tl_next_open_slice_indices.push_back(out.size());
+            out.push_back(interval);
+        }
+        std::swap(tl_open_slice_indices, tl_next_open_slice_indices);
+        tl_next_open_slice_indices.clear();
+    }
+
+    void ImageSliceStateMap::intersecting(ImageMipArraySlice const & slice, std::vector<ExtendedImageSliceState> & out) const
+    {
+        tl_open_slice_indices.clear();
+        u32 const end_mip = std::min(slice.base_mip_level + slice.level_count, static_cast<u32>(this->mip_layer_intervals.size()));
+        for (u32 mip = slice.base_mip_level; mip < end_mip; ++mip)
+        {
+            auto const & intervals = this->mip_layer_intervals[mip];
+            // The intervals are sorted and disjoint, so the first intersecting one is found with a binary search.
+            auto iter = std::partition_point(
+                intervals.begin(), intervals.end(),
+                [&](ExtendedImageSliceState const & interval)
+                { return end_array_layer(interval.state.slice) <= slice.base_array_layer; });
+            for (; iter != intervals.end() && iter->state.slice.base_array_layer < end_array_layer(slice); ++iter)
+            {
+                ExtendedImageSliceState clipped_interval = *iter;
+                clipped_interval.state.slice = iter->state.slice.intersect(slice);
+                tl_mip_intervals.push_back(clipped_interval);
+            }
+            append_mip_intervals(tl_mip_intervals, out);
+            tl_mip_intervals.clear();
+        }
+        tl_open_slice_indices.clear();
+    }
+
+    void ImageSliceStateMap::slices(std::vector<ExtendedImageSliceState> & out) const
+    {
+        tl_open_slice_indices.clear();
+        for (auto const & intervals : this->mip_layer_intervals)
+        {
+            append_mip_intervals(intervals, out);
+        }
+        tl_open_slice_indices.clear();
+    }
+
+    void ImageSliceStateMap::insert(ExtendedImageSliceState const & state)
+    {
+        this->erase(state.state.slice);
+        ImageMipArraySlice const & slice = state.state.slice;
+        if (this->mip_layer_intervals.size() < slice.base_mip_level + slice.level_count)
+        {
+            this->mip_layer_intervals.resize(slice.base_mip_level + slice.level_count);
+        }
+        for (u32 mip = slice.base_mip_level; mip < slice.base_mip_level + slice.level_count; ++mip)
+        {
+            auto & intervals = this->mip_layer_intervals[mip];
+            ExtendedImageSliceState interval = state;
+            interval.state.slice.base_mip_level = mip;
+            interval.state.slice.level_count = 1;
+            // The layers of the slice were just erased, all intervals before the insertion point end at or before the slice.
+            auto iter = std::partition_point(
+                intervals.begin(), intervals.end(),
+                [&](ExtendedImageSliceState const & other)
+                { return other.state.slice.base_array_layer < slice.base_array_layer; });
+            // Merge with the neighboring intervals when they hold the same state.
+            if (iter != intervals.begin() &&
+                end_array_layer(std::prev(iter)->state.slice) == slice.base_array_layer &&
+                same_tracked_state(*std::prev(iter), interval))
+            {
+                iter = std::prev(iter);
+                iter->state.slice.layer_count += slice.layer_count;
+            }
+            else
+            {
+                iter = intervals.insert(iter, interval);
+            }
+            auto next = std::next(iter);
+            if (next != intervals.end() &&
+                next->state.slice.base_array_layer == end_array_layer(iter->state.slice) &&
+                same_tracked_state(*next, interval))
+            {
+                iter->state.slice.layer_count += next->state.slice.layer_count;
+                intervals.erase(next);
+            }
+        }
+    }
+
+    void ImageSliceStateMap::erase(ImageMipArraySlice const & slice)
+    {
+        u32 const end_mip = std::min(slice.base_mip_level + slice.level_count, static_cast<u32>(this->mip_layer_intervals.size()));
+        for (u32 mip = slice.base_mip_level; mip < end_mip; ++mip)
+        {
+            auto & intervals = this->mip_layer_intervals[mip];
+            auto first = std::partition_point(
+                intervals.begin(), intervals.end(),
+                [&](ExtendedImageSliceState const & interval)
+                { return end_array_layer(interval.state.slice) <= slice.base_array_layer; });
+            auto last = first;
+            while (last != intervals.end() && last->state.slice.base_array_layer < end_array_layer(slice))
+            {
+                ++last;
+            }
+            if (first == last)
+            {
+                continue;
+            }
+            // The first and last overlapped intervals may reach past the erased layers, their rests are kept.
+            ExtendedImageSliceState left_rest = *first;
+            ExtendedImageSliceState right_rest = *std::prev(last);
+            bool const keep_left_rest = left_rest.state.slice.base_array_layer < slice.base_array_layer;
+            bool const keep_right_rest = end_array_layer(right_rest.state.slice) > end_array_layer(slice);
+            left_rest.state.slice.layer_count = slice.base_array_layer - left_rest.state.slice.base_array_layer;
+            right_rest.state.slice.layer_count = end_array_layer(right_rest.state.slice) - end_array_layer(slice);
+            right_rest.state.slice.base_array_layer = end_array_layer(slice);
+            auto iter = intervals.erase(first, last);
+            if (keep_right_rest)
+            {
+                iter = intervals.insert(iter, right_rest);
+            }
+            if (keep_left_rest)
+            {
+                intervals.insert(iter, left_rest);
+            }
+        }
+    }
+
+    void ImageSliceStateMap::clear()
+    {
+        this->mip_layer_intervals.clear();
+    }
+
+    auto ImageSliceStateMap::empty() const -> bool
+    {
+        return std::all_of(
+            this->mip_layer_intervals.begin(), this->mip_layer_intervals.end(),
+            [](auto const & intervals)
+            { return intervals.empty(); });
+    }
+
+    template <typename TrackedState>
+    struct AccessRelation
+    {
+        bool is_previous_none = {};
+        bool is_previous_read = {};
+        bool is_current_read = {};
+        bool is_previous_rw_concurrent = {};
+        bool is_current_rw_concurrent = {};
+        bool is_current_concurrent = {};
+        bool are_both_read = {};
+        bool are_both_rw_concurrent = {};
+        bool are_layouts_identical = {};
+        bool are_both_read_and_same_layout = {};
+        bool are_both_rw_concurrent_and_same_layout = {};
+        bool are_both_concurrent = {};
+        bool are_both_concurrent_and_same_layout = {};
+        AccessRelation(TrackedState latest, Access new_access, TaskAccessConcurrency new_concurrency, ImageLayout latest_layout = ImageLayout::UNDEFINED, ImageLayout new_layout = ImageLayout::UNDEFINED)
+        {
+            if constexpr (requires { latest.latest_access; })
+            {
+                is_previous_none = latest.latest_access.type == AccessTypeFlagBits::NONE;
+                is_previous_read = latest.latest_access.type == AccessTypeFlagBits::READ;
+                is_previous_rw_concurrent =
+                    latest.latest_access.type == AccessTypeFlagBits::READ_WRITE &&
+                    latest.latest_access_concurrent == TaskAccessConcurrency::CONCURRENT;
+            }
+            if constexpr (requires { latest.state.latest_access; })
+            {
+                is_previous_none = latest.state.latest_access.type == AccessTypeFlagBits::NONE;
+                is_previous_read = latest.state.latest_access.type == AccessTypeFlagBits::READ;
+                is_previous_rw_concurrent =
+                    latest.state.latest_access.type == AccessTypeFlagBits::READ_WRITE &&
+                    latest.latest_access_concurrent == TaskAccessConcurrency::CONCURRENT;
+            }
+            is_current_read = new_access.type == AccessTypeFlagBits::READ;
+            is_current_rw_concurrent =
+                new_access.type == AccessTypeFlagBits::READ_WRITE &&
+                new_concurrency == TaskAccessConcurrency::CONCURRENT;
+            is_current_concurrent = is_current_read || is_current_rw_concurrent;
             are_both_read = is_previous_read && is_current_read;
             are_both_rw_concurrent = is_previous_rw_concurrent && is_current_rw_concurrent;
             are_layouts_identical = latest_layout == new_layout;
@@ -1487,18 +2133,25 @@ namespace daxa
         }
     };
 
+    thread_local std::vector<ExtendedImageSliceState> tl_scheduled_tracked_slices = {};
     auto schedule_task(
         ImplTaskGraph & impl,
         TaskGraphPermutation & perm,
         TaskBatchSubmitScope & current_submit_scope,
         usize const current_submit_scope_index,
-        ITask & task)
+        ITask & task,
+        Queue const queue,
+        usize const min_batch_index)
         -> usize
     {
-        usize first_possible_batch_index = 0;
+        // Accesses on another queue are always ordered into a later batch, as batches only contain tasks of one queue.
+        auto const is_cross_queue = [&](usize batch_index)
+        { return queue_flat_index(perm.batch(current_submit_scope_index, batch_index).queue) != queue_flat_index(queue); };
+        // The barrier minimizing scheduler plans the batch of each task ahead of time, the planned batch is only raised when a dependency requires it.
+        usize first_possible_batch_index = min_batch_index;
         if (!impl.info.reorder_tasks)
         {
-            first_possible_batch_index = std::max(current_submit_scope.task_batches.size(), static_cast<size_t>(1ull)) - 1ull;
+            first_possible_batch_index = std::max(current_submit_scope.batch_count, static_cast<size_t>(1ull)) - 1ull;
         }
 
         for_each(
@@ -1526,7 +2179,8 @@ namespace daxa
                 // If they are not inserted within the same batch due to dependencies of other attachments, daxa will still reuse the barriers.
                 // This is only possible for read write concurrent and read access sequences!
                 AccessRelation<decltype(task_buffer)> relation{task_buffer, current_buffer_access, current_access_concurrency};
-                if (!relation.are_both_read && !relation.are_both_rw_concurrent && !relation.is_previous_none)
+                if (!relation.is_previous_none &&
+                    ((!relation.are_both_read && !relation.are_both_rw_concurrent) || is_cross_queue(task_buffer.latest_access_batch_index)))
                 {
                     current_buffer_first_possible_batch_index += 1;
                 }
@@ -1555,14 +2209,13 @@ namespace daxa
                 auto [this_task_image_layout, this_task_image_access, current_access_concurrent] = task_image_access_to_layout_access(attach.access);
                 // As image subresources can be in different layouts and also different synchronization scopes,
                 // we need to track these image ranges individually.
-                for (ExtendedImageSliceState const & tracked_slice : task_image.last_slice_states)
+                // When the slices dont intersect, we dont need to do any sync or execution ordering between them.
+                task_image.last_slice_states.intersecting(attach.translated_view.slice, tl_scheduled_tracked_slices);
+                for (ExtendedImageSliceState const & tracked_slice : tl_scheduled_tracked_slices)
                 {
                     // If the latest access is in a previous submit scope, the earliest batch we can insert into is
                     // the current scopes first batch.
-                    // When the slices dont intersect, we dont need to do any sync or execution ordering between them.
-                    if (
-                        tracked_slice.latest_access_submit_scope_index < current_submit_scope_index ||
-                        !tracked_slice.state.slice.intersects(attach.translated_view.slice))
+                    if (tracked_slice.latest_access_submit_scope_index < current_submit_scope_index)
                     {
                         continue;
                     }
@@ -1574,18 +2227,32 @@ namespace daxa
                     // If they are not inserted within the same batch due to dependencies of other attachments, daxa will still reuse the barriers.
                     // This is only possible for read write concurrent and read access sequences!
                     AccessRelation<decltype(tracked_slice)> relation{tracked_slice, this_task_image_access, current_access_concurrent, tracked_slice.state.latest_layout, this_task_image_layout};
-                    if (!relation.are_both_read_and_same_layout && !relation.are_both_rw_concurrent_and_same_layout)
+                    if ((!relation.are_both_read_and_same_layout && !relation.are_both_rw_concurrent_and_same_layout) ||
+                        is_cross_queue(tracked_slice.latest_access_batch_index))
                     {
                         current_image_first_possible_batch_index += 1;
                     }
                     first_possible_batch_index = std::max(first_possible_batch_index, current_image_first_possible_batch_index);
                 }
+                tl_scheduled_tracked_slices.clear();
             });
+        // All tasks of a batch run on the same queue.
+        // Skip batches of other queues, empty batches are claimed for the tasks queue.
+        while (first_possible_batch_index < current_submit_scope.batch_count &&
+               !perm.batch(current_submit_scope_index, first_possible_batch_index).tasks.empty() &&
+               is_cross_queue(first_possible_batch_index))
+        {
+            first_possible_batch_index += 1;
+        }
         // Make sure we have enough batches.
-        if (first_possible_batch_index >= current_submit_scope.task_batches.size())
+        // Only the last submit scope records tasks, so its batches are always at the end of the permutations batches.
+        if (first_possible_batch_index >= current_submit_scope.batch_count)
         {
-            current_submit_scope.task_batches.resize(first_possible_batch_index + 1);
+            DAXA_DBG_ASSERT_TRUE_M(current_submit_scope.first_batch_index + current_submit_scope.batch_count == perm.task_batches.size(), "only the last submit scope can grow");
+            current_submit_scope.batch_count = first_possible_batch_index + 1;
+            perm.task_batches.resize(current_submit_scope.first_batch_index + current_submit_scope.batch_count);
         }
+        perm.batch(current_submit_scope_index, first_possible_batch_index).queue = queue;
         return first_possible_batch_index;
     }
 
@@ -1613,118 +2280,75 @@ namespace daxa
 
         TaskId const task_id = impl.tasks.size();
 
-        std::vector<std::vector<ImageViewId>> view_cache = {};
-        view_cache.resize(task->attachments().size(), {});
-        std::vector<std::vector<ImageId>> id_cache = {};
-        id_cache.resize(task->attachments().size(), {});
+        TaskImageViewCache view_cache = {};
+        view_cache.image_view_cache.resize(task->attachments().size(), {});
+        view_cache.runtime_images_last_execution.resize(task->attachments().size(), {});
+        // Fall back to the main queue when the device does not have the preferred queue.
+        Queue queue = task->queue();
+        if (queue.family != QueueFamily::MAIN && queue.index >= impl.info.device.queue_count(queue.family))
+        {
+            queue = QUEUE_MAIN;
+        }
+        bool const has_side_effects = task->has_side_effects();
         auto impl_task = ImplTask{
             .base_task = std::move(task),
-            .image_view_cache = std::move(view_cache),
-            .runtime_images_last_execution = std::move(id_cache),
+            .queue = queue,
+            .has_side_effects = has_side_effects,
+            .frame_view_caches = std::vector<TaskImageViewCache>(impl.info.frames_in_flight, view_cache),
         };
         translate_persistent_ids(impl, impl_task.base_task.get());
 
-        for (auto * permutation : impl.record_active_permutations)
-        {
-            permutation->add_task(impl, impl_task, task_id);
-        }
-
         impl.tasks.emplace_back(std::move(impl_task));
+        impl.record_command(RecordedTask{.task_id = task_id});
     }
 
     thread_local std::vector<ImageMipArraySlice> tl_new_access_slices = {};
+    thread_local std::vector<ExtendedImageSliceState> tl_initial_access_slices = {};
     void update_image_initial_access_slices(
         PerPermTaskImage & task_image,
         ExtendedImageSliceState new_access_slice)
     {
         // We need to test if a new use adds and or subtracts from initial uses.
-        // To do that, we need to test if the new access slice is accessing a subresource BEFORE all other already stored initial access slices.
-        // We compare all new use slices with already tracked first uses.
-        // We intersect the earlier and later happening slices with the new slice and store the intersection rest or the respective later executing slice access.
-        // This list will contain the remainder of the new access ranges after intersections.
+        // The new use becomes the initial use of all subresources that are not already accessed by an earlier batch.
+        // This list will contain the remainder of the new access slice after subtracting all earlier initial accesses.
         tl_new_access_slices.push_back(new_access_slice.state.slice);
-        // Name shortening:
-        auto & initial_accesses = task_image.first_slice_states;
-        // Note(pahrens):
-        // NEVER access new_access_slice.slice in this function past this point.
-        // ALWAYS access the new access ImageMipArraySlice's from an iterator or via vector indexing.
-        for (usize new_access_slice_i = 0; new_access_slice_i < tl_new_access_slices.size();)
-        {
-            bool broke_inner_loop = false;
-            for (usize initial_access_i = 0; initial_access_i < task_image.first_slice_states.size();)
-            {
-                bool const slices_disjoint = !tl_new_access_slices[new_access_slice_i].intersects(initial_accesses[initial_access_i].state.slice);
-                bool const same_batch =
-                    new_access_slice.latest_access_submit_scope_index == initial_accesses[initial_access_i].latest_access_submit_scope_index &&
-                    new_access_slice.latest_access_batch_index == initial_accesses[initial_access_i].latest_access_batch_index;
-                // We check if the sets are disjoint.
-                // If they are we do not need to do anything and advance to the next test.
-                // When two accesses are in the same batch and scope, they can not overlap.
-                // This is simply forbidden by task graph rules!
-                if (same_batch || slices_disjoint)
-                {
-                    ++initial_access_i;
-                    continue;
-                }
-                // Now that we have this edge case out the way, we now need to test which tracked slice is executed earlier.
-                bool const new_use_executes_earlier =
-                    new_access_slice.latest_access_submit_scope_index < initial_accesses[initial_access_i].latest_access_submit_scope_index ||
-                    (new_access_slice.latest_access_submit_scope_index == initial_accesses[initial_access_i].latest_access_submit_scope_index &&
-                     new_access_slice.latest_access_batch_index < initial_accesses[initial_access_i].latest_access_batch_index);
-                // When the new use is executing earlier, we subtract from the current initial access slice.
-                // We then replace the current initial access slice with the resulting rest.
-                if (new_use_executes_earlier)
-                {
-                    // When we intersect, we remove the old initial access slice and replace it with the rest of the subtraction.
-                    // We need a copy of this, as we will erase this value from the vector first.
-                    auto const initial_access_slice = initial_accesses[initial_access_i];
-                    // Erase value from vector.
-                    task_image.first_slice_states.erase(initial_accesses.begin() + isize(initial_access_i));
-                    // Subtract ranges.
-                    auto const [slice_rest, slice_rest_count] = initial_access_slice.state.slice.subtract(tl_new_access_slices[new_access_slice_i]);
-                    // Now construct new sub-ranges from the rest of the subtraction.
-                    // We advance the iterator each time.
-                    for (usize rest_i = 0; rest_i < slice_rest_count; ++rest_i)
-                    {
-                        auto rest_tracked_slice = initial_access_slice;
-                        rest_tracked_slice.state.slice = slice_rest[rest_i];
-                        // We insert into the beginning, so we dont recheck these with the current new use slice.
-                        // They are the result of a subtraction therefore disjoint.
-                        task_image.first_slice_states.insert(initial_accesses.begin(), rest_tracked_slice);
-                    }
-                    // We erased, so we implicitly advanced by an element, as erase moves all elements one to the left past the iterator.
-                    // But as we inserted into the front, we need to move the index accordingly to "stay in place".
-                    initial_access_i += slice_rest_count;
-                }
-                // When the new use is executing AFTER the current inital access slice, we subtract the current initial access slice from the new slice.
-                // We then replace the current new access slice with the resulting rest.
-                else
-                {
-                    // We subtract the initial use from the new use and append the rest.
-                    auto const [slice_rest, slice_rest_count] = tl_new_access_slices[new_access_slice_i].subtract(initial_accesses[initial_access_i].state.slice);
-                    // We insert the rest of the subtraction into the new use list.
-                    tl_new_access_slices.insert(tl_new_access_slices.end(), slice_rest.begin(), slice_rest.begin() + isize(slice_rest_count));
-                    // We remove the current new use slice, as it intersects with an initial use slice and is later in the list.
-                    tl_new_access_slices.erase(tl_new_access_slices.begin() + isize(new_access_slice_i));
-                    // If we advance the new use index, we restart the inner loop over the initial accesses.
-                    broke_inner_loop = true;
-                    break;
-                }
+        task_image.first_slice_states.intersecting(new_access_slice.state.slice, tl_initial_access_slices);
+        for (auto const & initial_access : tl_initial_access_slices)
+        {
+            // When two accesses are in the same batch and scope, they can not overlap.
+            // This is simply forbidden by task graph rules!
+            bool const new_use_executes_earlier =
+                new_access_slice.latest_access_submit_scope_index < initial_access.latest_access_submit_scope_index ||
+                (new_access_slice.latest_access_submit_scope_index == initial_access.latest_access_submit_scope_index &&
+                 new_access_slice.latest_access_batch_index < initial_access.latest_access_batch_index);
+            // When the new use executes earlier, it replaces the initial access when it is inserted below.
+            if (new_use_executes_earlier)
+            {
+                continue;
             }
-            // When we broke out the inner loop we want to "restart" iteration of the outer loop at the current index.
-            if (!broke_inner_loop)
+            // When the new use is executing AFTER the current inital access slice, we subtract the current initial access slice from the new slices.
+            for (usize new_access_slice_i = 0; new_access_slice_i < tl_new_access_slices.size();)
             {
-                ++new_access_slice_i;
+                if (!tl_new_access_slices[new_access_slice_i].intersects(initial_access.state.slice))
+                {
+                    ++new_access_slice_i;
+                    continue;
+                }
+                auto const [slice_rest, slice_rest_count] = tl_new_access_slices[new_access_slice_i].subtract(initial_access.state.slice);
+                // The rests are appended, they do not intersect the current initial access and are skipped by this loop.
+                tl_new_access_slices.erase(tl_new_access_slices.begin() + isize(new_access_slice_i));
+                tl_new_access_slices.insert(tl_new_access_slices.end(), slice_rest.begin(), slice_rest.begin() + isize(slice_rest_count));
             }
         }
-        // Add the newly found initial access slices to the list of initial access slices.
+        // Add the newly found initial access slices, overwriting the later executing initial accesses.
         for (auto const & new_slice : tl_new_access_slices)
         {
             auto new_tracked_slice = new_access_slice;
             new_tracked_slice.state.slice = new_slice;
-            initial_accesses.push_back(new_tracked_slice);
+            task_image.first_slice_states.insert(new_tracked_slice);
         }
         tl_new_access_slices.clear();
+        tl_initial_access_slices.clear();
     }
 
     using ShaderUseIdOffsetTable = std::vector<Variant<std::pair<TaskImageView, usize>, std::pair<TaskBufferView, usize>, Monostate>>;
@@ -1751,12 +2375,12 @@ namespace daxa
     }
 
     // I hate this function.
-    thread_local std::vector<ExtendedImageSliceState> tl_tracked_slice_rests = {};
-    thread_local std::vector<ImageMipArraySlice> tl_new_use_slices = {};
+    thread_local std::vector<ExtendedImageSliceState> tl_intersecting_tracked_slices = {};
     void TaskGraphPermutation::add_task(
         ImplTaskGraph & task_graph_impl,
         ImplTask & impl_task,
-        TaskId task_id)
+        TaskId task_id,
+        usize min_batch_index)
     {
         auto & task = *impl_task.base_task;
         // Set persistent task resources to be valid for the permutation.
@@ -1794,8 +2418,25 @@ namespace daxa
             *this,
             current_submit_scope,
             current_submit_scope_index,
-            task);
-        TaskBatch & batch = current_submit_scope.task_batches[batch_index];
+            task,
+            impl_task.queue,
+            min_batch_index);
+        TaskBatch & batch = this->batch(current_submit_scope_index, batch_index);
+        bool const on_async_queue = impl_task.queue.family != QueueFamily::MAIN;
+        // Returns true when the previous access ran on another queue.
+        // When the previous access is in the same submit scope, the batch must wait on the previous accesses batch.
+        // Previous submit scopes finished on all queues before the current scope starts.
+        auto const sync_cross_queue = [&](usize src_submit_scope_index, usize src_batch_index) -> bool
+        {
+            TaskBatch const & src_batch = this->batch(src_submit_scope_index, src_batch_index);
+            bool const cross_queue = queue_flat_index(src_batch.queue) != queue_flat_index(batch.queue);
+            if (cross_queue && src_submit_scope_index == current_submit_scope_index &&
+                std::find(batch.cross_queue_wait_batch_indices.begin(), batch.cross_queue_wait_batch_indices.end(), src_batch_index) == batch.cross_queue_wait_batch_indices.end())
+            {
+                batch.cross_queue_wait_batch_indices.push_back(src_batch_index);
+            }
+            return cross_queue;
+        };
         // Add the task to the batch.
         batch.tasks.push_back(task_id);
 
@@ -1812,6 +2453,7 @@ namespace daxa
                 PerPermTaskBuffer & task_buffer = this->buffer_infos[buffer_attach.translated_view.index];
                 auto [current_buffer_access, current_access_concurrency] = task_buffer_access_to_access(static_cast<TaskBufferAccess>(buffer_attach.access));
                 update_buffer_first_access(task_buffer, batch_index, current_submit_scope_index, current_buffer_access);
+                task_buffer.used_on_async_queue = task_buffer.used_on_async_queue || on_async_queue;
                 // For transient buffers, we need to record first and last use so that we can later name their allocations.
                 // TODO(msakmary, pahrens) We should think about how to combine this with update_buffer_first_access below since
                 // they both overlap in what they are doing
@@ -1855,7 +2497,8 @@ namespace daxa
                     (relation.is_previous_read || relation.is_previous_rw_concurrent);
                 if (!relation.is_previous_none && !last_access_concurrent_and_external)
                 {
-                    if (relation.are_both_concurrent)
+                    bool const cross_queue = sync_cross_queue(task_buffer.latest_access_submit_scope_index, task_buffer.latest_access_batch_index);
+                    if (relation.are_both_concurrent && !cross_queue)
                     {
                         // If the last and current access is concurrent of the same type (read or rw concurrent), we can reuse the first barrier in the sequence of concurrent accesses.
                         if (LastConcurrentAccessSplitBarrierIndex const * index0 = daxa::get_if<LastConcurrentAccessSplitBarrierIndex>(&task_buffer.latest_concurrent_access_barrer_index))
@@ -1880,16 +2523,17 @@ namespace daxa
                         // When the distance between src and dst batch is one, we can replace the split barrier with a normal barrier.
                         // We also need to make sure we do not use split barriers when the src or dst stage exclusively uses the host stage.
                         // This is because the host stage does not declare an execution dependency on the cpu but only a memory dependency.
+                        // Events can not synchronize between queues, so cross queue accesses always use pipeline barriers.
                         bool const use_pipeline_barrier =
                             (task_buffer.latest_access_batch_index + 1 == batch_index &&
                              current_submit_scope_index == task_buffer.latest_access_submit_scope_index) ||
-                            is_host_barrier;
+                            is_host_barrier || cross_queue;
                         if (use_pipeline_barrier)
                         {
                             usize const barrier_index = this->barriers.size();
                             this->barriers.push_back(TaskBarrier{
                                 .image_id = {}, // {} signals that this is not an image barrier.
-                                .src_access = task_buffer.latest_access,
+                                .src_access = cross_queue ? CROSS_QUEUE_SRC_ACCESS : task_buffer.latest_access,
                                 .dst_access = current_buffer_access,
                             });
                             // And we insert the barrier index into the list of pipeline barriers of the current tasks batch.
@@ -1914,8 +2558,7 @@ namespace daxa
                                 }),
                             });
                             // Now we give the src batch the index of this barrier to signal.
-                            TaskBatchSubmitScope & src_scope = this->batch_submit_scopes[task_buffer.latest_access_submit_scope_index];
-                            TaskBatch & src_batch = src_scope.task_batches[task_buffer.latest_access_batch_index];
+                            TaskBatch & src_batch = this->batch(task_buffer.latest_access_submit_scope_index, task_buffer.latest_access_batch_index);
                             src_batch.signal_split_barrier_indices.push_back(split_barrier_index);
                             // And we also insert the split barrier index into the waits of the current tasks batch.
                             batch.wait_split_barrier_indices.push_back(split_barrier_index);
@@ -1969,14 +2612,10 @@ namespace daxa
                     }
                 }
                 task_image.usage |= access_to_usage(used_image_t_access);
+                task_image.used_on_async_queue = task_image.used_on_async_queue || on_async_queue;
                 task_image.create_flags |= view_type_to_create_flags(image_attach.view_type);
                 auto [current_image_layout, current_image_access, current_access_concurrency] = task_image_access_to_layout_access(used_image_t_access);
                 image_attach.layout = current_image_layout;
-                // Now this seems strange, why would be need multiple current use slices, as we only have one here.
-                // This is because when we intersect this slice with the tracked slices, we get an intersection and a rest.
-                // We need to then test the rest against all the remaining tracked uses,
-                // as the intersected part is already beeing handled in the following code.
-                tl_new_use_slices.push_back(initial_used_image_slice);
                 // This is the tracked slice we will insert after we finished analyzing the current used image.
                 ExtendedImageSliceState ret_new_use_tracked_slice{
                     .state = {
@@ -1993,178 +2632,104 @@ namespace daxa
                 update_image_initial_access_slices(task_image, ret_new_use_tracked_slice);
                 // As image subresources can be in different layouts and also different synchronization scopes,
                 // we need to track these image ranges individually.
-                for (
-                    auto tracked_slice_iter = task_image.last_slice_states.begin();
-                    tracked_slice_iter != task_image.last_slice_states.end();)
-                {
-                    bool advanced_tracked_slice_iterator = false;
-                    for (
-                        auto used_image_slice_iter = tl_new_use_slices.begin();
-                        used_image_slice_iter != tl_new_use_slices.end();)
-                    {
-                        // We make a local copy of both slices here.
-                        // We can not rely on dereferencing the iterators, as we modify them in this function.
-                        // For this inner loop we want to remember the information about these slices,
-                        // even after they are removed from their respective vector.
-                        ImageMipArraySlice const used_image_slice = *used_image_slice_iter;
-                        ExtendedImageSliceState const tracked_slice = *tracked_slice_iter;
-                        // We are only interested in intersecting ranges, as use of non intersecting ranges does not need synchronization.
-                        if (!used_image_slice.intersects(tracked_slice.state.slice))
-                        {
-                            // We only need to advance the iterator manually here.
-                            // After this if statement there is an unconditional erase that advances the iterator if this is not hit.
-                            ++used_image_slice_iter;
-                            continue;
-                        }
-                        // As we found an intersection, part of the old tracked slice must be altered.
-                        // Instead of altering it we remove it and add the rest slices back in later.
-                        used_image_slice_iter = tl_new_use_slices.erase(used_image_slice_iter);
-                        // Now we know that the new use intersects slices with a previous use.
-                        // This means that we need to find the intersecting part,
-                        // sync the intersecting part from the previous use to the current use
-                        // and remove the overlapping part from the tracked slice.
-                        // Now we need to split the uses into three groups:
-                        // * the slice that is the intersection of tracked image slice and current new use (intersection)
-                        // * the part of the tracked image slice that does not intersect with the current new use (tracked_slice_rest)
-                        // * the part of the current new use slice that does not intersect with the tracked image (new_use_slice_rest)
-                        auto intersection = tracked_slice.state.slice.intersect(used_image_slice);
-                        auto [tracked_slice_rest, tracked_slice_rest_count] = tracked_slice.state.slice.subtract(intersection);
-                        auto [new_use_slice_rest, new_use_slice_rest_count] = used_image_slice.subtract(intersection);
-                        // We now remove the old tracked slice from the list of tracked slices, as we just split it.
-                        // We need to know if the iterator was advanced. This erase advances the iterator.
-                        // If the iterator got not advanced by this we need to advance it ourself manually later.
-                        advanced_tracked_slice_iterator = true;
-                        tracked_slice_iter = task_image.last_slice_states.erase(tracked_slice_iter);
-                        // Now we remember the left over slice from the original tracked slice.
-                        for (usize rest_i = 0; rest_i < tracked_slice_rest_count; ++rest_i)
+                // Only the intersection of the new use with each tracked slice needs to be synchronized.
+                task_image.last_slice_states.intersecting(initial_used_image_slice, tl_intersecting_tracked_slices);
+                for (ExtendedImageSliceState const & tracked_slice : tl_intersecting_tracked_slices)
+                {
+                    // The tracked slices are clipped to the new use, so their slice is the intersection.
+                    ImageMipArraySlice const intersection = tracked_slice.state.slice;
+                    // Every other access (NONE, READ_WRITE, WRITE) are interpreted as writes in this context.
+                    // When the last use was a read AND the new use of the buffer is a read AND,
+                    // we need to add our stage flags to the existing barrier of the last use.
+                    // To be able to do this the layout of the image slice must also match.
+                    // If they differ we need to insert an execution barrier with a layout transition.
+                    AccessRelation<decltype(tracked_slice)> relation{tracked_slice, current_image_access, current_access_concurrency, tracked_slice.state.latest_layout, current_image_layout};
+                    bool const cross_queue = sync_cross_queue(tracked_slice.latest_access_submit_scope_index, tracked_slice.latest_access_batch_index);
+                    // Read write concurrent and reads (implicitly concurrent) are reusing the already inserted barriers if there was a previous identical access.
+                    if (relation.are_both_concurrent_and_same_layout && !cross_queue)
+                    {
+                        // Reuse first barrier in coherent access sequence.
+                        if (auto const * index0 = daxa::get_if<LastConcurrentAccessSplitBarrierIndex>(&tracked_slice.latest_concurrent_access_barrer_index))
                         {
-                            // The rest tracked slices are the same as the original tracked slice,
-                            // except for the slice itself, which is the remainder of the subtraction of the intersection.
-                            ExtendedImageSliceState current_rest_tracked_slice = tracked_slice;
-                            current_rest_tracked_slice.state.slice = tracked_slice_rest[rest_i];
-                            tl_tracked_slice_rests.push_back(current_rest_tracked_slice);
+                            auto & last_read_split_barrier = this->split_barriers[index0->index];
+                            last_read_split_barrier.dst_access = last_read_split_barrier.dst_access | tracked_slice.state.latest_access;
                         }
-                        // Now we remember the left over slice from our current used slice.
-                        for (usize rest_i = 0; rest_i < new_use_slice_rest_count; ++rest_i)
+                        else if (auto const * index1 = daxa::get_if<LastConcurrentAccessBarrierIndex>(&tracked_slice.latest_concurrent_access_barrer_index))
                         {
-                            // We reassign the iterator here as it is getting invalidated by the insert.
-                            // The new iterator points to the newly inserted element.
-                            // When the next iteration of the outer for loop starts, all these elements get skipped.
-                            // This is good as these elements do NOT intersect with the currently inspected tracked slice.
-                            used_image_slice_iter = tl_new_use_slices.insert(
-                                tl_new_use_slices.end(),
-                                new_use_slice_rest[rest_i]);
+                            auto & last_read_barrier = this->barriers[index1->index];
+                            last_read_barrier.dst_access = last_read_barrier.dst_access | tracked_slice.state.latest_access;
                         }
-                        // Every other access (NONE, READ_WRITE, WRITE) are interpreted as writes in this context.
-                        // When the last use was a read AND the new use of the buffer is a read AND,
-                        // we need to add our stage flags to the existing barrier of the last use.
-                        // To be able to do this the layout of the image slice must also match.
-                        // If they differ we need to insert an execution barrier with a layout transition.
-                        AccessRelation<decltype(tracked_slice)> relation{tracked_slice, current_image_access, current_access_concurrency, tracked_slice.state.latest_layout, current_image_layout};
-                        // Read write concurrent and reads (implicitly concurrent) are reusing the already inserted barriers if there was a previous identical access.
-                        if (relation.are_both_concurrent_and_same_layout)
+                    }
+                    else
+                    {
+                        // When the uses are incompatible (no read on read, or no identical layout) we need to insert a new barrier.
+                        // Host access needs to be handled in a specialized way.
+                        bool const src_host_only_access = tracked_slice.state.latest_access.stages == PipelineStageFlagBits::HOST;
+                        bool const dst_host_only_access = current_image_access.stages == PipelineStageFlagBits::HOST;
+                        DAXA_DBG_ASSERT_TRUE_M(!(src_host_only_access && dst_host_only_access), "direct sync between two host accesses on gpu is not allowed");
+                        bool const is_host_barrier = src_host_only_access || dst_host_only_access;
+                        // When the distance between src and dst batch is one, we can replace the split barrier with a normal barrier.
+                        // We also need to make sure we do not use split barriers when the src or dst stage exclusively uses the host stage.
+                        // This is because the host stage does not declare an execution dependency on the cpu but only a memory dependency.
+                        // Events can not synchronize between queues, so cross queue accesses always use pipeline barriers.
+                        bool const use_pipeline_barrier =
+                            (tracked_slice.latest_access_batch_index + 1 == batch_index &&
+                             current_submit_scope_index == tracked_slice.latest_access_submit_scope_index) ||
+                            is_host_barrier || cross_queue;
+                        if (use_pipeline_barrier)
                         {
-                            // Reuse first barrier in coherent access sequence.
-                            if (auto const * index0 = daxa::get_if<LastConcurrentAccessSplitBarrierIndex>(&tracked_slice.latest_concurrent_access_barrer_index))
-                            {
-                                auto & last_read_split_barrier = this->split_barriers[index0->index];
-                                last_read_split_barrier.dst_access = last_read_split_barrier.dst_access | tracked_slice.state.latest_access;
-                            }
-                            else if (auto const * index1 = daxa::get_if<LastConcurrentAccessBarrierIndex>(&tracked_slice.latest_concurrent_access_barrer_index))
+                            usize const barrier_index = this->barriers.size();
+                            this->barriers.push_back(TaskBarrier{
+                                .image_id = used_image_t_id,
+                                .slice = intersection,
+                                .layout_before = tracked_slice.state.latest_layout,
+                                .layout_after = current_image_layout,
+                                .src_access = cross_queue ? CROSS_QUEUE_SRC_ACCESS : tracked_slice.state.latest_access,
+                                .dst_access = current_image_access,
+                            });
+                            // And we insert the barrier index into the list of pipeline barriers of the current tasks batch.
+                            batch.pipeline_barrier_indices.push_back(barrier_index);
+                            if (relation.is_current_concurrent)
                             {
-                                auto & last_read_barrier = this->barriers[index1->index];
-                                last_read_barrier.dst_access = last_read_barrier.dst_access | tracked_slice.state.latest_access;
+                                // As the new access is a read we remember our barrier index,
+                                // So that potential future reads after this can reuse this barrier.
+                                ret_new_use_tracked_slice.latest_concurrent_access_barrer_index = LastConcurrentAccessBarrierIndex{barrier_index};
                             }
                         }
                         else
                         {
-                            // When the uses are incompatible (no read on read, or no identical layout) we need to insert a new barrier.
-                            // Host access needs to be handled in a specialized way.
-                            bool const src_host_only_access = tracked_slice.state.latest_access.stages == PipelineStageFlagBits::HOST;
-                            bool const dst_host_only_access = current_image_access.stages == PipelineStageFlagBits::HOST;
-                            DAXA_DBG_ASSERT_TRUE_M(!(src_host_only_access && dst_host_only_access), "direct sync between two host accesses on gpu is not allowed");
-                            bool const is_host_barrier = src_host_only_access || dst_host_only_access;
-                            // When the distance between src and dst batch is one, we can replace the split barrier with a normal barrier.
-                            // We also need to make sure we do not use split barriers when the src or dst stage exclusively uses the host stage.
-                            // This is because the host stage does not declare an execution dependency on the cpu but only a memory dependency.
-                            bool const use_pipeline_barrier =
-                                (tracked_slice.latest_access_batch_index + 1 == batch_index &&
-                                 current_submit_scope_index == tracked_slice.latest_access_submit_scope_index) ||
-                                is_host_barrier;
-                            if (use_pipeline_barrier)
-                            {
-                                usize const barrier_index = this->barriers.size();
-                                this->barriers.push_back(TaskBarrier{
+                            usize const split_barrier_index = this->split_barriers.size();
+                            this->split_barriers.push_back(TaskSplitBarrier{
+                                {
                                     .image_id = used_image_t_id,
                                     .slice = intersection,
                                     .layout_before = tracked_slice.state.latest_layout,
                                     .layout_after = current_image_layout,
                                     .src_access = tracked_slice.state.latest_access,
                                     .dst_access = current_image_access,
-                                });
-                                // And we insert the barrier index into the list of pipeline barriers of the current tasks batch.
-                                batch.pipeline_barrier_indices.push_back(barrier_index);
-                                if (relation.is_current_concurrent)
-                                {
-                                    // As the new access is a read we remember our barrier index,
-                                    // So that potential future reads after this can reuse this barrier.
-                                    ret_new_use_tracked_slice.latest_concurrent_access_barrer_index = LastConcurrentAccessBarrierIndex{barrier_index};
-                                }
-                            }
-                            else
+                                },
+                                /* .split_barrier_state = */ task_graph_impl.info.device.create_event({
+                                    .name = std::string("tg \"") + task_graph_impl.info.name + "\" sbi " + std::to_string(split_barrier_index),
+                                }),
+                            });
+                            // Now we give the src batch the index of this barrier to signal.
+                            TaskBatch & src_batch = this->batch(tracked_slice.latest_access_submit_scope_index, tracked_slice.latest_access_batch_index);
+                            src_batch.signal_split_barrier_indices.push_back(split_barrier_index);
+                            // And we also insert the split barrier index into the waits of the current tasks batch.
+                            batch.wait_split_barrier_indices.push_back(split_barrier_index);
+                            if (relation.is_current_concurrent)
                             {
-                                usize const split_barrier_index = this->split_barriers.size();
-                                this->split_barriers.push_back(TaskSplitBarrier{
-                                    {
-                                        .image_id = used_image_t_id,
-                                        .slice = intersection,
-                                        .layout_before = tracked_slice.state.latest_layout,
-                                        .layout_after = current_image_layout,
-                                        .src_access = tracked_slice.state.latest_access,
-                                        .dst_access = current_image_access,
-                                    },
-                                    /* .split_barrier_state = */ task_graph_impl.info.device.create_event({
-                                        .name = std::string("tg \"") + task_graph_impl.info.name + "\" sbi " + std::to_string(split_barrier_index),
-                                    }),
-                                });
-                                // Now we give the src batch the index of this barrier to signal.
-                                TaskBatchSubmitScope & src_scope = this->batch_submit_scopes[tracked_slice.latest_access_submit_scope_index];
-                                TaskBatch & src_batch = src_scope.task_batches[tracked_slice.latest_access_batch_index];
-                                src_batch.signal_split_barrier_indices.push_back(split_barrier_index);
-                                // And we also insert the split barrier index into the waits of the current tasks batch.
-                                batch.wait_split_barrier_indices.push_back(split_barrier_index);
-                                if (relation.is_current_concurrent)
-                                {
-                                    // Need to remember the first concurrent access.
-                                    // In case of multiple concurrent accesses following on each other, the first barrier in the sequence can be reused for all accesses.
-                                    ret_new_use_tracked_slice.latest_concurrent_access_barrer_index = LastConcurrentAccessSplitBarrierIndex{split_barrier_index};
-                                }
+                                // Need to remember the first concurrent access.
+                                // In case of multiple concurrent accesses following on each other, the first barrier in the sequence can be reused for all accesses.
+                                ret_new_use_tracked_slice.latest_concurrent_access_barrer_index = LastConcurrentAccessSplitBarrierIndex{split_barrier_index};
                             }
                         }
-                        // Make sure we have any tracked slices to intersect with left.
-                        if (tracked_slice_iter == task_image.last_slice_states.end())
-                        {
-                            break;
-                        }
-                    }
-                    if (!advanced_tracked_slice_iterator)
-                    {
-                        // If we didn't find any intersections, we dont remove the tracked slice.
-                        // Erasing a tracked slice "advances" iterator. As we did not remove,
-                        // we need to advance it manually.
-                        ++tracked_slice_iter;
                     }
                 }
-                tl_new_use_slices.clear();
-                // Now we need to add the latest use and tracked range of our current access:
-                task_image.last_slice_states.push_back(ret_new_use_tracked_slice);
-                // The remainder tracked slices we remembered from earlier are now inserted back into the list of tracked slices.
-                // We deferred this step as we dont want to check these in the loop above, as we found them to not intersect with the new use.
-                task_image.last_slice_states.insert(
-                    task_image.last_slice_states.end(),
-                    tl_tracked_slice_rests.begin(),
-                    tl_tracked_slice_rests.end());
-                tl_tracked_slice_rests.clear();
+                tl_intersecting_tracked_slices.clear();
+                // Now the latest use replaces the tracked states of the used subresources.
+                // Neighboring subresources in the same state are merged with it.
+                task_image.last_slice_states.insert(ret_new_use_tracked_slice);
             });
     }
 
@@ -2172,11 +2737,7 @@ namespace daxa
     {
         auto & impl = *r_cast<ImplTaskGraph *>(this->object);
         DAXA_DBG_ASSERT_TRUE_M(!impl.compiled, "completed task graphs can not record new tasks");
-
-        for (auto & permutation : impl.record_active_permutations)
-        {
-            permutation->submit(info);
-        }
+        impl.record_command(info);
     }
 
     void TaskGraphPermutation::submit(TaskSubmitInfo const & info)
@@ -2186,7 +2747,7 @@ namespace daxa
         // We provide the user submit info to the submit batch.
         submit_scope.user_submit_info = info;
         // Start a new batch.
-        this->batch_submit_scopes.emplace_back();
+        this->batch_submit_scopes.push_back(TaskBatchSubmitScope{.first_batch_index = this->task_batches.size()});
     }
 
     void TaskGraph::present(TaskPresentInfo const & info)
@@ -2194,11 +2755,7 @@ namespace daxa
         auto & impl = *r_cast<ImplTaskGraph *>(this->object);
         DAXA_DBG_ASSERT_TRUE_M(!impl.compiled, "completed task graphs can not record new tasks");
         DAXA_DBG_ASSERT_TRUE_M(impl.info.swapchain.has_value(), "can only present, when a swapchain was provided in creation");
-
-        for (auto & permutation : impl.record_active_permutations)
-        {
-            permutation->present(info);
-        }
+        impl.record_command(info);
     }
 
     void TaskGraphPermutation::present(TaskPresentInfo const & info)
@@ -2209,14 +2766,19 @@ namespace daxa
         this->image_infos[this->swapchain_image.index].swapchain_semaphore_waited_upon = true;
 
         ExtendedImageSliceState const default_slice;
-        ExtendedImageSliceState const * tracked_slice = {};
-        if (this->image_infos[this->swapchain_image.index].last_slice_states.empty())
-        {
-            tracked_slice = &default_slice;
-        }
-        else
+        ExtendedImageSliceState const * tracked_slice = &default_slice;
+        std::vector<ExtendedImageSliceState> swapchain_slices = {};
+        this->image_infos[this->swapchain_image.index].last_slice_states.slices(swapchain_slices);
+        // The barrier to present src is inserted after the latest use of the swapchain image.
+        for (auto const & swapchain_slice : swapchain_slices)
         {
-            tracked_slice = &this->image_infos[this->swapchain_image.index].last_slice_states.back();
+            if (tracked_slice == &default_slice ||
+                swapchain_slice.latest_access_submit_scope_index > tracked_slice->latest_access_submit_scope_index ||
+                (swapchain_slice.latest_access_submit_scope_index == tracked_slice->latest_access_submit_scope_index &&
+                 swapchain_slice.latest_access_batch_index > tracked_slice->latest_access_batch_index))
+            {
+                tracked_slice = &swapchain_slice;
+            }
         }
         usize const submit_scope_index = tracked_slice->latest_access_submit_scope_index;
         DAXA_DBG_ASSERT_TRUE_M(submit_scope_index < this->batch_submit_scopes.size() - 1, "the last swapchain image use MUST be before the last submit when presenting");
@@ -2238,7 +2800,7 @@ namespace daxa
         };
     }
 
-    void ImplTaskGraph::create_transient_runtime_buffers(TaskGraphPermutation & permutation)
+    void ImplTaskGraph::create_transient_runtime_buffers(TaskGraphPermutation & permutation, MemoryBlock & memory_block)
     {
         for (u32 buffer_info_idx = 0; buffer_info_idx < u32(global_buffer_infos.size()); buffer_info_idx++)
         {
@@ -2254,14 +2816,14 @@ namespace daxa
                         .size = transient_info.info.size,
                         .name = transient_info.info.name,
                     },
-                    .memory_block = transient_data_memory_block,
+                    .memory_block = memory_block,
                     .offset = perm_buffer.allocation_offset,
                 });
             }
         }
     }
 
-    void ImplTaskGraph::create_transient_runtime_images(TaskGraphPermutation & permutation)
+    void ImplTaskGraph::create_transient_runtime_images(TaskGraphPermutation & permutation, MemoryBlock & memory_block)
     {
         for (u32 image_info_idx = 0; image_info_idx < u32(global_image_infos.size()); image_info_idx++)
         {
@@ -2286,344 +2848,1262 @@ namespace daxa
                             .array_layer_count = transient_image_info.array_layer_count,
                             .sample_count = transient_image_info.sample_count,
                             .usage = perm_image.usage,
+                            .sharing_mode = perm_image.used_on_async_queue ? SharingMode::CONCURRENT : SharingMode::EXCLUSIVE,
                             .name = transient_image_info.name,
                         },
-                        .memory_block = transient_data_memory_block,
+                        .memory_block = memory_block,
                         .offset = perm_image.allocation_offset,
                     });
             }
         }
     }
 
-    void ImplTaskGraph::allocate_transient_resources()
+    // Creates the transient buffers and images of the permutation once per frame in flight, each frame in its own memory block.
+    void ImplTaskGraph::create_transient_runtime_resources(TaskGraphPermutation & permutation, std::span<MemoryBlock> memory_blocks)
     {
-        usize transient_resource_count = 0;
-        usize max_alignment_requirement = 0;
-        for (auto & permutation : permutations)
+        permutation.transient_frames.clear();
+        permutation.transient_frames.resize(memory_blocks.size());
+        for (usize frame_index = 0; frame_index < memory_blocks.size(); ++frame_index)
         {
-            for (u32 image_i = 0; image_i < permutation.image_infos.size(); ++image_i)
-            {
-                PerPermTaskImage & permut_image = permutation.image_infos[image_i];
-                PermIndepTaskImageInfo & global_image = global_image_infos[image_i];
-                if (!global_image.is_persistent())
-                {
-                    transient_resource_count += 1;
-                    TaskTransientImageInfo trans_img_info = daxa::get<PermIndepTaskImageInfo::Transient>(global_image.task_image_data).info;
-                    ImageInfo image_info{
-                        // .flags = trans_img_info.flags,
-                        .dimensions = trans_img_info.dimensions,
-                        .format = trans_img_info.format,
-                        .size = trans_img_info.size,
-                        .mip_level_count = trans_img_info.mip_level_count,
-                        .array_layer_count = trans_img_info.array_layer_count,
-                        .sample_count = trans_img_info.sample_count,
-                        .usage = permut_image.usage,
-                        .allocate_info = MemoryFlagBits::DEDICATED_MEMORY,
-                        .name = "Dummy to figure mem requirements",
-                    };
-                    permut_image.memory_requirements = info.device.memory_requirements({image_info});
-                    max_alignment_requirement = std::max(permut_image.memory_requirements.alignment, max_alignment_requirement);
+            create_transient_runtime_buffers(permutation, memory_blocks[frame_index]);
+            create_transient_runtime_images(permutation, memory_blocks[frame_index]);
+            TransientFrameResources & frame = permutation.transient_frames[frame_index];
+            frame.buffers.resize(permutation.buffer_infos.size());
+            frame.images.resize(permutation.image_infos.size());
+            for (u32 buffer_info_idx = 0; buffer_info_idx < u32(global_buffer_infos.size()); buffer_info_idx++)
+            {
+                auto const & perm_buffer = permutation.buffer_infos.at(buffer_info_idx);
+                if (!global_buffer_infos.at(buffer_info_idx).is_persistent() && perm_buffer.valid)
+                {
+                    frame.buffers[buffer_info_idx] = std::get<BufferId>(perm_buffer.actual_id);
                 }
             }
-            for (u32 buffer_i = 0; buffer_i < permutation.buffer_infos.size(); ++buffer_i)
+            for (u32 image_info_idx = 0; image_info_idx < u32(global_image_infos.size()); image_info_idx++)
             {
-                PerPermTaskBuffer & permut_buffer = permutation.buffer_infos[buffer_i];
-                PermIndepTaskBufferInfo & global_buffer = global_buffer_infos[buffer_i];
-                if (!global_buffer.is_persistent())
+                auto const & perm_image = permutation.image_infos.at(image_info_idx);
+                if (!global_image_infos.at(image_info_idx).is_persistent() && perm_image.valid)
                 {
-                    transient_resource_count += 1;
-                    TaskTransientBufferInfo trans_buf_info = daxa::get<PermIndepTaskBufferInfo::Transient>(global_buffer.task_buffer_data).info;
-                    BufferInfo buffer_info{
-                        .size = trans_buf_info.size,
-                        .allocate_info = MemoryFlagBits::DEDICATED_MEMORY,
-                        .name = "Dummy to figure mem requirements",
-                    };
-                    permut_buffer.memory_requirements = info.device.memory_requirements({buffer_info});
-                    max_alignment_requirement = std::max(permut_buffer.memory_requirements.alignment, max_alignment_requirement);
+                    frame.images[image_info_idx] = perm_image.actual_image;
                 }
             }
         }
-        if (transient_resource_count == 0)
+        activate_transient_frame(permutation, transient_frame_index);
+    }
+
+    // Points the transient resources of the permutation to the runtime resources of the given frame in flight.
+    void ImplTaskGraph::activate_transient_frame(TaskGraphPermutation & permutation, u32 frame_index)
+    {
+        if (permutation.transient_frames.empty())
         {
             return;
         }
-
-        // for each permutation figure out the max memory requirements
-        for (auto & permutation : permutations)
+        TransientFrameResources const & frame = permutation.transient_frames[frame_index % permutation.transient_frames.size()];
+        for (u32 buffer_info_idx = 0; buffer_info_idx < u32(global_buffer_infos.size()); buffer_info_idx++)
         {
-            usize batches = 0;
-            std::vector<usize> submit_batch_offsets(permutation.batch_submit_scopes.size());
-            for (u32 submit_scope_idx = 0; submit_scope_idx < permutation.batch_submit_scopes.size(); submit_scope_idx++)
+            auto & perm_buffer = permutation.buffer_infos.at(buffer_info_idx);
+            if (!global_buffer_infos.at(buffer_info_idx).is_persistent() && perm_buffer.valid)
             {
-                submit_batch_offsets.at(submit_scope_idx) = batches;
-                batches += permutation.batch_submit_scopes.at(submit_scope_idx).task_batches.size();
+                perm_buffer.actual_id = frame.buffers[buffer_info_idx];
             }
-
-            struct LifetimeLengthResource
+        }
+        for (u32 image_info_idx = 0; image_info_idx < u32(global_image_infos.size()); image_info_idx++)
+        {
+            auto & perm_image = permutation.image_infos.at(image_info_idx);
+            if (!global_image_infos.at(image_info_idx).is_persistent() && perm_image.valid)
             {
-                usize start_batch;
-                usize end_batch;
-                usize lifetime_length;
-                bool is_image;
-                u32 resource_idx;
-            };
+                perm_image.actual_image = frame.images[image_info_idx];
+            }
+        }
+    }
 
-            std::vector<LifetimeLengthResource> lifetime_length_sorted_resources;
+    auto ImplTaskGraph::transient_memory_requirements(ImageInfo const & image_info) -> MemoryRequirements
+    {
+        TransientMemoryRequirementsKey const key = {
+            1ull,
+            static_cast<u64>(image_info.format) | (static_cast<u64>(image_info.dimensions) << 32ull),
+            static_cast<u64>(image_info.size.x) | (static_cast<u64>(image_info.size.y) << 32ull),
+            static_cast<u64>(image_info.size.z) | (static_cast<u64>(image_info.mip_level_count) << 32ull),
+            static_cast<u64>(image_info.array_layer_count) | (static_cast<u64>(image_info.sample_count) << 32ull),
+            static_cast<u64>(image_info.usage.data),
+            static_cast<u64>(image_info.sharing_mode),
+        };
+        auto iter = transient_memory_requirements_cache.find(key);
+        if (iter == transient_memory_requirements_cache.end())
+        {
+            transient_memory_statistics.memory_requirements_cache_misses += 1;
+            iter = transient_memory_requirements_cache.emplace(key, info.device.memory_requirements(image_info)).first;
+        }
+        else
+        {
+            transient_memory_statistics.memory_requirements_cache_hits += 1;
+        }
+        return iter->second;
+    }
 
-            for (u32 perm_image_idx = 0; perm_image_idx < permutation.image_infos.size(); perm_image_idx++)
-            {
-                if (global_image_infos.at(perm_image_idx).is_persistent() || !permutation.image_infos.at(perm_image_idx).valid)
-                {
-                    continue;
-                }
+    auto ImplTaskGraph::transient_memory_requirements(BufferInfo const & buffer_info) -> MemoryRequirements
+    {
+        TransientMemoryRequirementsKey const key = {0ull, static_cast<u64>(buffer_info.size)};
+        auto iter = transient_memory_requirements_cache.find(key);
+        if (iter == transient_memory_requirements_cache.end())
+        {
+            transient_memory_statistics.memory_requirements_cache_misses += 1;
+            iter = transient_memory_requirements_cache.emplace(key, info.device.memory_requirements(buffer_info)).first;
+        }
+        else
+        {
+            transient_memory_statistics.memory_requirements_cache_hits += 1;
+        }
+        return iter->second;
+    }
 
-                auto const & perm_task_image = permutation.image_infos.at(perm_image_idx);
+    struct TransientPlacementResource
+    {
+        usize start_batch = {};
+        usize end_batch = {};
+        usize size = {};
+        usize alignment = {};
+        u32 memory_type_bits = {};
+        bool is_image = {};
+        u32 resource_idx = {};
+    };
 
-                if (perm_task_image.lifetime.first_use.submit_scope_index == std::numeric_limits<u32>::max() ||
-                    perm_task_image.lifetime.last_use.submit_scope_index == std::numeric_limits<u32>::max())
+    // Places the resources in the given order. Each resource goes into the smallest gap between the resources it overlaps with in time,
+    // or behind all of them when no gap is large enough. Returns the offsets of the resources and the size of the placement.
+    auto place_transient_resources_best_fit(std::vector<TransientPlacementResource> const & resources, std::vector<u32> const & order, bool alias) -> std::pair<std::vector<usize>, usize>
+    {
+        std::vector<usize> offsets(resources.size());
+        std::vector<u32> placed = {};
+        std::vector<std::pair<usize, usize>> occupied = {};
+        usize placement_size = 0;
+        for (u32 const resource_index : order)
+        {
+            TransientPlacementResource const & resource = resources[resource_index];
+            occupied.clear();
+            for (u32 const placed_index : placed)
+            {
+                TransientPlacementResource const & other = resources[placed_index];
+                bool const lifetimes_overlap = !alias || (other.start_batch <= resource.end_batch && resource.start_batch <= other.end_batch);
+                if (lifetimes_overlap)
                 {
-                    // TODO(msakmary) Transient image created but not used - should we somehow warn the user about this?
-                    permutation.image_infos.at(perm_image_idx).valid = false;
-                    continue;
+                    occupied.emplace_back(offsets[placed_index], offsets[placed_index] + other.size);
                 }
-
-                usize const start_idx = submit_batch_offsets.at(perm_task_image.lifetime.first_use.submit_scope_index) +
-                                        perm_task_image.lifetime.first_use.task_batch_index;
-                usize const end_idx = submit_batch_offsets.at(perm_task_image.lifetime.last_use.submit_scope_index) +
-                                      perm_task_image.lifetime.last_use.task_batch_index;
-
-                lifetime_length_sorted_resources.emplace_back(LifetimeLengthResource{
-                    .start_batch = start_idx,
-                    .end_batch = end_idx,
-                    .lifetime_length = end_idx - start_idx + 1,
-                    .is_image = true,
-                    .resource_idx = perm_image_idx,
-                });
             }
-
-            for (u32 perm_buffer_idx = 0; perm_buffer_idx < permutation.buffer_infos.size(); perm_buffer_idx++)
+            std::sort(occupied.begin(), occupied.end());
+            usize best_offset = std::numeric_limits<usize>::max();
+            usize best_gap = std::numeric_limits<usize>::max();
+            usize occupied_end = 0;
+            for (auto const & [begin, end] : occupied)
             {
-                if (global_buffer_infos.at(perm_buffer_idx).is_persistent())
-                {
-                    continue;
-                }
-
-                auto const & perm_task_buffer = permutation.buffer_infos.at(perm_buffer_idx);
-
-                if (perm_task_buffer.lifetime.first_use.submit_scope_index == std::numeric_limits<u32>::max() ||
-                    perm_task_buffer.lifetime.last_use.submit_scope_index == std::numeric_limits<u32>::max())
+                usize const aligned_offset = (occupied_end + resource.alignment - 1) / resource.alignment * resource.alignment;
+                if (begin > aligned_offset && begin - aligned_offset >= resource.size && begin - aligned_offset < best_gap)
                 {
-                    // TODO(msakmary) Transient buffer created but not used - should we somehow warn the user about this?
-                    permutation.buffer_infos.at(perm_buffer_idx).valid = false;
-                    continue;
+                    best_gap = begin - aligned_offset;
+                    best_offset = aligned_offset;
                 }
-
-                usize const start_idx = submit_batch_offsets.at(perm_task_buffer.lifetime.first_use.submit_scope_index) +
-                                        perm_task_buffer.lifetime.first_use.task_batch_index;
-                usize const end_idx = submit_batch_offsets.at(perm_task_buffer.lifetime.last_use.submit_scope_index) +
-                                      perm_task_buffer.lifetime.last_use.task_batch_index;
-
-                lifetime_length_sorted_resources.emplace_back(LifetimeLengthResource{
-                    .start_batch = start_idx,
-                    .end_batch = end_idx,
-                    .lifetime_length = end_idx - start_idx + 1,
-                    .is_image = false,
-                    .resource_idx = perm_buffer_idx,
-                });
+                occupied_end = std::max(occupied_end, end);
             }
+            if (best_offset == std::numeric_limits<usize>::max())
+            {
+                best_offset = (occupied_end + resource.alignment - 1) / resource.alignment * resource.alignment;
+            }
+            offsets[resource_index] = best_offset;
+            placement_size = std::max(placement_size, best_offset + resource.size);
+            placed.push_back(resource_index);
+        }
+        return {std::move(offsets), placement_size};
+    }
 
-            std::sort(lifetime_length_sorted_resources.begin(), lifetime_length_sorted_resources.end(),
-                      [](LifetimeLengthResource const & first, LifetimeLengthResource const & second) -> bool
-                      {
-                          return first.lifetime_length > second.lifetime_length;
-                      });
-
-            struct Allocation
+    auto ImplTaskGraph::place_transient_resources(TaskGraphPermutation & permutation) -> MemoryRequirements
+    {
+        MemoryRequirements ret = {.size = 0, .alignment = 0, .memory_type_bits = ~0u};
+        for (u32 image_i = 0; image_i < permutation.image_infos.size(); ++image_i)
+        {
+            PerPermTaskImage & permut_image = permutation.image_infos[image_i];
+            PermIndepTaskImageInfo & global_image = global_image_infos[image_i];
+            if (!global_image.is_persistent() && permut_image.valid)
             {
-                usize offset = {};
-                usize size = {};
-                usize start_batch = {};
-                usize end_batch = {};
-                bool is_image = {};
-                u32 owning_resource_idx = {};
-                u32 memory_type_bits = {};
-                ImageMipArraySlice intersection_object = {};
-            };
-            // Sort allocations in the set in the following way
-            //      1) sort by offsets into the memory block
-            //  if equal:
-            //      2) sort by start batch of the allocation
-            //  if equal:
-            //      3) sort by owning image index
-            struct AllocCompare
+                TaskTransientImageInfo trans_img_info = daxa::get<PermIndepTaskImageInfo::Transient>(global_image.task_image_data).info;
+                ImageInfo image_info{
+                    // .flags = trans_img_info.flags,
+                    .dimensions = trans_img_info.dimensions,
+                    .format = trans_img_info.format,
+                    .size = trans_img_info.size,
+                    .mip_level_count = trans_img_info.mip_level_count,
+                    .array_layer_count = trans_img_info.array_layer_count,
+                    .sample_count = trans_img_info.sample_count,
+                    .usage = permut_image.usage,
+                    .sharing_mode = permut_image.used_on_async_queue ? SharingMode::CONCURRENT : SharingMode::EXCLUSIVE,
+                    .allocate_info = MemoryFlagBits::DEDICATED_MEMORY,
+                    .name = "Dummy to figure mem requirements",
+                };
+                permut_image.memory_requirements = transient_memory_requirements(image_info);
+                ret.alignment = std::max(permut_image.memory_requirements.alignment, ret.alignment);
+            }
+        }
+        for (u32 buffer_i = 0; buffer_i < permutation.buffer_infos.size(); ++buffer_i)
+        {
+            PerPermTaskBuffer & permut_buffer = permutation.buffer_infos[buffer_i];
+            PermIndepTaskBufferInfo & global_buffer = global_buffer_infos[buffer_i];
+            if (!global_buffer.is_persistent() && permut_buffer.valid)
             {
-                constexpr auto operator()(Allocation const & first, Allocation const & second) const -> bool
-                {
-                    if (first.offset < second.offset)
+                TaskTransientBufferInfo trans_buf_info = daxa::get<PermIndepTaskBufferInfo::Transient>(global_buffer.task_buffer_data).info;
+                BufferInfo buffer_info{
+                    .size = trans_buf_info.size,
+                    .allocate_info = MemoryFlagBits::DEDICATED_MEMORY,
+                    .name = "Dummy to figure mem requirements",
+                };
+                permut_buffer.memory_requirements = transient_memory_requirements(buffer_info);
+                ret.alignment = std::max(permut_buffer.memory_requirements.alignment, ret.alignment);
+            }
+        }
+
+        // figure out where each transient lives and how much memory this permutation requires
+        usize const batches = permutation.task_batches.size();
+
+        std::vector<TransientPlacementResource> resources = {};
+        auto const add_resource = [&](ResourceLifetime const & lifetime, bool used_on_async_queue, MemoryRequirements const & mem_requirements, bool is_image, u32 resource_idx)
+        {
+            usize start_idx = permutation.batch_submit_scopes.at(lifetime.first_use.submit_scope_index).first_batch_index + lifetime.first_use.task_batch_index;
+            usize end_idx = permutation.batch_submit_scopes.at(lifetime.last_use.submit_scope_index).first_batch_index + lifetime.last_use.task_batch_index;
+            // Batches on different queues overlap, so resources used on async queues live for the whole graph.
+            if (used_on_async_queue)
+            {
+                start_idx = 0;
+                end_idx = batches - 1;
+            }
+            resources.push_back(TransientPlacementResource{
+                .start_batch = start_idx,
+                .end_batch = end_idx,
+                .size = mem_requirements.size,
+                .alignment = std::max(mem_requirements.alignment, static_cast<usize>(1ull)),
+                .memory_type_bits = mem_requirements.memory_type_bits,
+                .is_image = is_image,
+                .resource_idx = resource_idx,
+            });
+        };
+
+        for (u32 perm_image_idx = 0; perm_image_idx < permutation.image_infos.size(); perm_image_idx++)
+        {
+            if (global_image_infos.at(perm_image_idx).is_persistent() || !permutation.image_infos.at(perm_image_idx).valid)
+            {
+                continue;
+            }
+
+            auto const & perm_task_image = permutation.image_infos.at(perm_image_idx);
+
+            if (perm_task_image.lifetime.first_use.submit_scope_index == std::numeric_limits<u32>::max() ||
+                perm_task_image.lifetime.last_use.submit_scope_index == std::numeric_limits<u32>::max())
+            {
+                // TODO(msakmary) Transient image created but not used - should we somehow warn the user about this?
+                permutation.image_infos.at(perm_image_idx).valid = false;
+                continue;
+            }
+            add_resource(perm_task_image.lifetime, perm_task_image.used_on_async_queue, perm_task_image.memory_requirements, true, perm_image_idx);
+        }
+
+        for (u32 perm_buffer_idx = 0; perm_buffer_idx < permutation.buffer_infos.size(); perm_buffer_idx++)
+        {
+            if (global_buffer_infos.at(perm_buffer_idx).is_persistent())
+            {
+                continue;
+            }
+
+            auto const & perm_task_buffer = permutation.buffer_infos.at(perm_buffer_idx);
+
+            if (perm_task_buffer.lifetime.first_use.submit_scope_index == std::numeric_limits<u32>::max() ||
+                perm_task_buffer.lifetime.last_use.submit_scope_index == std::numeric_limits<u32>::max())
+            {
+                // TODO(msakmary) Transient buffer created but not used - should we somehow warn the user about this?
+                permutation.buffer_infos.at(perm_buffer_idx).valid = false;
+                continue;
+            }
+            add_resource(perm_task_buffer.lifetime, perm_task_buffer.used_on_async_queue, perm_task_buffer.memory_requirements, false, perm_buffer_idx);
+        }
+
+        // The most bytes alive within one batch is a lower bound for the memory any placement needs.
+        std::vector<usize> live_bytes(batches);
+        permutation.transient_unaliased_bytes = 0;
+        for (auto const & resource : resources)
+        {
+            for (usize batch = resource.start_batch; batch <= resource.end_batch; ++batch)
+            {
+                live_bytes[batch] += resource.size;
+            }
+            permutation.transient_unaliased_bytes += resource.size;
+            ret.memory_type_bits = ret.memory_type_bits & resource.memory_type_bits;
+        }
+        permutation.transient_peak_live_bytes = live_bytes.empty() ? 0 : *std::max_element(live_bytes.begin(), live_bytes.end());
+
+        // Best fit placement depends on the order resources are placed in.
+        // Placing large resources first leaves small gaps for small resources, placing long lived resources first keeps them out of the way of short lived ones.
+        // Both orders are tried and the smaller placement is kept.
+        std::vector<u32> size_order(resources.size());
+        for (u32 i = 0; i < size_order.size(); ++i)
+        {
+            size_order[i] = i;
+        }
+        std::vector<u32> lifetime_order = size_order;
+        auto const lifetime_length = [&](u32 i)
+        { return resources[i].end_batch - resources[i].start_batch; };
+        std::stable_sort(size_order.begin(), size_order.end(), [&](u32 a, u32 b)
+                         { return resources[a].size != resources[b].size ? resources[a].size > resources[b].size : lifetime_length(a) > lifetime_length(b); });
+        std::stable_sort(lifetime_order.begin(), lifetime_order.end(), [&](u32 a, u32 b)
+                         { return lifetime_length(a) != lifetime_length(b) ? lifetime_length(a) > lifetime_length(b) : resources[a].size > resources[b].size; });
+        auto placement = place_transient_resources_best_fit(resources, size_order, info.alias_transients);
+        if (info.alias_transients)
+        {
+            auto lifetime_placement = place_transient_resources_best_fit(resources, lifetime_order, info.alias_transients);
+            if (lifetime_placement.second < placement.second)
+            {
+                placement = std::move(lifetime_placement);
+            }
+        }
+        auto const & [offsets, placement_size] = placement;
+        for (usize resource_index = 0; resource_index < resources.size(); ++resource_index)
+        {
+            auto const & resource = resources[resource_index];
+            if (resource.is_image)
+            {
+                permutation.image_infos.at(resource.resource_idx).allocation_offset = offsets[resource_index];
+            }
+            else
+            {
+                permutation.buffer_infos.at(resource.resource_idx).allocation_offset = offsets[resource_index];
+            }
+        }
+        ret.size = placement_size;
+        return ret;
+    }
+
+    void ImplTaskGraph::allocate_transient_resources()
+    {
+        MemoryRequirements block_requirements = {.size = 0, .alignment = 0, .memory_type_bits = 0xFFFFFFFFu};
+        for (auto & permutation : permutations)
+        {
+            MemoryRequirements const requirements = place_transient_resources(permutation);
+            block_requirements.size = std::max(block_requirements.size, requirements.size);
+            block_requirements.alignment = std::max(block_requirements.alignment, requirements.alignment);
+            block_requirements.memory_type_bits = block_requirements.memory_type_bits & requirements.memory_type_bits;
+        }
+        allocate_transient_memory(block_requirements);
+    }
+
+    // Creates the memory shared by the transient resources of all permutations, once per frame in flight, or grows the transient heap to fit them.
+    void ImplTaskGraph::allocate_transient_memory(MemoryRequirements const & requirements)
+    {
+        memory_block_size = static_cast<usize>(requirements.size);
+        memory_block_alignment = static_cast<usize>(requirements.alignment);
+        memory_type_bits = requirements.memory_type_bits;
+        transient_data_memory_blocks = std::vector<MemoryBlock>(info.frames_in_flight);
+        if (memory_block_size == 0)
+        {
+            return;
+        }
+
+        if (ImplTransientHeap * heap = transient_heap())
+        {
+            heap->reserve(requirements);
+            return;
+        }
+        for (auto & memory_block : transient_data_memory_blocks)
+        {
+            memory_block = info.device.create_memory({
+                .requirements = requirements,
+                .flags = MemoryFlagBits::DEDICATED_MEMORY,
+            });
+        }
+    }
+
+    auto ImplTaskGraph::transient_heap() const -> ImplTransientHeap *
+    {
+        if (!info.transient_heap.has_value())
+        {
+            return nullptr;
+        }
+        return r_cast<ImplTransientHeap *>(info.transient_heap->get());
+    }
+
+    // Another graph sharing the heap may have grown it since the transient resources were created.
+    // The resources of the permutation are then recreated in the new memory block.
+    void ImplTaskGraph::update_transient_heap_resources(TaskGraphPermutation & permutation)
+    {
+        ImplTransientHeap * heap = transient_heap();
+        if (heap == nullptr || permutation.transient_heap_generation == heap->generation)
+        {
+            return;
+        }
+        // The device defers the destruction until the gpu is done with the previous executions.
+        destroy_transient_runtime_resources(permutation);
+        create_transient_runtime_resources(permutation, {&heap->memory_block, 1});
+        permutation.transient_heap_generation = heap->generation;
+    }
+
+    void TaskGraph::complete(TaskCompleteInfo const & info)
+    {
+        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
+        DAXA_DBG_ASSERT_TRUE_M(!impl.compiled, "task graphs can only be completed once");
+        impl.compiled = true;
+        // Jit permutations are compiled on their first execution.
+        if (impl.info.jit_compile_permutations)
+        {
+            return;
+        }
+
+        impl.loaded_serialized_permutations = !info.serialized_permutations.empty() && impl.load_serialized_permutations(info.serialized_permutations);
+        if (!impl.loaded_serialized_permutations)
+        {
+            impl.permutations.resize(usize{1} << impl.info.permutation_condition_count);
+            for (u32 permutation_index = 0; permutation_index < impl.permutations.size(); ++permutation_index)
+            {
+                impl.compile_permutation(impl.permutations[permutation_index], permutation_index, impl.info.minimize_barriers && impl.info.reorder_tasks);
+            }
+            impl.allocate_transient_resources();
+        }
+        ImplTransientHeap * heap = impl.transient_heap();
+        std::span<MemoryBlock> const memory_blocks = heap != nullptr ? std::span<MemoryBlock>{&heap->memory_block, 1} : std::span<MemoryBlock>{impl.transient_data_memory_blocks};
+        for (auto & permutation : impl.permutations)
+        {
+            if (impl.loaded_serialized_permutations)
+            {
+                // The serialized permutations already contain the transient initialization barriers.
+                impl.create_transient_runtime_resources(permutation, memory_blocks);
+            }
+            else
+            {
+                impl.complete_permutation(permutation, memory_blocks);
+            }
+            if (heap != nullptr)
+            {
+                permutation.transient_heap_generation = heap->generation;
+            }
+        }
+    }
+
+    // Merges the pipeline barriers of each batch, so that each batch records a single pipeline barrier command.
+    void merge_batch_barriers(ImplTaskGraph const & impl, TaskGraphPermutation & permutation)
+    {
+        for (auto & task_batch : permutation.task_batches)
+        {
+            task_batch.merged_memory_barrier = {};
+            task_batch.merged_image_barriers.clear();
+            auto const merge = [&](TaskBarrier const & barrier)
+            {
+                if (barrier.image_id.is_empty())
+                {
+                    MemoryBarrierInfo & merged = task_batch.merged_memory_barrier.has_value() ? task_batch.merged_memory_barrier.value() : task_batch.merged_memory_barrier.emplace();
+                    merged.src_access = merged.src_access | barrier.src_access;
+                    merged.dst_access = merged.dst_access | barrier.dst_access;
+                }
+                else
+                {
+                    task_batch.merged_image_barriers.push_back(barrier);
+                }
+            };
+            for (usize const barrier_index : task_batch.pipeline_barrier_indices)
+            {
+                merge(permutation.barriers[barrier_index]);
+            }
+            // Without split barriers, the waited upon split barriers are converted to pipeline barriers.
+            if (!impl.info.use_split_barriers)
+            {
+                for (usize const barrier_index : task_batch.wait_split_barrier_indices)
+                {
+                    merge(permutation.split_barriers[barrier_index]);
+                }
+            }
+        }
+    }
+
+    void ImplTaskGraph::complete_permutation(TaskGraphPermutation & permutation, std::span<MemoryBlock> memory_blocks)
+    {
+        create_transient_runtime_resources(permutation, memory_blocks);
+
+        // Insert static initialization barriers for non persistent resources:
+        // Buffers never need layout initialization, only images.
+        for (u32 task_image_index = 0; task_image_index < permutation.image_infos.size(); ++task_image_index)
+        {
+            TaskImageView const task_image_id = {{unique_index, task_image_index}};
+            auto & task_image = permutation.image_infos[task_image_index];
+            PermIndepTaskImageInfo const & glob_task_image = global_image_infos[task_image_index];
+            if (task_image.valid && !glob_task_image.is_persistent())
+            {
+                // Insert barriers, initializing all the initially accesses subresource ranges to the correct layout.
+                std::vector<ExtendedImageSliceState> first_accesses = {};
+                task_image.first_slice_states.slices(first_accesses);
+                for (auto const & first_access : first_accesses)
+                {
+                    usize const new_barrier_index = permutation.barriers.size();
+                    permutation.barriers.push_back(TaskBarrier{
+                        .image_id = task_image_id,
+                        .slice = first_access.state.slice,
+                        .layout_before = {},
+                        .layout_after = first_access.state.latest_layout,
+                        .src_access = {},
+                        .dst_access = first_access.state.latest_access,
+                    });
+                    // Because resources may be aliased we need to insert the barrier into the batch in which the resource is first used
+                    // If we just inserted all transitions into the first batch an error as follows might occur:
+                    //      Image A lives in batch 1, Image B lives in batch 2
+                    //      Image A and B are aliased (share the same/part-of memory)
+                    //      Image A is transitioned from UNDEFINED -> TRANSFER_DST in batch 0 BUT
+                    //      Image B is also transitioned from UNDEFINED -> TRANSFER_SRT in batch 0
+                    // This is an erroneous state - task graph assumes they are separate images and thus,
+                    // for example uses Image A thinking it's in TRANSFER_DST which it is not
+                    if (info.alias_transients)
                     {
-                        return true;
+                        // TODO(msakmary) This is only needed when we actually alias two images - should be possible to detect this
+                        // and only defer the initialization barrier for these aliased ones instead of all of them
+                        auto const submit_scope_index = first_access.latest_access_submit_scope_index;
+                        auto const batch_index = first_access.latest_access_batch_index;
+                        auto & first_used_batch = permutation.batch(submit_scope_index, batch_index);
+                        first_used_batch.pipeline_barrier_indices.push_back(new_barrier_index);
                     }
-                    if (first.offset == second.offset)
+                    else
                     {
-                        if (first.start_batch < second.start_batch)
-                        {
-                            return true;
-                        }
-                        if (first.start_batch == second.start_batch)
-                        {
-                            return first.owning_resource_idx < second.owning_resource_idx;
-                        }
-                        // first.offset == second.offset && first.start_batch > second.start_batch
-                        return false;
+                        auto & first_used_batch = permutation.batch(0, 0);
+                        first_used_batch.pipeline_barrier_indices.push_back(new_barrier_index);
                     }
-                    // first.offset > second.offset
-                    return false;
-                };
-            };
-            std::set<Allocation, AllocCompare> allocations = {};
-            // Figure out where to allocate each resource
-            usize no_alias_back_offset = {};
-            for (auto const & resource_lifetime : lifetime_length_sorted_resources)
+                }
+            }
+        }
+        merge_batch_barriers(*this, permutation);
+    }
+
+    // Serialized permutations start with a header holding the structural hash of the graph.
+    // The hash covers everything compilation depends on, data with a different hash is never loaded.
+    static constexpr u32 SERIALIZED_PERMUTATIONS_MAGIC = 0x47545844u; // "DXTG"
+    static constexpr u32 SERIALIZED_PERMUTATIONS_VERSION = 2;
+
+    // FNV-1a over the fields, independent of the standard library so that the hash is stable between runs and builds.
+    struct TaskGraphStructuralHasher
+    {
+        u64 value = 0xcbf29ce484222325ull;
+
+        template <typename T>
+            requires(std::is_integral_v<T> || std::is_enum_v<T>)
+        void add(T const & field)
+        {
+            auto const bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(field);
+            for (std::byte const byte : bytes)
+            {
+                value = (value ^ static_cast<u64>(byte)) * 0x100000001b3ull;
+            }
+        }
+
+        void add(ImageMipArraySlice const & slice)
+        {
+            add(slice.base_mip_level);
+            add(slice.level_count);
+            add(slice.base_array_layer);
+            add(slice.layer_count);
+        }
+    };
+
+    auto task_graph_structural_hash(ImplTaskGraph const & impl) -> u64
+    {
+        TaskGraphStructuralHasher hasher = {};
+        hasher.add(SERIALIZED_PERMUTATIONS_VERSION);
+        // Memory requirements and therefore transient placements differ between devices and drivers.
+        DeviceProperties const & properties = impl.info.device.properties();
+        hasher.add(properties.vendor_id);
+        hasher.add(properties.device_id);
+        hasher.add(properties.driver_version);
+        hasher.add(impl.info.reorder_tasks);
+        hasher.add(impl.info.minimize_barriers);
+        hasher.add(impl.info.cull_dead_tasks);
+        hasher.add(impl.info.alias_transients);
+        hasher.add(impl.info.use_split_barriers);
+        hasher.add(impl.info.permutation_condition_count);
+        hasher.add(impl.info.swapchain.has_value());
+        for (auto const & global_buffer : impl.global_buffer_infos)
+        {
+            hasher.add(global_buffer.is_persistent());
+            if (global_buffer.is_persistent())
             {
-                MemoryRequirements mem_requirements;
-                if (resource_lifetime.is_image)
+                hasher.add(global_buffer.get_persistent().actual_ids.index());
+            }
+            else
+            {
+                hasher.add(daxa::get<PermIndepTaskBufferInfo::Transient>(global_buffer.task_buffer_data).info.size);
+            }
+        }
+        for (auto const & global_image : impl.global_image_infos)
+        {
+            hasher.add(global_image.is_persistent());
+            if (global_image.is_persistent())
+            {
+                hasher.add(global_image.get_persistent().info.swapchain_image);
+            }
+            else
+            {
+                TaskTransientImageInfo const & transient_info = daxa::get<PermIndepTaskImageInfo::Transient>(global_image.task_image_data).info;
+                hasher.add(transient_info.dimensions);
+                hasher.add(transient_info.format);
+                hasher.add(transient_info.size.x);
+                hasher.add(transient_info.size.y);
+                hasher.add(transient_info.size.z);
+                hasher.add(transient_info.mip_level_count);
+                hasher.add(transient_info.array_layer_count);
+                hasher.add(transient_info.sample_count);
+            }
+        }
+        for (auto const & task : impl.tasks)
+        {
+            hasher.add(task.queue.family);
+            hasher.add(task.queue.index);
+            hasher.add(task.has_side_effects);
+            auto const attachments = task.base_task->attachments();
+            hasher.add(attachments.size());
+            for (auto const & attachment : attachments)
+            {
+                hasher.add(attachment.type);
+                switch (attachment.type)
                 {
-                    mem_requirements = permutation.image_infos.at(resource_lifetime.resource_idx).memory_requirements;
+                case TaskAttachmentType::BUFFER:
+                    hasher.add(attachment.value.buffer.access);
+                    hasher.add(attachment.value.buffer.translated_view.index);
+                    break;
+                case TaskAttachmentType::BLAS:
+                    hasher.add(attachment.value.blas.access);
+                    hasher.add(attachment.value.blas.translated_view.index);
+                    break;
+                case TaskAttachmentType::TLAS:
+                    hasher.add(attachment.value.tlas.access);
+                    hasher.add(attachment.value.tlas.translated_view.index);
+                    break;
+                case TaskAttachmentType::IMAGE:
+                    hasher.add(attachment.value.image.access);
+                    hasher.add(attachment.value.image.view_type);
+                    hasher.add(attachment.value.image.translated_view.index);
+                    hasher.add(attachment.value.image.translated_view.slice);
+                    break;
+                default: break;
                 }
-                else
+            }
+        }
+        for (auto const & recorded : impl.recorded_commands)
+        {
+            hasher.add(recorded.active_conditional_scopes);
+            hasher.add(recorded.conditional_states);
+            hasher.add(recorded.command.index());
+            if (auto const * declaration = std::get_if<RecordedResourceDeclaration>(&recorded.command))
+            {
+                hasher.add(declaration->is_image);
+                hasher.add(declaration->index);
+            }
+            else if (auto const * recorded_task = std::get_if<RecordedTask>(&recorded.command))
+            {
+                hasher.add(recorded_task->task_id);
+            }
+        }
+        return hasher.value;
+    }
+
+    struct SerializedPermutationsWriter
+    {
+        std::vector<std::byte> data = {};
+
+        // Only types without padding are written directly, so the data never contains indeterminate bytes.
+        // Structs with padding are written field by field.
+        template <typename T>
+            requires std::has_unique_object_representations_v<T>
+        void write(T const & value)
+        {
+            auto const * bytes = r_cast<std::byte const *>(&value);
+            data.insert(data.end(), bytes, bytes + sizeof(T));
+        }
+
+        // Counts are always written as u64, independent of the size of usize.
+        void write_count(usize count)
+        {
+            write(u64{count});
+        }
+
+        template <typename T>
+        void write_vector(std::vector<T> const & values)
+        {
+            write_count(values.size());
+            for (auto const & value : values)
+            {
+                write(value);
+            }
+        }
+
+        void write_image_view(TaskImageView const & view)
+        {
+            // Views are local to the graph, the unique index of the graph differs between runs.
+            write(view.is_empty());
+            write(view.index);
+            write(view.slice);
+        }
+
+        void write_memory_requirements(MemoryRequirements const & requirements)
+        {
+            write(requirements.size);
+            write(requirements.alignment);
+            write(requirements.memory_type_bits);
+        }
+
+        void write_memory_barrier(MemoryBarrierInfo const & barrier)
+        {
+            write(barrier.src_access);
+            write(barrier.dst_access);
+        }
+
+        void write_barrier(TaskBarrier const & barrier)
+        {
+            write_image_view(barrier.image_id);
+            write(barrier.slice);
+            write(barrier.layout_before);
+            write(barrier.layout_after);
+            write(barrier.src_access);
+            write(barrier.dst_access);
+        }
+
+        void write_concurrent_access_barrier_index(Variant<Monostate, LastConcurrentAccessSplitBarrierIndex, LastConcurrentAccessBarrierIndex> const & index)
+        {
+            if (auto const * split_index = daxa::get_if<LastConcurrentAccessSplitBarrierIndex>(&index))
+            {
+                write(u8{1});
+                write(split_index->index);
+            }
+            else if (auto const * barrier_index = daxa::get_if<LastConcurrentAccessBarrierIndex>(&index))
+            {
+                write(u8{2});
+                write(barrier_index->index);
+            }
+            else
+            {
+                write(u8{0});
+            }
+        }
+
+        void write_slice_states(ImageSliceStateMap const & slice_state_map)
+        {
+            std::vector<ExtendedImageSliceState> slice_states = {};
+            slice_state_map.slices(slice_states);
+            write_count(slice_states.size());
+            for (auto const & slice_state : slice_states)
+            {
+                write(slice_state.state.latest_access);
+                write(slice_state.state.latest_layout);
+                write(slice_state.state.slice);
+                write(slice_state.latest_access_concurrent);
+                write(slice_state.latest_access_batch_index);
+                write(slice_state.latest_access_submit_scope_index);
+                write_concurrent_access_barrier_index(slice_state.latest_concurrent_access_barrer_index);
+            }
+        }
+
+        void write_permutation(TaskGraphPermutation const & permutation)
+        {
+            write_image_view(permutation.swapchain_image);
+            write_count(permutation.buffer_infos.size());
+            for (auto const & buffer : permutation.buffer_infos)
+            {
+                write(buffer.valid);
+                write(buffer.latest_access_concurrent);
+                write(buffer.latest_access);
+                write(buffer.latest_access_batch_index);
+                write(buffer.latest_access_submit_scope_index);
+                write(buffer.first_access_batch_index);
+                write(buffer.first_access_submit_scope_index);
+                write(buffer.first_access);
+                write_concurrent_access_barrier_index(buffer.latest_concurrent_access_barrer_index);
+                write(buffer.used_on_async_queue);
+                write(buffer.lifetime);
+                write(buffer.allocation_offset);
+                write_memory_requirements(buffer.memory_requirements);
+            }
+            write_count(permutation.image_infos.size());
+            for (auto const & image : permutation.image_infos)
+            {
+                write(image.valid);
+                write(image.swapchain_semaphore_waited_upon);
+                write_slice_states(image.last_slice_states);
+                write_slice_states(image.first_slice_states);
+                write(image.lifetime);
+                write(image.create_flags);
+                write(image.usage);
+                write(image.used_on_async_queue);
+                write(image.allocation_offset);
+                write_memory_requirements(image.memory_requirements);
+            }
+            write_count(permutation.split_barriers.size());
+            for (auto const & split_barrier : permutation.split_barriers)
+            {
+                write_barrier(split_barrier);
+            }
+            write_count(permutation.barriers.size());
+            for (auto const & barrier : permutation.barriers)
+            {
+                write_barrier(barrier);
+            }
+            write_vector(permutation.initial_barriers);
+            write_count(permutation.batch_submit_scopes.size());
+            for (auto const & submit_scope : permutation.batch_submit_scopes)
+            {
+                write_vector(submit_scope.last_minute_barrier_indices);
+                write_vector(submit_scope.used_swapchain_task_images);
+                write(submit_scope.present_info.has_value());
+                write_count(submit_scope.batch_count);
+                for (auto const & task_batch : permutation.submit_scope_batches(submit_scope))
                 {
-                    mem_requirements = permutation.buffer_infos.at(resource_lifetime.resource_idx).memory_requirements;
-                }
-                // Go through all memory block states in which this resource is alive and try to find a spot for it
-                u8 const resource_lifetime_duration = static_cast<u8>(resource_lifetime.end_batch - resource_lifetime.start_batch + 1);
-                auto new_allocation = Allocation{
-                    .offset = 0,
-                    .size = mem_requirements.size,
-                    .start_batch = resource_lifetime.start_batch,
-                    .end_batch = resource_lifetime.end_batch,
-                    .is_image = resource_lifetime.is_image,
-                    .owning_resource_idx = resource_lifetime.resource_idx,
-                    .memory_type_bits = mem_requirements.memory_type_bits,
-                    .intersection_object = {
-                        .base_mip_level = static_cast<u8>(resource_lifetime.start_batch),
-                        .level_count = resource_lifetime_duration,
-                        .base_array_layer = static_cast<u16>(0),
-                        .layer_count = static_cast<u32>(mem_requirements.size),
-                    }};
-                usize const align = std::max(mem_requirements.alignment, static_cast<size_t>(1ull));
-
-                if (info.alias_transients)
-                {
-                    // TODO(msakmary) Fix the intersect functionality so that it is general and does not do hacky stuff like constructing
-                    // a mip array slice
-                    // Find space in memory and time the new allocation fits into.
-                    for (auto const & allocation : allocations)
-                    {
-                        if (new_allocation.intersection_object.intersects(allocation.intersection_object))
-                        {
-                            // assign new offset into the memory block - we need to guarantee correct alignment
-                            usize const curr_offset = allocation.offset + allocation.size;
-                            usize const aligned_curr_offset = (curr_offset + align - 1) / align * align;
-                            new_allocation.offset = aligned_curr_offset;
-                            new_allocation.intersection_object.base_array_layer = static_cast<u32>(new_allocation.offset);
-                        }
+                    write(task_batch.queue);
+                    write_vector(task_batch.cross_queue_wait_batch_indices);
+                    write_vector(task_batch.pipeline_barrier_indices);
+                    write_vector(task_batch.wait_split_barrier_indices);
+                    write_vector(task_batch.tasks);
+                    write_vector(task_batch.signal_split_barrier_indices);
+                    write(task_batch.merged_memory_barrier.has_value());
+                    write_memory_barrier(task_batch.merged_memory_barrier.value_or(MemoryBarrierInfo{}));
+                    write_count(task_batch.merged_image_barriers.size());
+                    for (auto const & barrier : task_batch.merged_image_barriers)
+                    {
+                        write_barrier(barrier);
                     }
                 }
-                else
+            }
+            write(permutation.swapchain_image_first_use_submit_scope_index);
+            write(permutation.swapchain_image_last_use_submit_scope_index);
+            write(permutation.transient_peak_live_bytes);
+            write(permutation.transient_unaliased_bytes);
+            write(permutation.scheduling_statistics);
+            write_vector(permutation.culled_tasks);
+        }
+    };
+
+    // Reads serialized permutations. Any read past the end of the data marks the reader as failed instead of reading.
+    struct SerializedPermutationsReader
+    {
+        std::span<std::byte const> data = {};
+        u32 task_graph_index = {};
+        usize offset = {};
+        bool failed = {};
+
+        template <typename T>
+            requires std::is_trivially_copyable_v<T>
+        void read(T & value)
+        {
+            if (failed || data.size() - offset < sizeof(T))
+            {
+                failed = true;
+                return;
+            }
+            std::memcpy(&value, data.data() + offset, sizeof(T));
+            offset += sizeof(T);
+        }
+
+        // Bools are read as bytes, any value other than 0 or 1 marks the reader as failed.
+        void read(bool & value)
+        {
+            u8 const byte = read<u8>();
+            failed = failed || byte > 1;
+            value = byte == 1;
+        }
+
+        template <typename T>
+        auto read() -> T
+        {
+            T value = {};
+            read(value);
+            return value;
+        }
+
+        // Element counts are checked against the remaining data, so corrupted counts never cause huge allocations.
+        auto read_count(usize min_element_size) -> usize
+        {
+            u64 const count = read<u64>();
+            if (failed || count > (data.size() - offset) / min_element_size)
+            {
+                failed = true;
+                return 0;
+            }
+            return static_cast<usize>(count);
+        }
+
+        template <typename T>
+        void read_vector(std::vector<T> & values)
+        {
+            values.resize(read_count(sizeof(T)));
+            for (auto & value : values)
+            {
+                read(value);
+            }
+        }
+
+        void read_image_view(TaskImageView & view)
+        {
+            bool const empty = read<bool>();
+            view = {};
+            read(view.index);
+            read(view.slice);
+            view.task_graph_index = empty ? 0 : task_graph_index;
+            if (empty)
+            {
+                view.index = 0;
+            }
+        }
+
+        void read_memory_requirements(MemoryRequirements & requirements)
+        {
+            read(requirements.size);
+            read(requirements.alignment);
+            read(requirements.memory_type_bits);
+        }
+
+        void read_memory_barrier(MemoryBarrierInfo & barrier)
+        {
+            read(barrier.src_access);
+            read(barrier.dst_access);
+        }
+
+        void read_barrier(TaskBarrier & barrier)
+        {
+            read_image_view(barrier.image_id);
+            read(barrier.slice);
+            read(barrier.layout_before);
+            read(barrier.layout_after);
+            read(barrier.src_access);
+            read(barrier.dst_access);
+        }
+
+        void read_concurrent_access_barrier_index(Variant<Monostate, LastConcurrentAccessSplitBarrierIndex, LastConcurrentAccessBarrierIndex> & index)
+        {
+            switch (read<u8>())
+            {
+            case 1: index = LastConcurrentAccessSplitBarrierIndex{read<usize>()}; break;
+            case 2: index = LastConcurrentAccessBarrierIndex{read<usize>()}; break;
+            default: index = Monostate{}; break;
+            }
+        }
+
+        void read_slice_states(ImageSliceStateMap & slice_state_map)
+        {
+            slice_state_map.clear();
+            std::vector<ExtendedImageSliceState> slice_states = {};
+            slice_states.resize(read_count(sizeof(ImageSliceState)));
+            for (auto & slice_state : slice_states)
+            {
+                read(slice_state.state.latest_access);
+                read(slice_state.state.latest_layout);
+                read(slice_state.state.slice);
+                read(slice_state.latest_access_concurrent);
+                read(slice_state.latest_access_batch_index);
+                read(slice_state.latest_access_submit_scope_index);
+                read_concurrent_access_barrier_index(slice_state.latest_concurrent_access_barrer_index);
+                if (!failed)
                 {
-                    usize const aligned_curr_offset = (no_alias_back_offset + align - 1) / align * align;
-                    new_allocation.offset = aligned_curr_offset;
-                    no_alias_back_offset = new_allocation.offset + new_allocation.size;
+                    slice_state_map.insert(slice_state);
                 }
-                allocations.insert(new_allocation);
             }
-            // Once we are done with finding space for all the allocations go through all permutation images and copy over the allocation information
-            for (auto const & allocation : allocations)
+        }
+
+        void read_permutation(TaskGraphPermutation & permutation)
+        {
+            read_image_view(permutation.swapchain_image);
+            permutation.buffer_infos.resize(read_count(sizeof(bool)));
+            for (auto & buffer : permutation.buffer_infos)
+            {
+                read(buffer.valid);
+                read(buffer.latest_access_concurrent);
+                read(buffer.latest_access);
+                read(buffer.latest_access_batch_index);
+                read(buffer.latest_access_submit_scope_index);
+                read(buffer.first_access_batch_index);
+                read(buffer.first_access_submit_scope_index);
+                read(buffer.first_access);
+                read_concurrent_access_barrier_index(buffer.latest_concurrent_access_barrer_index);
+                read(buffer.used_on_async_queue);
+                read(buffer.lifetime);
+                read(buffer.allocation_offset);
+                read_memory_requirements(buffer.memory_requirements);
+            }
+            permutation.image_infos.resize(read_count(sizeof(bool)));
+            for (auto & image : permutation.image_infos)
+            {
+                read(image.valid);
+                read(image.swapchain_semaphore_waited_upon);
+                read_slice_states(image.last_slice_states);
+                read_slice_states(image.first_slice_states);
+                read(image.lifetime);
+                read(image.create_flags);
+                read(image.usage);
+                read(image.used_on_async_queue);
+                read(image.allocation_offset);
+                read_memory_requirements(image.memory_requirements);
+            }
+            permutation.split_barriers.resize(read_count(sizeof(bool)));
+            for (auto & split_barrier : permutation.split_barriers)
+            {
+                read_barrier(split_barrier);
+            }
+            permutation.barriers.resize(read_count(sizeof(bool)));
+            for (auto & barrier : permutation.barriers)
             {
-                if (allocation.is_image)
+                read_barrier(barrier);
+            }
+            read_vector(permutation.initial_barriers);
+            permutation.batch_submit_scopes.resize(read_count(sizeof(u64)));
+            permutation.task_batches.clear();
+            for (auto & submit_scope : permutation.batch_submit_scopes)
+            {
+                read_vector(submit_scope.last_minute_barrier_indices);
+                read_vector(submit_scope.used_swapchain_task_images);
+                if (read<bool>())
                 {
-                    permutation.image_infos.at(allocation.owning_resource_idx).allocation_offset = allocation.offset;
+                    submit_scope.present_info = ImplPresentInfo{};
                 }
-                else
+                submit_scope.first_batch_index = permutation.task_batches.size();
+                submit_scope.batch_count = read_count(sizeof(Queue));
+                permutation.task_batches.resize(submit_scope.first_batch_index + submit_scope.batch_count);
+                for (auto & task_batch : permutation.submit_scope_batches(submit_scope))
                 {
-                    permutation.buffer_infos.at(allocation.owning_resource_idx).allocation_offset = allocation.offset;
+                    read(task_batch.queue);
+                    read_vector(task_batch.cross_queue_wait_batch_indices);
+                    read_vector(task_batch.pipeline_barrier_indices);
+                    read_vector(task_batch.wait_split_barrier_indices);
+                    read_vector(task_batch.tasks);
+                    read_vector(task_batch.signal_split_barrier_indices);
+                    bool const has_merged_memory_barrier = read<bool>();
+                    MemoryBarrierInfo merged_memory_barrier = {};
+                    read_memory_barrier(merged_memory_barrier);
+                    if (has_merged_memory_barrier)
+                    {
+                        task_batch.merged_memory_barrier = merged_memory_barrier;
+                    }
+                    task_batch.merged_image_barriers.resize(read_count(sizeof(bool)));
+                    for (auto & barrier : task_batch.merged_image_barriers)
+                    {
+                        read_barrier(barrier);
+                    }
                 }
-                // find the amount of memory this permutation requires
-                memory_block_size = std::max(memory_block_size, allocation.offset + allocation.size);
-                memory_type_bits = memory_type_bits & allocation.memory_type_bits;
             }
+            read(permutation.swapchain_image_first_use_submit_scope_index);
+            read(permutation.swapchain_image_last_use_submit_scope_index);
+            read(permutation.transient_peak_live_bytes);
+            read(permutation.transient_unaliased_bytes);
+            read(permutation.scheduling_statistics);
+            read_vector(permutation.culled_tasks);
         }
+    };
 
-        transient_data_memory_block = info.device.create_memory({
-            .requirements = {
-                .size = memory_block_size,
-                .alignment = max_alignment_requirement,
-                .memory_type_bits = memory_type_bits,
-            },
-            .flags = MemoryFlagBits::DEDICATED_MEMORY,
+    // Checks that every index and transient allocation read from serialized permutations refers into the loaded data.
+    auto validate_loaded_permutation(ImplTaskGraph const & impl, TaskGraphPermutation const & permutation, usize memory_block_size) -> bool
+    {
+        auto const all_below = [](std::vector<usize> const & indices, usize count)
+        {
+            return std::all_of(indices.begin(), indices.end(), [&](usize index)
+                               { return index < count; });
+        };
+        auto const valid_view = [&](TaskImageView const & view)
+        {
+            return view.is_empty() || view.index < permutation.image_infos.size();
+        };
+        auto const valid_barrier_index = [&](Variant<Monostate, LastConcurrentAccessSplitBarrierIndex, LastConcurrentAccessBarrierIndex> const & index)
+        {
+            if (auto const * split_index = daxa::get_if<LastConcurrentAccessSplitBarrierIndex>(&index))
+            {
+                return split_index->index < permutation.split_barriers.size();
+            }
+            if (auto const * barrier_index = daxa::get_if<LastConcurrentAccessBarrierIndex>(&index))
+            {
+                return barrier_index->index < permutation.barriers.size();
+            }
+            return true;
+        };
+        auto const valid_allocation = [&](usize offset, MemoryRequirements const & requirements)
+        {
+            return requirements.size <= memory_block_size && offset <= memory_block_size - requirements.size;
+        };
+        auto const valid_scope_index = [&](usize submit_scope_index)
+        {
+            return submit_scope_index == std::numeric_limits<usize>::max() || submit_scope_index < permutation.batch_submit_scopes.size();
+        };
+
+        if (permutation.buffer_infos.size() != impl.global_buffer_infos.size() ||
+            permutation.image_infos.size() != impl.global_image_infos.size() ||
+            !valid_view(permutation.swapchain_image) ||
+            (!permutation.swapchain_image.is_empty() && !impl.global_image_infos[permutation.swapchain_image.index].is_persistent()) ||
+            !valid_scope_index(permutation.swapchain_image_first_use_submit_scope_index) ||
+            !valid_scope_index(permutation.swapchain_image_last_use_submit_scope_index) ||
+            !all_below(permutation.initial_barriers, permutation.barriers.size()) ||
+            !all_below(permutation.culled_tasks, impl.tasks.size()))
+        {
+            return false;
+        }
+        for (usize task_buffer_index = 0; task_buffer_index < permutation.buffer_infos.size(); ++task_buffer_index)
+        {
+            PerPermTaskBuffer const & buffer = permutation.buffer_infos[task_buffer_index];
+            bool const transient = buffer.valid && !impl.global_buffer_infos[task_buffer_index].is_persistent();
+            if (!valid_barrier_index(buffer.latest_concurrent_access_barrer_index) ||
+                (transient && !valid_allocation(buffer.allocation_offset, buffer.memory_requirements)))
+            {
+                return false;
+            }
+        }
+        std::vector<ExtendedImageSliceState> slice_states = {};
+        for (usize task_image_index = 0; task_image_index < permutation.image_infos.size(); ++task_image_index)
+        {
+            PerPermTaskImage const & image = permutation.image_infos[task_image_index];
+            bool const transient = image.valid && !impl.global_image_infos[task_image_index].is_persistent();
+            if (transient && !valid_allocation(image.allocation_offset, image.memory_requirements))
+            {
+                return false;
+            }
+            slice_states.clear();
+            image.last_slice_states.slices(slice_states);
+            image.first_slice_states.slices(slice_states);
+            if (!std::all_of(slice_states.begin(), slice_states.end(), [&](ExtendedImageSliceState const & slice_state)
+                             { return valid_barrier_index(slice_state.latest_concurrent_access_barrer_index); }))
+            {
+                return false;
+            }
+        }
+        if (!std::all_of(permutation.split_barriers.begin(), permutation.split_barriers.end(), [&](TaskSplitBarrier const & barrier)
+                         { return valid_view(barrier.image_id); }) ||
+            !std::all_of(permutation.barriers.begin(), permutation.barriers.end(), [&](TaskBarrier const & barrier)
+                         { return valid_view(barrier.image_id); }))
+        {
+            return false;
+        }
+        for (auto const & submit_scope : permutation.batch_submit_scopes)
+        {
+            if (!all_below(submit_scope.last_minute_barrier_indices, permutation.barriers.size()) ||
+                !std::all_of(submit_scope.used_swapchain_task_images.begin(), submit_scope.used_swapchain_task_images.end(), [&](u64 index)
+                             { return index < permutation.image_infos.size(); }))
+            {
+                return false;
+            }
+            std::span<TaskBatch const> const task_batches = permutation.submit_scope_batches(submit_scope);
+            for (usize batch_index = 0; batch_index < task_batches.size(); ++batch_index)
+            {
+                TaskBatch const & task_batch = task_batches[batch_index];
+                u32 const queue_count = task_batch.queue.family == QueueFamily::MAIN       ? 1
+                                        : task_batch.queue.family == QueueFamily::COMPUTE  ? MAX_COMPUTE_QUEUE_COUNT
+                                        : task_batch.queue.family == QueueFamily::TRANSFER ? MAX_TRANSFER_QUEUE_COUNT
+                                                                                           : 0;
+                // Batches only wait on earlier batches of their submit scope.
+                if (task_batch.queue.index >= queue_count ||
+                    !all_below(task_batch.cross_queue_wait_batch_indices, batch_index) ||
+                    !all_below(task_batch.pipeline_barrier_indices, permutation.barriers.size()) ||
+                    !all_below(task_batch.wait_split_barrier_indices, permutation.split_barriers.size()) ||
+                    !all_below(task_batch.signal_split_barrier_indices, permutation.split_barriers.size()) ||
+                    !all_below(task_batch.tasks, impl.tasks.size()) ||
+                    !std::all_of(task_batch.merged_image_barriers.begin(), task_batch.merged_image_barriers.end(), [&](TaskBarrier const & barrier)
+                                 { return valid_view(barrier.image_id); }))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    auto TaskGraph::serialize_compiled_permutations() const -> std::vector<std::byte>
+    {
+        auto const & impl = *r_cast<ImplTaskGraph const *>(this->object);
+        DAXA_DBG_ASSERT_TRUE_M(impl.compiled, "only completed task graphs can be serialized");
+        DAXA_DBG_ASSERT_TRUE_M(!impl.info.jit_compile_permutations, "task graphs using jit compilation can not be serialized");
+        SerializedPermutationsWriter writer = {};
+        writer.write(SERIALIZED_PERMUTATIONS_MAGIC);
+        writer.write(SERIALIZED_PERMUTATIONS_VERSION);
+        writer.write(task_graph_structural_hash(impl));
+        writer.write_memory_requirements(MemoryRequirements{
+            .size = impl.memory_block_size,
+            .alignment = impl.memory_block_alignment,
+            .memory_type_bits = impl.memory_type_bits,
         });
+        writer.write_count(impl.permutations.size());
+        for (auto const & permutation : impl.permutations)
+        {
+            writer.write_permutation(permutation);
+        }
+        return std::move(writer.data);
     }
 
-    void TaskGraph::complete(TaskCompleteInfo const & /*unused*/)
+    auto TaskGraph::loaded_serialized_permutations() const -> bool
     {
-        auto & impl = *r_cast<ImplTaskGraph *>(this->object);
-        DAXA_DBG_ASSERT_TRUE_M(!impl.compiled, "task graphs can only be completed once");
-        impl.compiled = true;
+        auto const & impl = *r_cast<ImplTaskGraph const *>(this->object);
+        return impl.loaded_serialized_permutations;
+    }
 
-        impl.allocate_transient_resources();
-        // Insert static barriers initializing image layouts.
-        for (auto & permutation : impl.permutations)
+    // Replaces the compilation of all permutations.
+    // Returns false without changing the graph when the data does not match the graph.
+    auto ImplTaskGraph::load_serialized_permutations(std::span<std::byte const> data) -> bool
+    {
+        SerializedPermutationsReader reader = {.data = data, .task_graph_index = unique_index};
+        if (reader.read<u32>() != SERIALIZED_PERMUTATIONS_MAGIC ||
+            reader.read<u32>() != SERIALIZED_PERMUTATIONS_VERSION ||
+            reader.read<u64>() != task_graph_structural_hash(*this))
         {
-            impl.create_transient_runtime_buffers(permutation);
-            impl.create_transient_runtime_images(permutation);
-
-            // Insert static initialization barriers for non persistent resources:
-            // Buffers never need layout initialization, only images.
-            for (u32 task_image_index = 0; task_image_index < permutation.image_infos.size(); ++task_image_index)
-            {
-                TaskImageView const task_image_id = {{impl.unique_index, task_image_index}};
-                auto & task_image = permutation.image_infos[task_image_index];
-                PermIndepTaskImageInfo const & glob_task_image = impl.global_image_infos[task_image_index];
-                if (task_image.valid && !glob_task_image.is_persistent())
-                {
-                    // Insert barriers, initializing all the initially accesses subresource ranges to the correct layout.
-                    for (auto & first_access : task_image.first_slice_states)
-                    {
-                        usize const new_barrier_index = permutation.barriers.size();
-                        permutation.barriers.push_back(TaskBarrier{
-                            .image_id = task_image_id,
-                            .slice = first_access.state.slice,
-                            .layout_before = {},
-                            .layout_after = first_access.state.latest_layout,
-                            .src_access = {},
-                            .dst_access = first_access.state.latest_access,
-                        });
-                        // Because resources may be aliased we need to insert the barrier into the batch in which the resource is first used
-                        // If we just inserted all transitions into the first batch an error as follows might occur:
-                        //      Image A lives in batch 1, Image B lives in batch 2
-                        //      Image A and B are aliased (share the same/part-of memory)
-                        //      Image A is transitioned from UNDEFINED -> TRANSFER_DST in batch 0 BUT
-                        //      Image B is also transitioned from UNDEFINED -> TRANSFER_SRT in batch 0
-                        // This is an erroneous state - task graph assumes they are separate images and thus,
-                        // for example uses Image A thinking it's in TRANSFER_DST which it is not
-                        if (impl.info.alias_transients)
-                        {
-                            // TODO(msakmary) This is only needed when we actually alias two images - should be possible to detect this
-                            // and only defer the initialization barrier for these aliased ones instead of all of them
-                            auto const submit_scope_index = first_access.latest_access_submit_scope_index;
-                            auto const batch_index = first_access.latest_access_batch_index;
-                            auto & first_used_batch = permutation.batch_submit_scopes[submit_scope_index].task_batches[batch_index];
-                            first_used_batch.pipeline_barrier_indices.push_back(new_barrier_index);
-                        }
-                        else
+            return false;
+        }
+        MemoryRequirements requirements = {};
+        reader.read_memory_requirements(requirements);
+        usize const permutation_count = usize{1} << info.permutation_condition_count;
+        std::vector<TaskGraphPermutation> loaded_permutations(reader.read<u64>() == permutation_count ? permutation_count : 0);
+        for (auto & permutation : loaded_permutations)
+        {
+            reader.read_permutation(permutation);
+        }
+        if (reader.failed || reader.offset != data.size() || loaded_permutations.size() != permutation_count ||
+            !std::all_of(loaded_permutations.begin(), loaded_permutations.end(), [&](TaskGraphPermutation const & permutation)
+                         { return validate_loaded_permutation(*this, permutation, requirements.size); }))
+        {
+            return false;
+        }
+
+        // The submit and present infos point to user memory, they are taken from the recorded commands of each permutation.
+        for (u32 permutation_index = 0; permutation_index < permutation_count; ++permutation_index)
+        {
+            TaskGraphPermutation & permutation = loaded_permutations[permutation_index];
+            usize submit_scope_index = 0;
+            for (RecordedCommand const & recorded : recorded_commands)
+            {
+                bool const active = (recorded.active_conditional_scopes & permutation_index) == (recorded.active_conditional_scopes & recorded.conditional_states);
+                if (!active)
+                {
+                    continue;
+                }
+                if (auto const * submit_info = std::get_if<TaskSubmitInfo>(&recorded.command))
+                {
+                    if (submit_scope_index + 1 >= permutation.batch_submit_scopes.size())
+                    {
+                        return false;
+                    }
+                    permutation.batch_submit_scopes[submit_scope_index].user_submit_info = *submit_info;
+                    submit_scope_index += 1;
+                }
+                else if (auto const * present_info = std::get_if<TaskPresentInfo>(&recorded.command))
+                {
+                    for (auto & submit_scope : permutation.batch_submit_scopes)
+                    {
+                        if (submit_scope.present_info.has_value())
                         {
-                            auto & first_used_batch = permutation.batch_submit_scopes[0].task_batches[0];
-                            first_used_batch.pipeline_barrier_indices.push_back(new_barrier_index);
+                            submit_scope.present_info->additional_binary_semaphores = present_info->additional_binary_semaphores;
                         }
                     }
                 }
             }
+            if (submit_scope_index + 1 != permutation.batch_submit_scopes.size())
+            {
+                return false;
+            }
+        }
+
+        for (auto & permutation : loaded_permutations)
+        {
+            for (usize split_barrier_index = 0; split_barrier_index < permutation.split_barriers.size(); ++split_barrier_index)
+            {
+                permutation.split_barriers[split_barrier_index].split_barrier_state = info.device.create_event({
+                    .name = std::string("tg \"") + info.name + "\" sb " + std::to_string(split_barrier_index),
+                });
+            }
         }
+        permutations = std::move(loaded_permutations);
+        allocate_transient_memory(requirements);
+        return true;
     }
 
     // auto TaskGraph::get_command_lists() -> std::vector<CommandRecorder>
@@ -2651,12 +4131,114 @@ namespace daxa
     auto TaskGraph::get_transient_memory_size() -> daxa::usize
     {
         auto & impl = *r_cast<ImplTaskGraph *>(this->object);
-        return impl.memory_block_size;
+        if (impl.info.jit_compile_permutations)
+        {
+            usize size = 0;
+            for (auto const & [permutation_index, jit_permutation] : impl.jit_permutations)
+            {
+                size += jit_permutation.transient_memory_size * jit_permutation.transient_memory_blocks.size();
+            }
+            return size;
+        }
+        return impl.memory_block_size * impl.transient_data_memory_blocks.size();
+    }
+
+    auto TaskGraph::get_jit_statistics() const -> TaskGraphJitStatistics
+    {
+        auto const & impl = *r_cast<ImplTaskGraph const *>(this->object);
+        return impl.jit_statistics;
+    }
+
+    auto TaskGraph::get_transient_memory_statistics() const -> TaskTransientMemoryStatistics
+    {
+        auto const & impl = *r_cast<ImplTaskGraph const *>(this->object);
+        TaskTransientMemoryStatistics ret = impl.transient_memory_statistics;
+        if (impl.info.jit_compile_permutations)
+        {
+            for (auto const & [permutation_index, jit_permutation] : impl.jit_permutations)
+            {
+                ret.peak_live_bytes += jit_permutation.permutation.transient_peak_live_bytes;
+                ret.allocated_bytes += jit_permutation.transient_memory_size * jit_permutation.transient_memory_blocks.size();
+                ret.unaliased_bytes += jit_permutation.permutation.transient_unaliased_bytes;
+            }
+        }
+        else
+        {
+            for (auto const & permutation : impl.permutations)
+            {
+                ret.peak_live_bytes = std::max(ret.peak_live_bytes, permutation.transient_peak_live_bytes);
+                ret.unaliased_bytes = std::max(ret.unaliased_bytes, permutation.transient_unaliased_bytes);
+            }
+            ret.allocated_bytes = impl.memory_block_size * impl.transient_data_memory_blocks.size();
+        }
+        if (ImplTransientHeap const * heap = impl.transient_heap())
+        {
+            ret.allocated_bytes = heap->requirements.size;
+        }
+        return ret;
+    }
+
+    auto TaskGraph::get_scheduling_statistics() const -> TaskGraphSchedulingStatistics
+    {
+        auto const & impl = *r_cast<ImplTaskGraph const *>(this->object);
+        TaskGraphSchedulingStatistics ret = {};
+        auto const add = [&](TaskGraphPermutation const & permutation)
+        {
+            auto const add_schedule = [](TaskScheduleStatistics & sum, TaskScheduleStatistics const & schedule)
+            {
+                sum.batch_count += schedule.batch_count;
+                sum.barrier_point_count += schedule.barrier_point_count;
+                sum.pipeline_barrier_count += schedule.pipeline_barrier_count;
+                sum.split_barrier_count += schedule.split_barrier_count;
+            };
+            add_schedule(ret.earliest_batch, permutation.scheduling_statistics.earliest_batch);
+            add_schedule(ret.scheduled, permutation.scheduling_statistics.scheduled);
+        };
+        for (auto const & [permutation_index, jit_permutation] : impl.jit_permutations)
+        {
+            add(jit_permutation.permutation);
+        }
+        for (auto const & permutation : impl.permutations)
+        {
+            add(permutation);
+        }
+        return ret;
+    }
+
+    auto TaskGraph::get_static_execution_statistics() const -> TaskGraphStaticExecutionStatistics
+    {
+        auto const & impl = *r_cast<ImplTaskGraph const *>(this->object);
+        return impl.static_execution_statistics;
     }
 
     thread_local std::vector<EventWaitInfo> tl_split_barrier_wait_infos = {};
     thread_local std::vector<ImageMemoryBarrierInfo> tl_image_barrier_infos = {};
     thread_local std::vector<MemoryBarrierInfo> tl_memory_barrier_infos = {};
+    // Expands an image barrier to one barrier per runtime image of its task image.
+    void append_image_barrier_infos(ImplTaskGraph const & impl, TaskGraphPermutation & perm, TaskBarrier const & barrier, std::vector<ImageMemoryBarrierInfo> & image_barrier_infos)
+    {
+        auto const actual_images = impl.get_actual_images(barrier.image_id, perm);
+        for (usize index = 0; index < actual_images.size(); ++index)
+        {
+            auto const & image = actual_images[index];
+            DAXA_DBG_ASSERT_TRUE_M(
+                impl.info.device.is_id_valid(image),
+                std::string("Detected invalid runtime image id while inserting barriers: the runtime image id at index ") +
+                    std::to_string(index) +
+                    std::string(" of task image \"") +
+                    std::string(impl.global_image_infos[barrier.image_id.index].get_name()) +
+                    std::string("\" is invalid"));
+            image_barrier_infos.push_back(ImageMemoryBarrierInfo{
+                .src_access = barrier.src_access,
+                .dst_access = barrier.dst_access,
+                .src_layout = barrier.layout_before,
+                .dst_layout = barrier.layout_after,
+                .image_slice = barrier.slice,
+                .image_id = image,
+            });
+        }
+    }
+
     void insert_pipeline_barrier(ImplTaskGraph const & impl, TaskGraphPermutation & perm, CommandRecorder & command_list, TaskBarrier & barrier)
     {
         // Check if barrier is image barrier or normal barrier (see TaskBarrier struct comments).
@@ -2669,26 +4251,9 @@ namespace daxa
         }
         else
         {
-            auto const actual_images = impl.get_actual_images(barrier.image_id, perm);
-            for (usize index = 0; index < actual_images.size(); ++index)
-            {
-                auto const & image = actual_images[index];
-                DAXA_DBG_ASSERT_TRUE_M(
-                    impl.info.device.is_id_valid(image),
-                    std::string("Detected invalid runtime image id while inserting barriers: the runtime image id at index ") +
-                        std::to_string(index) +
-                        std::string(" of task image \"") +
-                        std::string(impl.global_image_infos[barrier.image_id.index].get_name()) +
-                        std::string("\" is invalid"));
-                command_list.pipeline_barrier_image_transition({
-                    .src_access = barrier.src_access,
-                    .dst_access = barrier.dst_access,
-                    .src_layout = barrier.layout_before,
-                    .dst_layout = barrier.layout_after,
-                    .image_slice = barrier.slice,
-                    .image_id = image,
-                });
-            }
+            append_image_barrier_infos(impl, perm, barrier, tl_image_barrier_infos);
+            command_list.pipeline_barriers({.image_barriers = tl_image_barrier_infos});
+            tl_image_barrier_infos.clear();
         }
     }
 
@@ -2759,7 +4324,8 @@ namespace daxa
         {
             auto & task_image = permutation.image_infos[task_image_index];
             auto & exec_image = impl.global_image_infos[task_image_index];
-            remaining_first_accesses = task_image.first_slice_states;
+            remaining_first_accesses.clear();
+            task_image.first_slice_states.slices(remaining_first_accesses);
             // Iterate over all persistent images.
             // Find all intersections between tracked slices of first use and previous use.
             // Synch on the intersection and delete the intersected part from the tracked slice of the previous use.
@@ -2839,52 +4405,601 @@ namespace daxa
                     }
                     if (!broke_inner_loop)
                     {
-                        // We break the loop when we erase the current element.
-                        // Erasing moved all elements past the current one one to the left.
-                        // This means that the current element is already a new one,
-                        // we do not want to skip it so we wont increment the index here.
-                        ++previous_access_slice_index;
+                        // We break the loop when we erase the current element.
+                        // Erasing moved all elements past the current one one to the left.
+                        // This means that the current element is already a new one,
+                        // we do not want to skip it so we wont increment the index here.
+                        ++previous_access_slice_index;
+                    }
+                }
+                if (impl.info.record_debug_information)
+                {
+                    end_indent(out, indent);
+                    fmt::format_to(std::back_inserter(out), "{}sync from undefined:\n", indent);
+                    begin_indent(out, indent, true);
+                }
+                // For all first uses that did NOT intersect with and previous use,
+                // we need to synchronize from an undefined state to initialize the layout of the image.
+                for (auto & remaining_first_accesse : remaining_first_accesses)
+                {
+                    for (auto execution_image_id : impl.get_actual_images(TaskImageView{{.task_graph_index = impl.unique_index, .index = task_image_index}}, permutation))
+                    {
+                        ImageMemoryBarrierInfo const img_barrier_info{
+                            .src_access = AccessConsts::NONE,
+                            .dst_access = remaining_first_accesse.state.latest_access,
+                            .src_layout = ImageLayout::UNDEFINED,
+                            .dst_layout = remaining_first_accesse.state.latest_layout,
+                            .image_slice = remaining_first_accesse.state.slice,
+                            .image_id = execution_image_id,
+                        };
+                        recorder.pipeline_barrier_image_transition(img_barrier_info);
+                        if (impl.info.record_debug_information)
+                        {
+                            fmt::format_to(std::back_inserter(out), "{}{}\n", indent, to_string(img_barrier_info));
+                            print_separator_to(out, indent);
+                        }
+                    }
+                }
+                if (impl.info.record_debug_information)
+                {
+                    end_indent(out, indent);
+                }
+            }
+        }
+        if (impl.info.record_debug_information)
+        {
+            end_indent(out, indent);
+            impl.debug_string_stream << out;
+        }
+    }
+
+    void insert_pre_batch_synch(ImplTaskGraph const & impl, TaskGraphPermutation & permutation, TaskBatch & task_batch, CommandRecorder & recorder)
+    {
+        // Wait on pipeline barriers before batch execution.
+        // They were merged when completing the permutation and are recorded with a single pipeline barrier command.
+        if (task_batch.merged_memory_barrier.has_value())
+        {
+            tl_memory_barrier_infos.push_back(task_batch.merged_memory_barrier.value());
+        }
+        for (TaskBarrier const & barrier : task_batch.merged_image_barriers)
+        {
+            append_image_barrier_infos(impl, permutation, barrier, tl_image_barrier_infos);
+        }
+        if (!tl_memory_barrier_infos.empty() || !tl_image_barrier_infos.empty())
+        {
+            recorder.pipeline_barriers({
+                .memory_barriers = tl_memory_barrier_infos,
+                .image_barriers = tl_image_barrier_infos,
+            });
+        }
+        tl_memory_barrier_infos.clear();
+        tl_image_barrier_infos.clear();
+        // Wait on split barriers before batch execution.
+        // Without split barriers, they are converted to pipeline barriers and merged into the pipeline barriers of the batch.
+        if (impl.info.use_split_barriers)
+        {
+            usize needed_image_barriers = 0;
+            for (auto barrier_index : task_batch.wait_split_barrier_indices)
+            {
+                TaskSplitBarrier const & split_barrier = permutation.split_barriers[barrier_index];
+                if (!split_barrier.image_id.is_empty())
+                {
+                    needed_image_barriers += impl.get_actual_images(split_barrier.image_id, permutation).size();
+                }
+            }
+            tl_split_barrier_wait_infos.reserve(task_batch.wait_split_barrier_indices.size());
+            tl_memory_barrier_infos.reserve(task_batch.wait_split_barrier_indices.size());
+            tl_image_barrier_infos.reserve(needed_image_barriers);
+            for (auto barrier_index : task_batch.wait_split_barrier_indices)
+            {
+                TaskSplitBarrier & split_barrier = permutation.split_barriers[barrier_index];
+                if (split_barrier.image_id.is_empty())
+                {
+                    tl_memory_barrier_infos.push_back(MemoryBarrierInfo{
+                        .src_access = split_barrier.src_access,
+                        .dst_access = split_barrier.dst_access,
+                    });
+                    tl_split_barrier_wait_infos.push_back(EventWaitInfo{
+                        .memory_barriers = std::span{&tl_memory_barrier_infos.back(), 1},
+                        .event = split_barrier.split_barrier_state,
+                    });
+                }
+                else
+                {
+                    usize const img_bar_vec_start_size = tl_image_barrier_infos.size();
+                    for (auto image : impl.get_actual_images(split_barrier.image_id, permutation))
+                    {
+                        tl_image_barrier_infos.push_back(ImageMemoryBarrierInfo{
+                            .src_access = split_barrier.src_access,
+                            .dst_access = split_barrier.dst_access,
+                            .src_layout = split_barrier.layout_before,
+                            .dst_layout = split_barrier.layout_after,
+                            .image_slice = split_barrier.slice,
+                            .image_id = image,
+                        });
+                    }
+                    usize const img_bar_vec_end_size = tl_image_barrier_infos.size();
+                    usize const img_bar_count = img_bar_vec_end_size - img_bar_vec_start_size;
+                    tl_split_barrier_wait_infos.push_back(EventWaitInfo{
+                        .image_barriers = std::span{tl_image_barrier_infos.data() + img_bar_vec_start_size, img_bar_count},
+                        .event = split_barrier.split_barrier_state,
+                    });
+                }
+            }
+            if (!tl_split_barrier_wait_infos.empty())
+            {
+                recorder.wait_events(tl_split_barrier_wait_infos);
+            }
+            tl_split_barrier_wait_infos.clear();
+            tl_image_barrier_infos.clear();
+            tl_memory_barrier_infos.clear();
+        }
+    }
+
+    void insert_post_batch_synch(ImplTaskGraph const & impl, TaskGraphPermutation & permutation, TaskBatch & task_batch, CommandRecorder & recorder)
+    {
+        if (impl.info.use_split_barriers)
+        {
+            // Reset all waited upon split barriers here.
+            for (auto barrier_index : task_batch.wait_split_barrier_indices)
+            {
+                // We wait on the stages, that waited on our split barrier earlier.
+                // This way, we make sure, that the stages that wait on the split barrier
+                // executed and saw the split barrier signaled, before we reset them.
+                recorder.reset_event({
+                    .event = permutation.split_barriers[barrier_index].split_barrier_state,
+                    .stage = permutation.split_barriers[barrier_index].dst_access.stages,
+                });
+            }
+            // Signal all signal split barriers after batch execution.
+            for (usize const barrier_index : task_batch.signal_split_barrier_indices)
+            {
+                TaskSplitBarrier & task_split_barrier = permutation.split_barriers[barrier_index];
+                if (task_split_barrier.image_id.is_empty())
+                {
+                    MemoryBarrierInfo memory_barrier{
+                        .src_access = task_split_barrier.src_access,
+                        .dst_access = task_split_barrier.dst_access,
+                    };
+                    recorder.signal_event({
+                        .memory_barriers = std::span{&memory_barrier, 1},
+                        .event = task_split_barrier.split_barrier_state,
+                    });
+                }
+                else
+                {
+                    for (auto image : impl.get_actual_images(task_split_barrier.image_id, permutation))
+                    {
+                        tl_image_barrier_infos.push_back({
+                            .src_access = task_split_barrier.src_access,
+                            .dst_access = task_split_barrier.dst_access,
+                            .src_layout = task_split_barrier.layout_before,
+                            .dst_layout = task_split_barrier.layout_after,
+                            .image_slice = task_split_barrier.slice,
+                            .image_id = image,
+                        });
+                    }
+                    recorder.signal_event({
+                        .image_barriers = tl_image_barrier_infos,
+                        .event = task_split_barrier.split_barrier_state,
+                    });
+                    tl_image_barrier_infos.clear();
+                }
+            }
+        }
+    }
+
+    static constexpr usize PARALLEL_RECORDING_MIN_TASKS_PER_CHUNK = 4;
+
+    // Records the tasks [first_task, end_task) of a submit scope, counting the tasks of all batches in the scope.
+    // The synch before and after a batch is recorded by the range containing the batches first and last task.
+    // Recording all ranges in order yields the same commands as recording the whole scope at once.
+    void record_submit_scope_tasks(ImplTaskGraph & impl, ImplTaskRuntimeInterface & impl_runtime, TaskBatchSubmitScope & submit_scope, usize first_task, usize end_task, usize scope_task_count)
+    {
+        TaskGraphPermutation & permutation = impl_runtime.permutation;
+        // Synch of empty batches after the last task belongs to the last range.
+        auto const owns_synch = [&](usize scope_task_index)
+        { return scope_task_index >= first_task && (scope_task_index < end_task || end_task == scope_task_count); };
+        usize batch_first_task = 0;
+        usize batch_index = 0;
+        for (auto & task_batch : permutation.submit_scope_batches(submit_scope))
+        {
+            batch_index += 1;
+            if (owns_synch(batch_first_task))
+            {
+                insert_pre_batch_synch(impl, permutation, task_batch, impl_runtime.recorder);
+            }
+            // Execute all tasks of the batch within the range.
+            for (usize task_index = 0; task_index < task_batch.tasks.size(); ++task_index)
+            {
+                usize const scope_task_index = batch_first_task + task_index;
+                if (scope_task_index >= first_task && scope_task_index < end_task)
+                {
+                    impl.execute_task(impl_runtime, permutation, static_cast<u32>(batch_index), task_index, task_batch.tasks[task_index]);
+                }
+            }
+            usize const batch_last_task = batch_first_task + std::max(task_batch.tasks.size(), usize{1}) - 1;
+            if (owns_synch(batch_last_task))
+            {
+                insert_post_batch_synch(impl, permutation, task_batch, impl_runtime.recorder);
+            }
+            batch_first_task += task_batch.tasks.size();
+        }
+    }
+
+    // Splits the tasks of the submit scope into chunk_count contiguous ranges and records each range on its own thread.
+    // The calling thread records the first range into the main recorder, the recording workers of the task graph record the other ranges with their own recorders and staging memory.
+    // Returns the command lists of all ranges in submission order.
+    auto record_submit_scope_parallel(ImplTaskGraph & impl, ImplTaskRuntimeInterface & impl_runtime, TaskBatchSubmitScope & submit_scope, usize submit_scope_index, usize scope_task_count, usize chunk_count) -> std::vector<ExecutableCommandList>
+    {
+        std::vector<ExecutableCommandList> chunk_commands(chunk_count);
+        std::vector<std::exception_ptr> chunk_exceptions(chunk_count);
+        auto const record_chunk = [&](usize chunk_index, ImplTaskRuntimeInterface & chunk_runtime)
+        {
+            if (impl.info.enable_command_labels)
+            {
+                chunk_runtime.recorder.begin_label({
+                    .label_color = impl.info.task_graph_label_color,
+                    .name = impl.info.name + std::string(", submit ") + std::to_string(submit_scope_index) + std::string(", part ") + std::to_string(chunk_index),
+                });
+            }
+            usize const first_task = scope_task_count * chunk_index / chunk_count;
+            usize const end_task = scope_task_count * (chunk_index + 1) / chunk_count;
+            record_submit_scope_tasks(impl, chunk_runtime, submit_scope, first_task, end_task, scope_task_count);
+            if (impl.info.enable_command_labels)
+            {
+                chunk_runtime.recorder.end_label();
+            }
+            chunk_commands[chunk_index] = chunk_runtime.recorder.complete_current_commands();
+        };
+        // Worker n records chunk n + 1 with its own staging memory.
+        // Command recorders take their command pools from the device's pool of recycled pools, so creating one per chunk is cheap.
+        // Keeping them across executions would hold on to all their command buffers, as those are only freed with the recorder.
+        impl.recording_workers.dispatch(
+            chunk_count - 1,
+            [&](usize worker_index)
+            {
+                usize const chunk_index = worker_index + 1;
+                try
+                {
+                    CommandRecorder chunk_recorder = impl.info.device.create_command_recorder({.reusable = impl.info.static_execution});
+                    ImplTaskRuntimeInterface chunk_runtime{
+                        .task_graph = impl,
+                        .permutation = impl_runtime.permutation,
+                        .recorder = chunk_recorder,
+                        .staging_memory = impl.parallel_staging_memories.empty() ? nullptr : &impl.parallel_staging_memories[worker_index],
+                    };
+                    record_chunk(chunk_index, chunk_runtime);
+                }
+                catch (...)
+                {
+                    chunk_exceptions[chunk_index] = std::current_exception();
+                }
+            });
+        try
+        {
+            record_chunk(0, impl_runtime);
+        }
+        catch (...)
+        {
+            chunk_exceptions[0] = std::current_exception();
+        }
+        impl.recording_workers.wait();
+        for (auto const & exception : chunk_exceptions)
+        {
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+        return chunk_commands;
+    }
+
+    TaskRecordingWorkers::~TaskRecordingWorkers()
+    {
+        {
+            std::unique_lock const lock{mtx};
+            stop = true;
+        }
+        work_cv.notify_all();
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void TaskRecordingWorkers::start(u32 worker_count)
+    {
+        threads.reserve(worker_count);
+        for (u32 worker_index = 0; worker_index < worker_count; ++worker_index)
+        {
+            threads.push_back(std::thread{[this, worker_index]()
+                                          { worker_loop(worker_index); }});
+        }
+    }
+
+    // The job must stay valid until wait returns.
+    void TaskRecordingWorkers::dispatch(usize worker_count, std::function<void(usize)> a_job)
+    {
+        DAXA_DBG_ASSERT_TRUE_M(worker_count <= threads.size(), "dispatched more recording jobs than there are workers");
+        {
+            std::unique_lock const lock{mtx};
+            job = std::move(a_job);
+            job_worker_count = worker_count;
+            pending_worker_count = worker_count;
+            job_generation += 1;
+        }
+        work_cv.notify_all();
+    }
+
+    void TaskRecordingWorkers::wait()
+    {
+        std::unique_lock lock{mtx};
+        done_cv.wait(lock, [&]()
+                     { return pending_worker_count == 0; });
+        job = {};
+    }
+
+    void TaskRecordingWorkers::worker_loop(usize worker_index)
+    {
+        u64 last_generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock lock{mtx};
+                work_cv.wait(lock, [&]()
+                             { return stop || job_generation != last_generation; });
+                if (stop)
+                {
+                    return;
+                }
+                last_generation = job_generation;
+                if (worker_index >= job_worker_count)
+                {
+                    continue;
+                }
+            }
+            // The job is only replaced after all participating workers finished it.
+            job(worker_index);
+            bool last_worker = false;
+            {
+                std::unique_lock const lock{mtx};
+                pending_worker_count -= 1;
+                last_worker = pending_worker_count == 0;
+            }
+            if (last_worker)
+            {
+                done_cv.notify_one();
+            }
+        }
+    }
+
+    auto create_queue_command_recorder(ImplTaskGraph & impl, Queue queue) -> CommandRecorder
+    {
+        if (queue.family == QueueFamily::MAIN)
+        {
+            return impl.info.device.create_command_recorder({.reusable = impl.info.static_execution});
+        }
+        // Tasks always record into a CommandRecorder. It wraps the same handle as the compute and transfer recorders,
+        // so it is created through the c api to skip the main queue family check of Device::create_command_recorder.
+        CommandRecorderInfo const recorder_info = {
+            .queue_family = queue.family,
+            .name = std::string("tg \"") + impl.info.name + "\" " + std::string(to_string(queue.family)) + " " + std::to_string(queue.index),
+            .reusable = impl.info.static_execution,
+        };
+        CommandRecorder recorder = {};
+        [[maybe_unused]] daxa_Result const result = daxa_dvc_create_command_recorder(
+            *r_cast<daxa_Device *>(&impl.info.device),
+            r_cast<daxa_CommandRecorderInfo const *>(&recorder_info),
+            r_cast<daxa_CommandRecorder *>(&recorder));
+        DAXA_DBG_ASSERT_TRUE_M(result == DAXA_RESULT_SUCCESS, "failed to create task graph command recorder for async queue");
+        return recorder;
+    }
+
+    auto queue_timeline_semaphore(ImplTaskGraph & impl, Queue queue) -> TimelineSemaphore &
+    {
+        TimelineSemaphore & semaphore = impl.queue_timeline_semaphores[queue_flat_index(queue)];
+        if (!semaphore.is_valid())
+        {
+            semaphore = impl.info.device.create_timeline_semaphore({
+                .initial_value = 0,
+                .name = std::string("tg \"") + impl.info.name + "\" " + std::string(to_string(queue.family)) + " " + std::to_string(queue.index) + " timeline",
+            });
+        }
+        return semaphore;
+    }
+
+    // A run of consecutive batches of a submit scope on the same queue, submitted as one unit.
+    // Records the batches of a submit scope using async queues, one command list per run of batches on the same queue.
+    // The first segment contains the main queue commands recorded before the scope. All other segments wait on it.
+    auto record_submit_scope_queue_segments(ImplTaskGraph & impl, ImplTaskRuntimeInterface & impl_runtime, TaskBatchSubmitScope & submit_scope, usize submit_scope_index) -> std::vector<QueueSegment>
+    {
+        TaskGraphPermutation & permutation = impl_runtime.permutation;
+        std::vector<QueueSegment> segments = {};
+        segments.push_back(QueueSegment{.queue = QUEUE_MAIN, .commands = impl_runtime.recorder.complete_current_commands()});
+        std::array<std::optional<CommandRecorder>, TASK_GRAPH_QUEUE_COUNT> async_recorders = {};
+        std::span<TaskBatch> const task_batches = permutation.submit_scope_batches(submit_scope);
+        std::vector<usize> batch_segment_indices(task_batches.size());
+        CommandRecorder * segment_recorder = {};
+        auto const finish_segment = [&]()
+        {
+            if (segment_recorder == nullptr)
+            {
+                return;
+            }
+            if (impl.info.enable_command_labels)
+            {
+                segment_recorder->end_label();
+            }
+            segments.back().commands = segment_recorder->complete_current_commands();
+        };
+        for (usize batch_index = 0; batch_index < task_batches.size(); ++batch_index)
+        {
+            TaskBatch & task_batch = task_batches[batch_index];
+            bool const starts_segment =
+                segment_recorder == nullptr ||
+                (!task_batch.tasks.empty() && queue_flat_index(task_batch.queue) != queue_flat_index(segments.back().queue));
+            if (starts_segment)
+            {
+                finish_segment();
+                segments.push_back(QueueSegment{.queue = task_batch.queue});
+                if (task_batch.queue.family == QueueFamily::MAIN)
+                {
+                    segment_recorder = &impl_runtime.recorder;
+                }
+                else
+                {
+                    auto & async_recorder = async_recorders[queue_flat_index(task_batch.queue)];
+                    if (!async_recorder.has_value())
+                    {
+                        async_recorder = create_queue_command_recorder(impl, task_batch.queue);
                     }
+                    segment_recorder = &async_recorder.value();
                 }
-                if (impl.info.record_debug_information)
+                if (impl.info.enable_command_labels)
                 {
-                    end_indent(out, indent);
-                    fmt::format_to(std::back_inserter(out), "{}sync from undefined:\n", indent);
-                    begin_indent(out, indent, true);
+                    segment_recorder->begin_label({
+                        .label_color = impl.info.task_graph_label_color,
+                        .name = impl.info.name + std::string(", submit ") + std::to_string(submit_scope_index) + std::string(", ") + std::string(to_string(task_batch.queue.family)) + std::string(" queue ") + std::to_string(task_batch.queue.index),
+                    });
                 }
-                // For all first uses that did NOT intersect with and previous use,
-                // we need to synchronize from an undefined state to initialize the layout of the image.
-                for (auto & remaining_first_accesse : remaining_first_accesses)
+            }
+            batch_segment_indices[batch_index] = segments.size() - 1;
+            for (usize const wait_batch_index : task_batch.cross_queue_wait_batch_indices)
+            {
+                usize const wait_segment_index = batch_segment_indices[wait_batch_index];
+                auto & wait_segment_indices = segments.back().wait_segment_indices;
+                if (std::find(wait_segment_indices.begin(), wait_segment_indices.end(), wait_segment_index) == wait_segment_indices.end())
                 {
-                    for (auto execution_image_id : impl.get_actual_images(TaskImageView{{.task_graph_index = impl.unique_index, .index = task_image_index}}, permutation))
-                    {
-                        ImageMemoryBarrierInfo const img_barrier_info{
-                            .src_access = AccessConsts::NONE,
-                            .dst_access = remaining_first_accesse.state.latest_access,
-                            .src_layout = ImageLayout::UNDEFINED,
-                            .dst_layout = remaining_first_accesse.state.latest_layout,
-                            .image_slice = remaining_first_accesse.state.slice,
-                            .image_id = execution_image_id,
-                        };
-                        recorder.pipeline_barrier_image_transition(img_barrier_info);
-                        if (impl.info.record_debug_information)
-                        {
-                            fmt::format_to(std::back_inserter(out), "{}{}\n", indent, to_string(img_barrier_info));
-                            print_separator_to(out, indent);
-                        }
-                    }
+                    wait_segment_indices.push_back(wait_segment_index);
                 }
-                if (impl.info.record_debug_information)
+            }
+            ImplTaskRuntimeInterface segment_runtime{
+                .task_graph = impl,
+                .permutation = permutation,
+                .recorder = *segment_recorder,
+                .staging_memory = impl_runtime.staging_memory,
+            };
+            insert_pre_batch_synch(impl, permutation, task_batch, *segment_recorder);
+            for (usize task_index = 0; task_index < task_batch.tasks.size(); ++task_index)
+            {
+                impl.execute_task(segment_runtime, permutation, static_cast<u32>(batch_index + 1), task_index, task_batch.tasks[task_index]);
+            }
+            insert_post_batch_synch(impl, permutation, task_batch, *segment_recorder);
+        }
+        finish_segment();
+        return segments;
+    }
+
+    // Submits the queue segments of a submit scope.
+    // The first segment waits on the submit scopes semaphores and on all previous submissions of the task graph on any queue.
+    // Returns the final value of every queue used, the main queue submission closing the submit scope must wait on them.
+    auto submit_queue_segments(
+        ImplTaskGraph & impl,
+        std::vector<QueueSegment> & segments,
+        PipelineStageFlags wait_stages,
+        std::span<BinarySemaphore const> wait_binary_semaphores,
+        std::span<std::pair<TimelineSemaphore, u64> const> wait_timeline_semaphores)
+        -> std::vector<std::pair<TimelineSemaphore, u64>>
+    {
+        std::vector<std::pair<TimelineSemaphore, u64>> gate_wait_timeline_semaphores = {wait_timeline_semaphores.begin(), wait_timeline_semaphores.end()};
+        for (u32 queue_index = 0; queue_index < TASK_GRAPH_QUEUE_COUNT; ++queue_index)
+        {
+            if (impl.queue_timeline_semaphores[queue_index].is_valid() && impl.queue_timeline_values[queue_index] != 0)
+            {
+                gate_wait_timeline_semaphores.emplace_back(impl.queue_timeline_semaphores[queue_index], impl.queue_timeline_values[queue_index]);
+            }
+        }
+        std::array<u64, TASK_GRAPH_QUEUE_COUNT> join_values = {};
+        for (usize segment_index = 0; segment_index < segments.size(); ++segment_index)
+        {
+            QueueSegment & segment = segments[segment_index];
+            u32 const flat_queue_index = queue_flat_index(segment.queue);
+            segment.signal_value = ++impl.queue_timeline_values[flat_queue_index];
+            join_values[flat_queue_index] = segment.signal_value;
+            std::array<std::pair<TimelineSemaphore, u64>, 1> const signal_timeline_semaphores = {
+                std::pair{queue_timeline_semaphore(impl, segment.queue), segment.signal_value},
+            };
+            if (segment_index == 0)
+            {
+                impl.info.device.submit_commands({
+                    .queue = segment.queue,
+                    .wait_stages = wait_stages,
+                    .command_lists = std::span{&segment.commands, 1},
+                    .wait_binary_semaphores = wait_binary_semaphores,
+                    .wait_timeline_semaphores = gate_wait_timeline_semaphores,
+                    .signal_timeline_semaphores = signal_timeline_semaphores,
+                });
+                continue;
+            }
+            // Semaphore waits only order the submission they are part of, so every segment waits on the first segment explicitly.
+            std::array<u64, TASK_GRAPH_QUEUE_COUNT> wait_values = {};
+            wait_values[0] = segments[0].signal_value;
+            for (usize const wait_segment_index : segment.wait_segment_indices)
+            {
+                u32 const wait_queue_index = queue_flat_index(segments[wait_segment_index].queue);
+                wait_values[wait_queue_index] = std::max(wait_values[wait_queue_index], segments[wait_segment_index].signal_value);
+            }
+            std::vector<std::pair<TimelineSemaphore, u64>> segment_wait_timeline_semaphores = {};
+            for (u32 queue_index = 0; queue_index < TASK_GRAPH_QUEUE_COUNT; ++queue_index)
+            {
+                if (wait_values[queue_index] != 0)
                 {
-                    end_indent(out, indent);
+                    segment_wait_timeline_semaphores.emplace_back(impl.queue_timeline_semaphores[queue_index], wait_values[queue_index]);
                 }
             }
+            impl.info.device.submit_commands({
+                .queue = segment.queue,
+                .command_lists = std::span{&segment.commands, 1},
+                .wait_timeline_semaphores = segment_wait_timeline_semaphores,
+                .signal_timeline_semaphores = signal_timeline_semaphores,
+            });
+        }
+        std::vector<std::pair<TimelineSemaphore, u64>> joins = {};
+        for (u32 queue_index = 0; queue_index < TASK_GRAPH_QUEUE_COUNT; ++queue_index)
+        {
+            if (join_values[queue_index] != 0)
+            {
+                joins.emplace_back(impl.queue_timeline_semaphores[queue_index], join_values[queue_index]);
+            }
         }
-        if (impl.info.record_debug_information)
+        return joins;
+    }
+
+    // Collects the runtime resources of all persistent task resources used by the permutation.
+    // Static execution replays the recorded commands only while these stay the same.
+    void collect_static_resource_ids(ImplTaskGraph const & impl, TaskGraphPermutation const & permutation, std::vector<GPUResourceId> & out)
+    {
+        for (usize task_buffer_index = 0; task_buffer_index < permutation.buffer_infos.size(); ++task_buffer_index)
         {
-            end_indent(out, indent);
-            impl.debug_string_stream << out;
+            if (!permutation.buffer_infos[task_buffer_index].valid || !impl.global_buffer_infos[task_buffer_index].is_persistent())
+            {
+                continue;
+            }
+            std::visit([&](auto const & runtime_ids)
+                       { out.insert(out.end(), runtime_ids.begin(), runtime_ids.end()); },
+                       impl.global_buffer_infos[task_buffer_index].get_persistent().actual_ids);
+        }
+        for (usize task_image_index = 0; task_image_index < permutation.image_infos.size(); ++task_image_index)
+        {
+            if (!permutation.image_infos[task_image_index].valid || !impl.global_image_infos[task_image_index].is_persistent())
+            {
+                continue;
+            }
+            auto const & runtime_images = impl.global_image_infos[task_image_index].get_persistent().actual_images;
+            out.insert(out.end(), runtime_images.begin(), runtime_images.end());
+        }
+    }
+
+    // Allocations and submissions both advance the timeline values of the staging memory pools.
+    auto staging_memory_timeline_sum(ImplTaskGraph const & impl) -> u64
+    {
+        u64 sum = impl.staging_memory.has_value() ? impl.staging_memory->timeline_value() : 0;
+        for (auto const & parallel_staging_memory : impl.parallel_staging_memories)
+        {
+            sum += parallel_staging_memory.timeline_value();
         }
+        return sum;
     }
 
     /// Execution flow:
@@ -2892,7 +5007,7 @@ namespace daxa
     /// 2. validate used persistent resources, based on permutation
     /// 3. runtime generate and insert runtime sync for persistent resources.
     /// 4. for every submit scope:
-    ///     2.1 for every batch in scope:
+    ///     2.1 for every batch in scope, split into ranges recorded on separate threads with parallel recording:
     ///         3.1 wait for pipeline and split barriers
     ///         3.2 for every task:
     ///             4.1 validate runtime resources of used resources
@@ -2900,8 +5015,11 @@ namespace daxa
     ///             4.3 collect shader use handles, allocate gpu local staging memory, copy in handles and bind to constant buffer binding.
     ///             4.4 run task
     ///         3.3 signal split barriers
-    ///     2.2 check if submit scope submits work, either submit or collect cmd lists and sync primitives for query
-    ///     2.3 check if submit scope presents, present if true.
+    ///     2.2 scopes with batches on async queues record one command list per run of batches on the same queue instead,
+    ///         submitting each to its queue with timeline semaphore waits on the runs they depend on
+    ///     2.3 check if submit scope submits work, either submit or collect cmd lists and sync primitives for query
+    ///     2.4 check if submit scope presents, present if true.
+    /// With static execution, the commands of 4. are only recorded when the permutations runtime resources changed and are resubmitted otherwise.
     void TaskGraph::execute(ExecutionInfo const & info)
     {
         auto & impl = *r_cast<ImplTaskGraph *>(this->object);
@@ -2914,181 +5032,211 @@ namespace daxa
             permutation_index |= info.permutation_condition_values[index] ? (1u << index) : 0;
         }
         impl.chosen_permutation_last_execution = permutation_index;
-        TaskGraphPermutation & permutation = impl.permutations[permutation_index];
+        TaskGraphPermutation & permutation = impl.info.jit_compile_permutations ? impl.get_jit_permutation(permutation_index) : impl.permutations[permutation_index];
+
+        impl.update_transient_heap_resources(permutation);
+        // Consecutive executions use the transient resources of the frames in flight round robin.
+        if (impl.executed_once)
+        {
+            impl.transient_frame_index = (impl.transient_frame_index + 1) % impl.info.frames_in_flight;
+        }
+        impl.activate_transient_frame(permutation, impl.transient_frame_index);
+
+        // Static execution resubmits the commands recorded in an earlier execution of the permutation,
+        // as long as the runtime resources they were recorded with are unchanged.
+        bool replay_static_commands = false;
+        // Timeline values of the staging memory pools after the last submission, used to detect allocations of the recording.
+        u64 staging_memory_timeline = staging_memory_timeline_sum(impl);
+        if (impl.info.static_execution)
+        {
+            std::vector<GPUResourceId> persistent_resource_ids = {};
+            collect_static_resource_ids(impl, permutation, persistent_resource_ids);
+            u64 const transient_heap_generation = impl.transient_heap() != nullptr ? impl.transient_heap()->generation : 0;
+            if (permutation.static_commands.has_value())
+            {
+                replay_static_commands =
+                    permutation.static_commands->persistent_resource_ids == persistent_resource_ids &&
+                    permutation.static_commands->transient_heap_generation == transient_heap_generation;
+            }
+            if (replay_static_commands)
+            {
+                impl.static_execution_statistics.replayed_executions += 1;
+            }
+            else
+            {
+                impl.static_execution_statistics.recorded_executions += 1;
+                // Recording can allocate staging memory, which can overwrite the staging data read by previously recorded commands.
+                // Commands that never allocated staging memory read none and stay valid, unless they are the outdated commands of this permutation.
+                bool discarded_staging_memory_reads = false;
+                auto const invalidate = [&](TaskGraphPermutation & cached_permutation)
+                {
+                    if (!cached_permutation.static_commands.has_value())
+                    {
+                        return;
+                    }
+                    bool const uses_staging_memory = cached_permutation.static_commands->uses_staging_memory;
+                    if (uses_staging_memory || &cached_permutation == &permutation)
+                    {
+                        cached_permutation.static_commands.reset();
+                        impl.static_execution_statistics.invalidations += 1;
+                        discarded_staging_memory_reads = discarded_staging_memory_reads || uses_staging_memory;
+                    }
+                };
+                for (auto & cached_permutation : impl.permutations)
+                {
+                    invalidate(cached_permutation);
+                }
+                for (auto & [cached_permutation_index, jit_permutation] : impl.jit_permutations)
+                {
+                    invalidate(jit_permutation.permutation);
+                }
+                if (discarded_staging_memory_reads)
+                {
+                    // The staging memory pools only know about the submission that recorded the discarded commands, not about their replays.
+                    // Every submission of the task graph signals the timelines of its staging memory pools,
+                    // so waiting on the values of the latest submission waits for the in flight replays, without stalling other work on the device.
+                    // The discarded command lists themselves are retired by the device's garbage collection.
+                    for (auto & [timeline_semaphore, value] : impl.staging_memory_submit_signals)
+                    {
+                        [[maybe_unused]] bool const reached = timeline_semaphore.wait_for_value(value);
+                        DAXA_DBG_ASSERT_TRUE_M(reached, "failed to wait for the submissions reading the staging memory of discarded static commands");
+                    }
+                }
+                permutation.static_commands = StaticPermutationCommands{
+                    .persistent_resource_ids = std::move(persistent_resource_ids),
+                    .transient_heap_generation = transient_heap_generation,
+                };
+            }
+        }
 
-        CommandRecorder recorder = impl.info.device.create_command_recorder({});
+        CommandRecorder recorder = impl.info.device.create_command_recorder({.reusable = impl.info.static_execution});
+        if (ImplTransientHeap * heap = impl.transient_heap())
+        {
+            // Task graph only synchronizes its own accesses to the transient memory.
+            // When another graph used the heap last, its accesses to the aliased memory must finish first.
+            if (heap->last_task_graph_index != impl.unique_index && heap->last_task_graph_index != std::numeric_limits<u32>::max())
+            {
+                recorder.pipeline_barrier({
+                    .src_access = AccessConsts::READ_WRITE,
+                    .dst_access = AccessConsts::READ_WRITE,
+                });
+            }
+            heap->last_task_graph_index = impl.unique_index;
+        }
 
-        ImplTaskRuntimeInterface impl_runtime{.task_graph = impl, .permutation = permutation, .recorder = recorder};
+        ImplTaskRuntimeInterface impl_runtime{
+            .task_graph = impl,
+            .permutation = permutation,
+            .recorder = recorder,
+            .staging_memory = impl.staging_memory.has_value() ? &impl.staging_memory.value() : nullptr,
+        };
 
         validate_runtime_resources(impl, permutation);
         // Generate and insert synchronization for persistent resources:
         generate_persistent_resource_synch(impl, permutation, recorder);
+        // The synch for persistent resources depends on previous executions, so it is never part of the static commands.
+        std::optional<ExecutableCommandList> static_prefix_commands = {};
+        if (impl.info.static_execution)
+        {
+            static_prefix_commands = recorder.complete_current_commands();
+        }
 
         usize submit_scope_index = 0;
         for (auto & submit_scope : permutation.batch_submit_scopes)
         {
-            if (impl.info.enable_command_labels)
+            usize scope_task_count = 0;
+            std::span<TaskBatch const> const task_batches = permutation.submit_scope_batches(submit_scope);
+            for (auto const & task_batch : task_batches)
             {
-                impl_runtime.recorder.begin_label({
-                    .label_color = impl.info.task_graph_label_color,
-                    .name = impl.info.name + std::string(", submit ") + std::to_string(submit_scope_index),
-                });
+                scope_task_count += task_batch.tasks.size();
+            }
+            usize const chunk_count = std::min(
+                static_cast<usize>(impl.recording_thread_count),
+                (scope_task_count + PARALLEL_RECORDING_MIN_TASKS_PER_CHUNK - 1) / PARALLEL_RECORDING_MIN_TASKS_PER_CHUNK);
+            std::vector<ExecutableCommandList> chunk_commands = {};
+            // Commands recorded after the last submit are never submitted, they are recorded on the main queue.
+            bool const uses_async_queues =
+                &submit_scope != &permutation.batch_submit_scopes.back() &&
+                std::any_of(task_batches.begin(), task_batches.end(), [](TaskBatch const & task_batch)
+                            { return task_batch.queue.family != QueueFamily::MAIN; });
+            std::vector<QueueSegment> queue_segments = {};
+            if (replay_static_commands)
+            {
+                // All commands of the scope are already recorded.
             }
-            usize batch_index = 0;
-            for (auto & task_batch : submit_scope.task_batches)
+            else if (uses_async_queues)
             {
-                batch_index += 1;
-                // Wait on pipeline barriers before batch execution.
-                for (auto barrier_index : task_batch.pipeline_barrier_indices)
+                queue_segments = record_submit_scope_queue_segments(impl, impl_runtime, submit_scope, submit_scope_index);
+            }
+            else if (chunk_count > 1)
+            {
+                chunk_commands = record_submit_scope_parallel(impl, impl_runtime, submit_scope, submit_scope_index, scope_task_count, chunk_count);
+            }
+            else
+            {
+                if (impl.info.enable_command_labels)
+                {
+                    impl_runtime.recorder.begin_label({
+                        .label_color = impl.info.task_graph_label_color,
+                        .name = impl.info.name + std::string(", submit ") + std::to_string(submit_scope_index),
+                    });
+                }
+                record_submit_scope_tasks(impl, impl_runtime, submit_scope, 0, scope_task_count, scope_task_count);
+            }
+            if (!replay_static_commands)
+            {
+                for (usize const barrier_index : submit_scope.last_minute_barrier_indices)
                 {
                     TaskBarrier & barrier = permutation.barriers[barrier_index];
                     insert_pipeline_barrier(impl, permutation, impl_runtime.recorder, barrier);
                 }
-                // Wait on split barriers before batch execution.
-                if (!impl.info.use_split_barriers)
+                if (impl.info.enable_command_labels && chunk_count <= 1 && !uses_async_queues)
                 {
-                    for (auto barrier_index : task_batch.wait_split_barrier_indices)
-                    {
-                        TaskSplitBarrier const & split_barrier = permutation.split_barriers[barrier_index];
-                        // Convert split barrier to normal barrier.
-                        TaskBarrier barrier = split_barrier;
-                        insert_pipeline_barrier(impl, permutation, impl_runtime.recorder, barrier);
-                    }
+                    impl_runtime.recorder.end_label();
                 }
-                else
+            }
+
+            if (&submit_scope != &permutation.batch_submit_scopes.back())
+            {
+                PipelineStageFlags wait_stages = submit_scope.submit_info.wait_stages;
+                std::vector<ExecutableCommandList> commands = {submit_scope.submit_info.command_lists.begin(), submit_scope.submit_info.command_lists.end()};
+                std::vector<BinarySemaphore> wait_binary_semaphores = {submit_scope.submit_info.wait_binary_semaphores.begin(), submit_scope.submit_info.wait_binary_semaphores.end()};
+                std::vector<BinarySemaphore> signal_binary_semaphores = {submit_scope.submit_info.signal_binary_semaphores.begin(), submit_scope.submit_info.signal_binary_semaphores.end()};
+                std::vector<std::pair<TimelineSemaphore, u64>> wait_timeline_semaphores = {submit_scope.submit_info.wait_timeline_semaphores.begin(), submit_scope.submit_info.wait_timeline_semaphores.end()};
+                std::vector<std::pair<TimelineSemaphore, u64>> signal_timeline_semaphores = {submit_scope.submit_info.signal_timeline_semaphores.begin(), submit_scope.submit_info.signal_timeline_semaphores.end()};
+                if (impl.info.static_execution)
                 {
-                    usize needed_image_barriers = 0;
-                    for (auto barrier_index : task_batch.wait_split_barrier_indices)
+                    auto & static_submit_scopes = permutation.static_commands->submit_scopes;
+                    if (!replay_static_commands)
                     {
-                        TaskSplitBarrier const & split_barrier = permutation.split_barriers[barrier_index];
-                        if (!split_barrier.image_id.is_empty())
-                        {
-                            needed_image_barriers += impl.get_actual_images(split_barrier.image_id, permutation).size();
-                        }
+                        // The queue segments are copied before submitting, as submitting assigns their signal values.
+                        StaticSubmitScopeCommands & static_scope = static_submit_scopes.emplace_back();
+                        static_scope.queue_segments = queue_segments;
+                        static_scope.command_lists = std::move(chunk_commands);
+                        static_scope.command_lists.push_back(recorder.complete_current_commands());
                     }
-                    tl_split_barrier_wait_infos.reserve(task_batch.wait_split_barrier_indices.size());
-                    tl_memory_barrier_infos.reserve(task_batch.wait_split_barrier_indices.size());
-                    tl_image_barrier_infos.reserve(needed_image_barriers);
-                    for (auto barrier_index : task_batch.wait_split_barrier_indices)
+                    StaticSubmitScopeCommands const & static_scope = static_submit_scopes.at(submit_scope_index);
+                    if (uses_async_queues)
                     {
-                        TaskSplitBarrier & split_barrier = permutation.split_barriers[barrier_index];
-                        if (split_barrier.image_id.is_empty())
-                        {
-                            tl_memory_barrier_infos.push_back(MemoryBarrierInfo{
-                                .src_access = split_barrier.src_access,
-                                .dst_access = split_barrier.dst_access,
-                            });
-                            tl_split_barrier_wait_infos.push_back(EventWaitInfo{
-                                .memory_barriers = std::span{&tl_memory_barrier_infos.back(), 1},
-                                .event = split_barrier.split_barrier_state,
-                            });
-                        }
-                        else
+                        queue_segments = static_scope.queue_segments;
+                        // The first segment runs before all other segments of the scope, it takes the place of the prefix.
+                        if (submit_scope_index == 0)
                         {
-                            usize const img_bar_vec_start_size = tl_image_barrier_infos.size();
-                            for (auto image : impl.get_actual_images(split_barrier.image_id, permutation))
-                            {
-                                tl_image_barrier_infos.push_back(ImageMemoryBarrierInfo{
-                                    .src_access = split_barrier.src_access,
-                                    .dst_access = split_barrier.dst_access,
-                                    .src_layout = split_barrier.layout_before,
-                                    .dst_layout = split_barrier.layout_after,
-                                    .image_slice = split_barrier.slice,
-                                    .image_id = image,
-                                });
-                            }
-                            usize const img_bar_vec_end_size = tl_image_barrier_infos.size();
-                            usize const img_bar_count = img_bar_vec_end_size - img_bar_vec_start_size;
-                            tl_split_barrier_wait_infos.push_back(EventWaitInfo{
-                                .image_barriers = std::span{tl_image_barrier_infos.data() + img_bar_vec_start_size, img_bar_count},
-                                .event = split_barrier.split_barrier_state,
-                            });
+                            queue_segments.at(0).commands = static_prefix_commands.value();
                         }
                     }
-                    if (!tl_split_barrier_wait_infos.empty())
+                    else if (submit_scope_index == 0)
                     {
-                        impl_runtime.recorder.wait_events(tl_split_barrier_wait_infos);
+                        commands.push_back(static_prefix_commands.value());
                     }
-                    tl_split_barrier_wait_infos.clear();
-                    tl_image_barrier_infos.clear();
-                    tl_memory_barrier_infos.clear();
+                    commands.insert(commands.end(), static_scope.command_lists.begin(), static_scope.command_lists.end());
                 }
-                // Execute all tasks in the batch.
-                usize task_index = 0;
-                for (TaskId const task_id : task_batch.tasks)
-                {
-                    impl.execute_task(impl_runtime, permutation, batch_index, task_index, task_id);
-                    task_index += 1;
-                }
-                if (impl.info.use_split_barriers)
+                else
                 {
-                    // Reset all waited upon split barriers here.
-                    for (auto barrier_index : task_batch.wait_split_barrier_indices)
-                    {
-                        // We wait on the stages, that waited on our split barrier earlier.
-                        // This way, we make sure, that the stages that wait on the split barrier
-                        // executed and saw the split barrier signaled, before we reset them.
-                        impl_runtime.recorder.reset_event({
-                            .event = permutation.split_barriers[barrier_index].split_barrier_state,
-                            .stage = permutation.split_barriers[barrier_index].dst_access.stages,
-                        });
-                    }
-                    // Signal all signal split barriers after batch execution.
-                    for (usize const barrier_index : task_batch.signal_split_barrier_indices)
-                    {
-                        TaskSplitBarrier & task_split_barrier = permutation.split_barriers[barrier_index];
-                        if (task_split_barrier.image_id.is_empty())
-                        {
-                            MemoryBarrierInfo memory_barrier{
-                                .src_access = task_split_barrier.src_access,
-                                .dst_access = task_split_barrier.dst_access,
-                            };
-                            impl_runtime.recorder.signal_event({
-                                .memory_barriers = std::span{&memory_barrier, 1},
-                                .event = task_split_barrier.split_barrier_state,
-                            });
-                        }
-                        else
-                        {
-                            for (auto image : impl.get_actual_images(task_split_barrier.image_id, permutation))
-                            {
-                                tl_image_barrier_infos.push_back({
-                                    .src_access = task_split_barrier.src_access,
-                                    .dst_access = task_split_barrier.dst_access,
-                                    .src_layout = task_split_barrier.layout_before,
-                                    .dst_layout = task_split_barrier.layout_after,
-                                    .image_slice = task_split_barrier.slice,
-                                    .image_id = image,
-                                });
-                            }
-                            impl_runtime.recorder.signal_event({
-                                .image_barriers = tl_image_barrier_infos,
-                                .event = task_split_barrier.split_barrier_state,
-                            });
-                            tl_image_barrier_infos.clear();
-                        }
-                    }
+                    // The parallel recorded ranges execute before the last minute barriers, which are recorded into the main recorder.
+                    commands.insert(commands.end(), chunk_commands.begin(), chunk_commands.end());
+                    commands.push_back(recorder.complete_current_commands());
                 }
-            }
-            for (usize const barrier_index : submit_scope.last_minute_barrier_indices)
-            {
-                TaskBarrier & barrier = permutation.barriers[barrier_index];
-                insert_pipeline_barrier(impl, permutation, impl_runtime.recorder, barrier);
-            }
-            if (impl.info.enable_command_labels)
-            {
-                impl_runtime.recorder.end_label();
-            }
-
-            if (&submit_scope != &permutation.batch_submit_scopes.back())
-            {
-                PipelineStageFlags const wait_stages = submit_scope.submit_info.wait_stages;
-                std::vector<ExecutableCommandList> commands = {submit_scope.submit_info.command_lists.begin(), submit_scope.submit_info.command_lists.end()};
-                std::vector<BinarySemaphore> wait_binary_semaphores = {submit_scope.submit_info.wait_binary_semaphores.begin(), submit_scope.submit_info.wait_binary_semaphores.end()};
-                std::vector<BinarySemaphore> signal_binary_semaphores = {submit_scope.submit_info.signal_binary_semaphores.begin(), submit_scope.submit_info.signal_binary_semaphores.end()};
-                std::vector<std::pair<TimelineSemaphore, u64>> wait_timeline_semaphores = {submit_scope.submit_info.wait_timeline_semaphores.begin(), submit_scope.submit_info.wait_timeline_semaphores.end()};
-                std::vector<std::pair<TimelineSemaphore, u64>> signal_timeline_semaphores = {submit_scope.submit_info.signal_timeline_semaphores.begin(), submit_scope.submit_info.signal_timeline_semaphores.end()};
-                commands.push_back(recorder.complete_current_commands());
                 if (impl.info.swapchain.has_value())
                 {
                     Swapchain const & swapchain = impl.info.swapchain.value();
@@ -3147,7 +5295,25 @@ namespace daxa
                 {
                     signal_timeline_semaphores.insert(signal_timeline_semaphores.end(), submit_scope.user_submit_info.additional_signal_timeline_semaphores->begin(), submit_scope.user_submit_info.additional_signal_timeline_semaphores->end());
                 }
-                signal_timeline_semaphores.emplace_back(impl.staging_memory->timeline_semaphore(), impl.staging_memory->inc_timeline_value());
+                if (uses_async_queues)
+                {
+                    // The scopes waits move to the first queue segment, the final submission joins all queues used by the scope.
+                    wait_timeline_semaphores = submit_queue_segments(impl, queue_segments, wait_stages, wait_binary_semaphores, wait_timeline_semaphores);
+                    wait_binary_semaphores.clear();
+                    wait_stages = {};
+                }
+                if (impl.info.static_execution && !replay_static_commands && staging_memory_timeline_sum(impl) != staging_memory_timeline)
+                {
+                    permutation.static_commands->uses_staging_memory = true;
+                }
+                impl.staging_memory_submit_signals.clear();
+                impl.staging_memory_submit_signals.emplace_back(impl.staging_memory->timeline_semaphore(), impl.staging_memory->inc_timeline_value());
+                for (auto & parallel_staging_memory : impl.parallel_staging_memories)
+                {
+                    impl.staging_memory_submit_signals.emplace_back(parallel_staging_memory.timeline_semaphore(), parallel_staging_memory.inc_timeline_value());
+                }
+                signal_timeline_semaphores.insert(signal_timeline_semaphores.end(), impl.staging_memory_submit_signals.begin(), impl.staging_memory_submit_signals.end());
+                staging_memory_timeline = staging_memory_timeline_sum(impl);
                 daxa::CommandSubmitInfo const submit_info = {
                     .wait_stages = wait_stages,
                     .command_lists = commands,
@@ -3179,6 +5345,10 @@ namespace daxa
             }
             ++submit_scope_index;
         }
+        if (impl.info.static_execution && !replay_static_commands && staging_memory_timeline_sum(impl) != staging_memory_timeline)
+        {
+            permutation.static_commands->uses_staging_memory = true;
+        }
 
         // Insert pervious uses into execution info for tje next executions synch.
         for (usize task_buffer_index = 0; task_buffer_index < permutation.buffer_infos.size(); ++task_buffer_index)
@@ -3196,7 +5366,9 @@ namespace daxa
                 impl.global_image_infos[task_image_index].is_persistent())
             {
                 auto & persistent_image = impl.global_image_infos[task_image_index].get_persistent();
-                for (auto const & extended_state : permutation.image_infos[task_image_index].last_slice_states)
+                std::vector<ExtendedImageSliceState> last_slice_states = {};
+                permutation.image_infos[task_image_index].last_slice_states.slices(last_slice_states);
+                for (auto const & extended_state : last_slice_states)
                 {
                     persistent_image.latest_slice_states.push_back(extended_state.state);
                 }
@@ -3221,23 +5393,44 @@ namespace daxa
         {
             this->staging_memory = TransferMemoryPool{TransferMemoryPoolInfo{.device = info.device, .capacity = info.staging_memory_pool_size, .use_bar_memory = true, .name = "Transfer Memory Pool"}};
         }
+        if (info.enable_parallel_recording)
+        {
+            recording_thread_count = info.parallel_recording_thread_count != 0 ? info.parallel_recording_thread_count : std::max(1u, std::thread::hardware_concurrency());
+            if (info.staging_memory_pool_size != 0)
+            {
+                parallel_staging_memories.reserve(recording_thread_count - 1);
+                for (u32 thread_index = 1; thread_index < recording_thread_count; ++thread_index)
+                {
+                    parallel_staging_memories.emplace_back(TransferMemoryPoolInfo{
+                        .device = info.device,
+                        .capacity = info.staging_memory_pool_size,
+                        .use_bar_memory = true,
+                        .name = std::string("Transfer Memory Pool ") + std::to_string(thread_index),
+                    });
+                }
+            }
+            recording_workers.start(recording_thread_count - 1);
+        }
     }
 
     ImplTaskGraph::~ImplTaskGraph()
     {
         for (auto & task : tasks)
         {
-            for (auto & view_cache : task.image_view_cache)
+            for (auto & frame_view_cache : task.frame_view_caches)
             {
-                for (auto & view : view_cache)
+                for (auto & view_cache : frame_view_cache.image_view_cache)
                 {
-                    if (info.device.is_id_valid(view))
+                    for (auto & view : view_cache)
                     {
-                        ImageId const parent = info.device.image_view_info(view).value().image;
-                        bool const is_default_view = parent.default_view() == view;
-                        if (!is_default_view)
+                        if (info.device.is_id_valid(view))
                         {
-                            info.device.destroy_image_view(view);
+                            ImageId const parent = info.device.image_view_info(view).value().image;
+                            bool const is_default_view = parent.default_view() == view;
+                            if (!is_default_view)
+                            {
+                                info.device.destroy_image_view(view);
+                            }
                         }
                     }
                 }
@@ -3245,39 +5438,39 @@ namespace daxa
         }
         for (auto & permutation : permutations)
         {
-            // because transient buffers are owned by the task graph, we need to destroy them
+            destroy_transient_runtime_resources(permutation);
+        }
+        for (auto & [permutation_index, jit_permutation] : jit_permutations)
+        {
+            destroy_transient_runtime_resources(jit_permutation.permutation);
+        }
+    }
+
+    void ImplTaskGraph::destroy_transient_runtime_resources(TaskGraphPermutation & permutation)
+    {
+        // because transient buffers and images are owned by the task graph, we need to destroy them for every frame in flight
+        for (auto const & frame : permutation.transient_frames)
+        {
             for (u32 buffer_info_idx = 0; buffer_info_idx < static_cast<u32>(global_buffer_infos.size()); buffer_info_idx++)
             {
                 auto const & global_buffer = global_buffer_infos.at(buffer_info_idx);
                 PerPermTaskBuffer const & perm_buffer = permutation.buffer_infos.at(buffer_info_idx);
-                if (!global_buffer.is_persistent() && 
-                    perm_buffer.valid)
+                if (!global_buffer.is_persistent() && perm_buffer.valid)
                 {
-                    if (auto const * id = std::get_if<BufferId>(&perm_buffer.actual_id))
-                    {
-                        info.device.destroy_buffer(*id);
-                    }
-                    if (auto const * id = std::get_if<BlasId>(&perm_buffer.actual_id))
-                    {
-                        info.device.destroy_blas(*id);
-                    }
-                    if (auto const * id = std::get_if<TlasId>(&perm_buffer.actual_id))
-                    {
-                        info.device.destroy_tlas(*id);
-                    }
+                    info.device.destroy_buffer(frame.buffers[buffer_info_idx]);
                 }
             }
-            // because transient images are owned by the task graph, we need to destroy them
             for (u32 image_info_idx = 0; image_info_idx < static_cast<u32>(global_image_infos.size()); image_info_idx++)
             {
                 auto const & global_image = global_image_infos.at(image_info_idx);
                 auto const & perm_image = permutation.image_infos.at(image_info_idx);
                 if (!global_image.is_persistent() && perm_image.valid)
                 {
-                    info.device.destroy_image(get_actual_images(TaskImageView{{.task_graph_index = unique_index, .index = image_info_idx}}, permutation)[0]);
+                    info.device.destroy_image(frame.images[image_info_idx]);
                 }
             }
         }
+        permutation.transient_frames.clear();
     }
 
     void ImplTaskGraph::print_task_image_to(std::string & out, std::string indent, TaskGraphPermutation const & permutation, TaskImageView local_id)
@@ -3403,13 +5596,7 @@ namespace daxa
 
     void ImplTaskGraph::print_permutation_aliasing_to(std::string & out, std::string indent, TaskGraphPermutation const & permutation)
     {
-        usize batches = 0;
-        std::vector<usize> submit_batch_offsets(permutation.batch_submit_scopes.size());
-        for (u32 submit_scope_idx = 0; submit_scope_idx < permutation.batch_submit_scopes.size(); submit_scope_idx++)
-        {
-            submit_batch_offsets.at(submit_scope_idx) = batches;
-            batches += permutation.batch_submit_scopes.at(submit_scope_idx).task_batches.size();
-        }
+        usize const batches = permutation.task_batches.size();
         auto print_lifetime = [&](usize start_idx, usize end_idx)
         {
             for (usize i = 0; i < batches; i++)
@@ -3448,9 +5635,9 @@ namespace daxa
             }
 
             auto const & perm_task_image = permutation.image_infos.at(perm_image_idx);
-            usize const start_idx = submit_batch_offsets.at(perm_task_image.lifetime.first_use.submit_scope_index) +
+            usize const start_idx = permutation.batch_submit_scopes.at(perm_task_image.lifetime.first_use.submit_scope_index).first_batch_index +
                                     perm_task_image.lifetime.first_use.task_batch_index;
-            usize const end_idx = submit_batch_offsets.at(perm_task_image.lifetime.last_use.submit_scope_index) +
+            usize const end_idx = permutation.batch_submit_scopes.at(perm_task_image.lifetime.last_use.submit_scope_index).first_batch_index +
                                   perm_task_image.lifetime.last_use.task_batch_index;
             fmt::format_to(std::back_inserter(out), "{}", indent);
             print_lifetime(start_idx, end_idx);
@@ -3467,9 +5654,9 @@ namespace daxa
             }
 
             auto const & perm_task_buffer = permutation.buffer_infos.at(perm_buffer_idx);
-            usize const start_idx = submit_batch_offsets.at(perm_task_buffer.lifetime.first_use.submit_scope_index) +
+            usize const start_idx = permutation.batch_submit_scopes.at(perm_task_buffer.lifetime.first_use.submit_scope_index).first_batch_index +
                                     perm_task_buffer.lifetime.first_use.task_batch_index;
-            usize const end_idx = submit_batch_offsets.at(perm_task_buffer.lifetime.last_use.submit_scope_index) +
+            usize const end_idx = permutation.batch_submit_scopes.at(perm_task_buffer.lifetime.last_use.submit_scope_index).first_batch_index +
                                   perm_task_buffer.lifetime.last_use.task_batch_index;
             fmt::format_to(std::back_inserter(out), "{}", indent);
             print_lifetime(start_idx, end_idx);
@@ -3508,9 +5695,38 @@ namespace daxa
                        info.task_label_color[3]);
         fmt::format_to(std::back_inserter(out), "record_debug_information: {}\n", info.record_debug_information);
         fmt::format_to(std::back_inserter(out), "staging_memory_pool_size: {}\n", info.staging_memory_pool_size);
+        fmt::format_to(std::back_inserter(out), "jit_compile_permutations: {}\n", info.jit_compile_permutations);
         fmt::format_to(std::back_inserter(out), "executed permutation: {}\n", chosen_permutation_last_execution);
+        if (info.jit_compile_permutations)
+        {
+            fmt::format_to(std::back_inserter(out), "jit compile time: {}ns (compiled: {}, cached: {}, evicted: {})\n",
+                           jit_statistics.last_compile_nanos,
+                           jit_statistics.compiled_permutations,
+                           jit_statistics.cached_permutations,
+                           jit_statistics.evicted_permutations);
+        }
         usize permutation_index = this->chosen_permutation_last_execution;
-        auto & permutation = this->permutations[permutation_index];
+        auto & permutation = this->get_executed_permutation(this->chosen_permutation_last_execution);
+        fmt::format_to(std::back_inserter(out), "transient memory: peak live bytes: {}, unaliased bytes: {}\n",
+                       permutation.transient_peak_live_bytes,
+                       permutation.transient_unaliased_bytes);
+        if (info.minimize_barriers)
+        {
+            auto const & statistics = permutation.scheduling_statistics;
+            fmt::format_to(std::back_inserter(out), "minimized barriers: batches: {} -> {}, barrier points: {} -> {}, pipeline barriers: {} -> {}, split barriers: {} -> {}\n",
+                           statistics.earliest_batch.batch_count, statistics.scheduled.batch_count,
+                           statistics.earliest_batch.barrier_point_count, statistics.scheduled.barrier_point_count,
+                           statistics.earliest_batch.pipeline_barrier_count, statistics.scheduled.pipeline_barrier_count,
+                           statistics.earliest_batch.split_barrier_count, statistics.scheduled.split_barrier_count);
+        }
+        if (info.cull_dead_tasks)
+        {
+            fmt::format_to(std::back_inserter(out), "culled tasks: {}\n", permutation.culled_tasks.size());
+            for (TaskId const task_id : permutation.culled_tasks)
+            {
+                fmt::format_to(std::back_inserter(out), "  task {}: \"{}\"\n", task_id, tasks[task_id].base_task->name());
+            }
+        }
         {
             this->print_permutation_aliasing_to(out, indent, permutation);
             permutation_index += 1;
@@ -3522,10 +5738,26 @@ namespace daxa
                 fmt::format_to(std::back_inserter(out), "{}submit scope: {}\n", indent, submit_scope_index);
                 [[maybe_unused]] FormatIndent const d1{out, indent, true};
                 usize batch_index = 0;
-                for (auto & task_batch : submit_scope.task_batches)
+                for (auto & task_batch : permutation.submit_scope_batches(submit_scope))
                 {
-                    fmt::format_to(std::back_inserter(out), "{}batch: {}\n", indent, batch_index);
+                    fmt::format_to(std::back_inserter(out), "{}batch: {} (queue: {} {})\n", indent, batch_index, to_string(task_batch.queue.family), task_batch.queue.index);
+                    if (!task_batch.cross_queue_wait_batch_indices.empty())
+                    {
+                        fmt::format_to(std::back_inserter(out), "{}waits on batches of other queues:", indent);
+                        for (usize const wait_batch_index : task_batch.cross_queue_wait_batch_indices)
+                        {
+                            fmt::format_to(std::back_inserter(out), " {}", wait_batch_index);
+                        }
+                        fmt::format_to(std::back_inserter(out), "\n");
+                    }
                     batch_index += 1;
+                    usize merged_image_barrier_count = 0;
+                    for (TaskBarrier const & barrier : task_batch.merged_image_barriers)
+                    {
+                        merged_image_barrier_count += this->get_actual_images(barrier.image_id, permutation).size();
+                    }
+                    fmt::format_to(std::back_inserter(out), "{}merged pipeline barrier command: {} memory barriers, {} image barriers\n", indent,
+                                   task_batch.merged_memory_barrier.has_value() ? 1 : 0, merged_image_barrier_count);
                     fmt::format_to(std::back_inserter(out), "{}inserted pipeline barriers:\n", indent);
                     {
                         [[maybe_unused]] FormatIndent const d2{out, indent, true};
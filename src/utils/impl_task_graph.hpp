@@ -4,6 +4,9 @@
 
 #include <variant>
 #include <sstream>
+#include <thread>
+#include <functional>
+#include <condition_variable>
 #include <daxa/utils/task_graph.hpp>
 
 #define DAXA_TASK_GRAPH_MAX_CONDITIONALS 31
@@ -12,6 +15,80 @@ namespace daxa
 {
     struct ImplDevice;
 
+    // Open addressing hash map with linear probing, used for the lookup tables filled while recording a task graph.
+    // Entries are stored inline in one array and are never erased, which keeps the probing simple.
+    template <typename KeyT, typename ValueT, typename HashT = std::hash<KeyT>>
+    struct FlatHashMap
+    {
+        struct Entry
+        {
+            KeyT key = {};
+            ValueT value = {};
+            bool occupied = {};
+        };
+        std::vector<Entry> entries = {};
+        usize count = {};
+
+        // Returns the index of the entry holding the key or the empty entry it would be inserted into.
+        // Must only be called with at least one entry, the load factor guarantees an empty entry ends the probing.
+        auto find_entry(KeyT const & key) const -> usize
+        {
+            DAXA_DBG_ASSERT_TRUE_M(!this->entries.empty(), "probing an empty flat hash map");
+            usize const mask = this->entries.size() - 1;
+            usize index = HashT{}(key) & mask;
+            while (this->entries[index].occupied && !(this->entries[index].key == key))
+            {
+                index = (index + 1) & mask;
+            }
+            return index;
+        }
+
+        auto contains(KeyT const & key) const -> bool
+        {
+            return !this->entries.empty() && this->entries[find_entry(key)].occupied;
+        }
+
+        // Throws std::out_of_range for missing keys in all builds, like std::unordered_map::at.
+        auto at(KeyT const & key) const -> ValueT const &
+        {
+            if (this->entries.empty())
+            {
+                throw std::out_of_range("key not found in flat hash map");
+            }
+            Entry const & entry = this->entries[find_entry(key)];
+            if (!entry.occupied)
+            {
+                throw std::out_of_range("key not found in flat hash map");
+            }
+            return entry.value;
+        }
+
+        auto operator[](KeyT const & key) -> ValueT &
+        {
+            // Keeps the load factor below 3/4, the capacity is always a power of two.
+            if ((this->count + 1) * 4 > this->entries.size() * 3)
+            {
+                std::vector<Entry> old_entries = std::move(this->entries);
+                this->entries = std::vector<Entry>(std::max(old_entries.size() * 2, usize{16}));
+                for (auto & old_entry : old_entries)
+                {
+                    if (old_entry.occupied)
+                    {
+                        this->entries[find_entry(old_entry.key)] = std::move(old_entry);
+                    }
+                }
+            }
+            Entry & entry = this->entries[find_entry(key)];
+            if (!entry.occupied)
+            {
+                entry.key = key;
+                entry.occupied = true;
+                this->count += 1;
+            }
+            return entry.value;
+        }
+    };
+
     using TaskBatchId = usize;
 
     using TaskId = usize;
@@ -61,6 +138,8 @@ namespace daxa
         // we will combine all barriers into one, which is the first barrier that the first read generates.
         Variant<Monostate, LastConcurrentAccessSplitBarrierIndex, LastConcurrentAccessBarrierIndex> latest_concurrent_access_barrer_index = Monostate{};
         std::variant<BufferId, BlasId, TlasId> actual_id = BufferId{};
+        // Resources used on async queues are not ordered by the batch order, so transients used there are never aliased.
+        bool used_on_async_queue = {};
 
         ResourceLifetime lifetime = {};
         usize allocation_offset = {};
@@ -78,18 +157,41 @@ namespace daxa
         Variant<Monostate, LastConcurrentAccessSplitBarrierIndex, LastConcurrentAccessBarrierIndex> latest_concurrent_access_barrer_index = Monostate{};
     };
 
+    // Tracks the states of the subresources of an image over mip levels and array layers.
+    // Each mip level holds a sorted list of disjoint layer intervals. Neighboring intervals with equal states are merged,
+    // so images accessed mip by mip or layer by layer do not fragment into ever more tracked slices.
+    // Queries combine equal intervals of consecutive mip levels, so they return as few slices as possible.
+    struct ImageSliceStateMap
+    {
+        // Appends the tracked states intersecting the slice to out, each clipped to the slice.
+        void intersecting(ImageMipArraySlice const & slice, std::vector<ExtendedImageSliceState> & out) const;
+        // Appends all tracked states to out.
+        void slices(std::vector<ExtendedImageSliceState> & out) const;
+        // Overwrites the states of the subresources within state.slice.
+        void insert(ExtendedImageSliceState const & state);
+        // Stops tracking the subresources within the slice.
+        void erase(ImageMipArraySlice const & slice);
+        void clear();
+        [[nodiscard]] auto empty() const -> bool;
+
+        // Indexed by mip level, the slices of the intervals always cover exactly one mip level.
+        std::vector<std::vector<ExtendedImageSliceState>> mip_layer_intervals = {};
+    };
+
     struct PerPermTaskImage
     {
         /// Every permutation always has all buffers but they are not necessarily valid in that permutation.
         /// This boolean is used to check this.
         bool valid = {};
         bool swapchain_semaphore_waited_upon = {};
-        std::vector<ExtendedImageSliceState> last_slice_states = {};
-        std::vector<ExtendedImageSliceState> first_slice_states = {};
+        ImageSliceStateMap last_slice_states = {};
+        ImageSliceStateMap first_slice_states = {};
         // only for transient images
         ResourceLifetime lifetime = {};
         ImageCreateFlags create_flags = ImageCreateFlagBits::NONE;
         ImageUsageFlags usage = ImageUsageFlagBits::NONE;
+        // Transient images used on async queues are created with concurrent sharing and are never aliased.
+        bool used_on_async_queue = {};
         ImageId actual_image = {};
         usize allocation_offset = {};
         daxa::MemoryRequirements memory_requirements = {};
@@ -112,26 +214,99 @@ namespace daxa
         Event split_barrier_state;
     };
 
-    struct ImplTask
+    // Image views of the image attachments of a task, created for the runtime images of the last execution.
+    struct TaskImageViewCache
     {
-        std::unique_ptr<ITask> base_task = {};
         std::vector<std::vector<ImageViewId>> image_view_cache = {};
         // Used to verify image view cache:
         std::vector<std::vector<ImageId>> runtime_images_last_execution = {};
     };
 
+    struct ImplTask
+    {
+        std::unique_ptr<ITask> base_task = {};
+        // The queue preferred by the task, or the main queue when the device does not have it.
+        Queue queue = QUEUE_MAIN;
+        // Keeps the task alive in dead task culling.
+        bool has_side_effects = {};
+        // One cache per frame in flight, as each frame in flight uses its own transient images.
+        std::vector<TaskImageViewCache> frame_view_caches = {};
+    };
+
+    // Runtime transient resources of one frame in flight, indexed by task buffer and task image index.
+    // Only the entries of transient resources valid in the permutation are set.
+    struct TransientFrameResources
+    {
+        std::vector<BufferId> buffers = {};
+        std::vector<ImageId> images = {};
+    };
+
     struct ImplPresentInfo
     {
         std::vector<BinarySemaphore> binary_semaphores = {};
         std::vector<BinarySemaphore> * additional_binary_semaphores = {};
     };
 
+    // Index of a queue in arrays holding one element per queue: main, compute queues, transfer queues.
+    static constexpr inline u32 TASK_GRAPH_QUEUE_COUNT = 1 + MAX_COMPUTE_QUEUE_COUNT + MAX_TRANSFER_QUEUE_COUNT;
+    inline auto queue_flat_index(Queue queue) -> u32
+    {
+        switch (queue.family)
+        {
+        case QueueFamily::COMPUTE: return 1 + queue.index;
+        case QueueFamily::TRANSFER: return 1 + MAX_COMPUTE_QUEUE_COUNT + queue.index;
+        default: return 0;
+        }
+    }
+
+    // Source access of barriers following an access on another queue.
+    // The timeline semaphore between the queues already makes the memory available and visible.
+    static constexpr inline Access CROSS_QUEUE_SRC_ACCESS = {.stages = PipelineStageFlagBits::ALL_COMMANDS, .type = AccessTypeFlagBits::NONE};
+
     struct TaskBatch
     {
+        // All tasks of a batch run on the same queue.
+        Queue queue = QUEUE_MAIN;
+        // Batches on other queues within the same submit scope this batch depends on.
+        // The batch's queue waits on a semaphore signaled after these batches.
+        std::vector<usize> cross_queue_wait_batch_indices = {};
         std::vector<usize> pipeline_barrier_indices = {};
         std::vector<usize> wait_split_barrier_indices = {};
         std::vector<TaskId> tasks = {};
         std::vector<usize> signal_split_barrier_indices = {};
+        // Set when the permutation is completed. All pipeline barriers of the batch merged into one dependency.
+        // The memory barriers are combined into a single barrier with the union of their accesses.
+        // The image barriers are expanded to the runtime images of their task image at execution.
+        std::optional<MemoryBarrierInfo> merged_memory_barrier = {};
+        std::vector<TaskBarrier> merged_image_barriers = {};
+    };
+
+    struct QueueSegment
+    {
+        Queue queue = QUEUE_MAIN;
+        ExecutableCommandList commands = {};
+        // Segments on other queues this segment waits on.
+        std::vector<usize> wait_segment_indices = {};
+        u64 signal_value = {};
+    };
+
+    // Commands of a submitted submit scope, recorded once in static execution mode.
+    struct StaticSubmitScopeCommands
+    {
+        // Only used when the submit scope uses async queues.
+        // The first segment is replaced by the commands recorded before the scope in each execution.
+        std::vector<QueueSegment> queue_segments = {};
+        std::vector<ExecutableCommandList> command_lists = {};
+    };
+
+    struct StaticPermutationCommands
+    {
+        // Runtime resources the commands were recorded with, the commands are re-recorded when they change.
+        std::vector<GPUResourceId> persistent_resource_ids = {};
+        u64 transient_heap_generation = {};
+        // Set when the recording allocated staging memory, these commands read data that later allocations can overwrite.
+        bool uses_staging_memory = {};
+        std::vector<StaticSubmitScopeCommands> submit_scopes = {};
     };
 
     struct TaskBatchSubmitScope
@@ -140,7 +315,9 @@ namespace daxa
         TaskSubmitInfo user_submit_info = {};
         // These barriers are inserted after all batches and their sync.
         std::vector<usize> last_minute_barrier_indices = {};
-        std::vector<TaskBatch> task_batches = {};
+        // Range of the submit scopes batches in the task batches of the permutation.
+        usize first_batch_index = {};
+        usize batch_count = {};
         std::vector<u64> used_swapchain_task_images = {};
         std::optional<ImplPresentInfo> present_info = {};
     };
@@ -150,6 +327,9 @@ namespace daxa
 
     struct ImplTaskGraph;
 
+    // Buffers are keyed by their size, images by format, extent, mip and layer counts, sample count, usage and sharing mode.
+    using TransientMemoryRequirementsKey = std::array<u64, 7>;
+
     struct TaskGraphPermutation
     {
         // record time information:
@@ -161,18 +341,94 @@ namespace daxa
         std::vector<TaskSplitBarrier> split_barriers = {};
         std::vector<TaskBarrier> barriers = {};
         std::vector<usize> initial_barriers = {};
-        // TODO(msakmary, pahrens) - Instead of storing batch submit scopes which contain batches
-        // we should make a vector of batches which and a second vector of submit scopes which are
-        // just offsets into the batches vector
         std::vector<TaskBatchSubmitScope> batch_submit_scopes = {};
+        // Batches of all submit scopes in submission order, each submit scope owns a contiguous range.
+        // Batch indices stored in the permutation are relative to the first batch of their submit scope.
+        std::vector<TaskBatch> task_batches = {};
         usize swapchain_image_first_use_submit_scope_index = std::numeric_limits<usize>::max();
         usize swapchain_image_last_use_submit_scope_index = std::numeric_limits<usize>::max();
+        // Set when placing the transient resources.
+        usize transient_peak_live_bytes = {};
+        usize transient_unaliased_bytes = {};
+        // Generation of the transient heap the transient resources were created in.
+        u64 transient_heap_generation = {};
+        // Set when compiling the permutation, before the transient resource initialization barriers are added.
+        TaskGraphSchedulingStatistics scheduling_statistics = {};
+        // Tasks removed by dead task culling, in task id order.
+        std::vector<TaskId> culled_tasks = {};
+        // Only used in static execution mode.
+        std::optional<StaticPermutationCommands> static_commands = {};
+        // The runtime transient resources of the executed frame are copied into the buffer and image infos.
+        std::vector<TransientFrameResources> transient_frames = {};
+
+        auto submit_scope_batches(TaskBatchSubmitScope const & submit_scope) -> std::span<TaskBatch>
+        {
+            return {this->task_batches.data() + submit_scope.first_batch_index, submit_scope.batch_count};
+        }
+        auto submit_scope_batches(TaskBatchSubmitScope const & submit_scope) const -> std::span<TaskBatch const>
+        {
+            return {this->task_batches.data() + submit_scope.first_batch_index, submit_scope.batch_count};
+        }
+        auto batch(usize submit_scope_index, usize batch_index) -> TaskBatch &
+        {
+            return this->task_batches[this->batch_submit_scopes[submit_scope_index].first_batch_index + batch_index];
+        }
 
-        void add_task(ImplTaskGraph & task_graph_impl, ImplTask & impl_task, TaskId task_id);
+        void add_task(ImplTaskGraph & task_graph_impl, ImplTask & impl_task, TaskId task_id, usize min_batch_index = 0);
         void submit(TaskSubmitInfo const & info);
         void present(TaskPresentInfo const & info);
     };
 
+    struct RecordedResourceDeclaration
+    {
+        bool is_image = {};
+        u32 index = {};
+    };
+
+    struct RecordedTask
+    {
+        TaskId task_id = {};
+    };
+
+    using RecordedCommandData = std::variant<RecordedResourceDeclaration, RecordedTask, TaskSubmitInfo, TaskPresentInfo>;
+
+    // Every recording call is stored together with the conditional scopes active at the time.
+    // Permutations are compiled by replaying these commands, skipping the ones whose conditions do not match.
+    struct RecordedCommand
+    {
+        u32 active_conditional_scopes = {};
+        u32 conditional_states = {};
+        RecordedCommandData command = {};
+    };
+
+    struct JitCompiledPermutation
+    {
+        TaskGraphPermutation permutation = {};
+        // One memory block per frame in flight.
+        std::vector<MemoryBlock> transient_memory_blocks = {};
+        usize transient_memory_size = {};
+        u64 last_execution = {};
+    };
+
+    struct ImplTransientHeap final : ImplHandle
+    {
+        ImplTransientHeap(TransientHeapInfo a_info);
+
+        TransientHeapInfo info = {};
+        MemoryBlock memory_block = {};
+        MemoryRequirements requirements = {.size = 0, .alignment = 0, .memory_type_bits = 0xFFFFFFFFu};
+        // Incremented each time the memory block is replaced.
+        // Transient resources created in an older block are recreated before the next execution.
+        u64 generation = {};
+        // Unique index of the task graph that last executed with this heap.
+        u32 last_task_graph_index = std::numeric_limits<u32>::max();
+
+        // Grows the memory block to fit the given requirements.
+        void reserve(MemoryRequirements const & new_requirements);
+
+        static void zero_ref_callback(ImplHandle const * handle);
+    };
+
     struct ImplPersistentTaskBufferBlasTlas final : ImplHandle
     {
         ImplPersistentTaskBufferBlasTlas(TaskBufferInfo a_info);
@@ -326,12 +582,39 @@ namespace daxa
         }
     };
 
+    // Threads that record the submit scope ranges of parallel recording.
+    // They are started once with the task graph and wait for work between executions, so executing never creates threads.
+    struct TaskRecordingWorkers
+    {
+        std::vector<std::thread> threads = {};
+        std::mutex mtx = {};
+        std::condition_variable work_cv = {};
+        std::condition_variable done_cv = {};
+        // Called by the first job_worker_count workers with their worker index.
+        std::function<void(usize)> job = {};
+        usize job_worker_count = {};
+        usize pending_worker_count = {};
+        u64 job_generation = {};
+        bool stop = {};
+
+        TaskRecordingWorkers() = default;
+        TaskRecordingWorkers(TaskRecordingWorkers const &) = delete;
+        auto operator=(TaskRecordingWorkers const &) -> TaskRecordingWorkers & = delete;
+        ~TaskRecordingWorkers();
+
+        void start(u32 worker_count);
+        void dispatch(usize worker_count, std::function<void(usize)> a_job);
+        void wait();
+        void worker_loop(usize worker_index);
+    };
+
     struct ImplTaskRuntimeInterface
     {
         // interface:
         ImplTaskGraph & task_graph;
         TaskGraphPermutation & permutation;
         CommandRecorder & recorder;
+        TransferMemoryPool * staging_memory = {};
         ImplTask * current_task = {};
         types::DeviceAddress device_address = {};
         bool reuse_last_command_list = true;
@@ -349,28 +632,53 @@ namespace daxa
         TaskGraphInfo info;
         std::vector<PermIndepTaskBufferInfo> global_buffer_infos = {};
         std::vector<PermIndepTaskImageInfo> global_image_infos = {};
+        // Only used without jit compilation, holds all permutations once the graph is completed.
         std::vector<TaskGraphPermutation> permutations = {};
+        // Only used with jit compilation, holds the permutations compiled on their first execution.
+        std::unordered_map<u32, JitCompiledPermutation> jit_permutations = {};
+        u64 jit_execution_counter = {};
+        TaskGraphJitStatistics jit_statistics = {};
+        TaskGraphStaticExecutionStatistics static_execution_statistics = {};
         std::vector<ImplTask> tasks = {};
-        // TODO: replace with faster hash map.
-        std::unordered_map<u32, u32> persistent_buffer_index_to_local_index;
-        std::unordered_map<u32, u32> persistent_image_index_to_local_index;
+        FlatHashMap<u32, u32> persistent_buffer_index_to_local_index = {};
+        FlatHashMap<u32, u32> persistent_image_index_to_local_index = {};
 
         // record time information:
         u32 record_active_conditional_scopes = {};
         u32 record_conditional_states = {};
-        std::vector<TaskGraphPermutation *> record_active_permutations = {};
-        std::unordered_map<std::string, TaskBufferView> buffer_name_to_id = {};
-        std::unordered_map<std::string, TaskBlasView> blas_name_to_id = {};
-        std::unordered_map<std::string, TaskTlasView> tlas_name_to_id = {};
-        std::unordered_map<std::string, TaskImageView> image_name_to_id = {};
+        std::vector<RecordedCommand> recorded_commands = {};
+        FlatHashMap<std::string, TaskBufferView> buffer_name_to_id = {};
+        FlatHashMap<std::string, TaskBlasView> blas_name_to_id = {};
+        FlatHashMap<std::string, TaskTlasView> tlas_name_to_id = {};
+        FlatHashMap<std::string, TaskImageView> image_name_to_id = {};
 
         usize memory_block_size = {};
+        usize memory_block_alignment = {};
         u32 memory_type_bits = 0xFFFFFFFFu;
-        MemoryBlock transient_data_memory_block = {};
+        // Transient memory requirements only depend on a few fields of the resource infos.
+        // Querying them from the device is slow, so they are cached for all permutations.
+        std::map<TransientMemoryRequirementsKey, MemoryRequirements> transient_memory_requirements_cache = {};
+        TaskTransientMemoryStatistics transient_memory_statistics = {};
+        // One memory block per frame in flight, shared by all permutations.
+        std::vector<MemoryBlock> transient_data_memory_blocks = {};
+        // Frame in flight of the current or last execution.
+        u32 transient_frame_index = {};
         bool compiled = {};
+        bool loaded_serialized_permutations = {};
 
         // execution time information:
         std::optional<daxa::TransferMemoryPool> staging_memory = {};
+        // Threads used to record a submit scope, including the calling thread.
+        u32 recording_thread_count = 1;
+        // Staging memory of the additional recording threads, one pool per thread.
+        std::vector<daxa::TransferMemoryPool> parallel_staging_memories = {};
+        // The additional recording threads, recording_thread_count - 1 workers.
+        TaskRecordingWorkers recording_workers = {};
+        // Staging memory timeline values signaled by the latest submission of the task graph.
+        std::vector<std::pair<TimelineSemaphore, u64>> staging_memory_submit_signals = {};
+        // Signaled by every submission of the task graph on the respective queue, created on first use.
+        std::array<TimelineSemaphore, TASK_GRAPH_QUEUE_COUNT> queue_timeline_semaphores = {};
+        std::array<u64, TASK_GRAPH_QUEUE_COUNT> queue_timeline_values = {};
         std::array<bool, DAXA_TASK_GRAPH_MAX_CONDITIONALS> execution_time_current_conditionals = {};
 
         // post execution information:
@@ -485,13 +793,27 @@ namespace daxa
         // auto get_actual_buffers(TaskBufferView id, TaskGraphPermutation const & perm) const -> std::span<BufferId const>;
         auto get_actual_images(TaskImageView id, TaskGraphPermutation const & perm) const -> std::span<ImageId const>;
         auto id_to_local_id(TaskImageView id) const -> TaskImageView;
-        void update_active_permutations();
+        void record_command(RecordedCommandData const & command);
+        void compile_permutation(TaskGraphPermutation & permutation, u32 permutation_index, bool minimize_barriers);
+        void complete_permutation(TaskGraphPermutation & permutation, std::span<MemoryBlock> memory_blocks);
+        auto get_jit_permutation(u32 permutation_index) -> TaskGraphPermutation &;
+        auto get_executed_permutation(u32 permutation_index) -> TaskGraphPermutation &;
         void update_image_view_cache(ImplTask & task, TaskGraphPermutation const & permutation);
         void execute_task(ImplTaskRuntimeInterface & impl_runtime, TaskGraphPermutation & permutation, u32 batch_index, TaskBatchId in_batch_task_index, TaskId task_id);
         void insert_pre_batch_barriers(TaskGraphPermutation & permutation);
-        void create_transient_runtime_buffers(TaskGraphPermutation & permutation);
-        void create_transient_runtime_images(TaskGraphPermutation & permutation);
+        void create_transient_runtime_buffers(TaskGraphPermutation & permutation, MemoryBlock & memory_block);
+        void create_transient_runtime_images(TaskGraphPermutation & permutation, MemoryBlock & memory_block);
+        void create_transient_runtime_resources(TaskGraphPermutation & permutation, std::span<MemoryBlock> memory_blocks);
+        void activate_transient_frame(TaskGraphPermutation & permutation, u32 frame_index);
+        void destroy_transient_runtime_resources(TaskGraphPermutation & permutation);
+        auto transient_memory_requirements(ImageInfo const & image_info) -> MemoryRequirements;
+        auto transient_memory_requirements(BufferInfo const & buffer_info) -> MemoryRequirements;
+        auto place_transient_resources(TaskGraphPermutation & permutation) -> MemoryRequirements;
         void allocate_transient_resources();
+        void allocate_transient_memory(MemoryRequirements const & requirements);
+        auto load_serialized_permutations(std::span<std::byte const> data) -> bool;
+        auto transient_heap() const -> ImplTransientHeap *;
+        void update_transient_heap_resources(TaskGraphPermutation & permutation);
         void print_task_buffer_blas_tlas_to(std::string & out, std::string indent, TaskGraphPermutation const & permutation, TaskGPUResourceView local_id);
         void print_task_image_to(std::string & out, std::string indent, TaskGraphPermutation const & permutation, TaskImageView image);
         void print_task_barrier_to(std::string & out, std::string & indent, TaskGraphPermutation const & permutation, usize index, bool const split_barrier);
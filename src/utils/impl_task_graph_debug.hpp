@@ -167,5 +167,24 @@ namespace daxa
                             attach.name, task.base_task->name(), attach.shader_array_size, attach.ids.size()));
         }
     }
+
+    void validate_task_image_queue_sharing([[maybe_unused]] Device & device, [[maybe_unused]] ImplTask & task, [[maybe_unused]] TaskImageAttachmentInfo const & attach)
+    {
+#if DAXA_VALIDATION
+        if (task.queue.family == QueueFamily::MAIN)
+        {
+            return;
+        }
+        for (ImageId const image : attach.ids)
+        {
+            DAXA_DBG_ASSERT_TRUE_M(
+                device.image_info(image).value().sharing_mode == SharingMode::CONCURRENT,
+                fmt::format("Detected invalid image sharing mode.\n"
+                            "Attachment \"{}\" in task \"{}\" is used on the {} queue, but its runtime image is not shared between queues.\n"
+                            "Images used on compute and transfer queues must be created with SharingMode::CONCURRENT!",
+                            attach.name, task.base_task->name(), to_string(task.queue.family)));
+        }
+#endif
+    }
     // void validate_
 } // namespace daxa
\ No newline at end of file
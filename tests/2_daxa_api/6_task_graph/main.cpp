@@ -976,6 +976,650 @@ namespace tests
         task_graph.execute({});
         std::cout << task_graph.get_debug_string() << std::endl;
     }
+
+    void jit_permutations()
+    {
+        // TEST:
+        //    1) Record a conditional write of a transient image
+        //    2) Execute both permutations with a jit cache of one permutation
+        //    3) Check that permutations are compiled on first use, reused and evicted
+        AppContext app = {};
+        auto task_graph = daxa::TaskGraph({
+            .device = app.device,
+            .jit_compile_permutations = true,
+            .jit_max_cached_permutations = 1,
+            .permutation_condition_count = 1,
+            .record_debug_information = true,
+            .name = APPNAME_PREFIX("jit permutations"),
+        });
+        auto task_image = task_graph.create_transient_image(daxa::TaskTransientImageInfo{.size = {1, 1, 1}, .name = "task graph tested image"});
+        u32 true_executions = 0;
+        u32 false_executions = 0;
+        task_graph.conditional({
+            .condition_index = 0,
+            .when_true = [&]()
+            {
+                task_graph.add_task({
+                    .attachments = {daxa::inl_attachment(daxa::TaskImageAccess::COMPUTE_SHADER_STORAGE_WRITE_ONLY, task_image)},
+                    .task = [&](daxa::TaskInterface) { true_executions += 1; },
+                    .name = APPNAME_PREFIX("write image when true"),
+                });
+            },
+            .when_false = [&]()
+            {
+                task_graph.add_task({
+                    .attachments = {},
+                    .task = [&](daxa::TaskInterface) { false_executions += 1; },
+                    .name = APPNAME_PREFIX("skip when false"),
+                });
+            },
+        });
+        task_graph.submit({});
+        task_graph.complete({});
+        DAXA_DBG_ASSERT_TRUE_M(task_graph.get_jit_statistics().compiled_permutations == 0, "jit permutations must not be compiled on complete");
+
+        std::array<bool, 1> condition = {true};
+        task_graph.execute({.permutation_condition_values = condition});
+        task_graph.execute({.permutation_condition_values = condition});
+        DAXA_DBG_ASSERT_TRUE_M(task_graph.get_jit_statistics().compiled_permutations == 1, "cached jit permutation must be reused");
+        DAXA_DBG_ASSERT_TRUE_M(task_graph.get_transient_memory_size() != 0, "true permutation must allocate the transient image");
+
+        condition[0] = false;
+        task_graph.execute({.permutation_condition_values = condition});
+        std::cout << task_graph.get_debug_string() << std::endl;
+        daxa::TaskGraphJitStatistics const statistics = task_graph.get_jit_statistics();
+        DAXA_DBG_ASSERT_TRUE_M(statistics.compiled_permutations == 2, "new condition values must compile a new permutation");
+        DAXA_DBG_ASSERT_TRUE_M(statistics.cached_permutations == 1 && statistics.evicted_permutations == 1, "least recently used permutation must be evicted");
+        DAXA_DBG_ASSERT_TRUE_M(true_executions == 2 && false_executions == 1, "jit permutations executed the wrong tasks");
+        std::cout << "jit compile time: " << statistics.total_compile_nanos << "ns" << std::endl;
+    }
+
+    void parallel_recording()
+    {
+        // TEST:
+        //    1) Record many independent buffer writes, each task allocates staging memory
+        //    2) Execute with parallel recording on four threads
+        //    3) Check that every task ran exactly once
+        static constexpr daxa::u32 TASK_COUNT = 32;
+        AppContext app = {};
+        auto task_graph = daxa::TaskGraph({
+            .device = app.device,
+            .enable_parallel_recording = true,
+            .parallel_recording_thread_count = 4,
+            .record_debug_information = true,
+            .name = APPNAME_PREFIX("parallel recording"),
+        });
+        // Each task only writes its own counter, so the counters need no synchronization.
+        std::array<daxa::u32, TASK_COUNT> task_executions = {};
+        for (daxa::u32 i = 0; i < TASK_COUNT; ++i)
+        {
+            auto task_buffer = task_graph.create_transient_buffer({.size = sizeof(daxa::u32), .name = std::string("buffer ") + std::to_string(i)});
+            task_graph.add_task({
+                .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, task_buffer)},
+                .task = [=, &task_executions](daxa::TaskInterface ti)
+                {
+                    auto allocation = ti.allocator->allocate_fill(i).value();
+                    ti.recorder.copy_buffer_to_buffer({
+                        .src_buffer = ti.allocator->buffer(),
+                        .dst_buffer = ti.get(task_buffer).ids[0],
+                        .src_offset = allocation.buffer_offset,
+                        .size = sizeof(daxa::u32),
+                    });
+                    task_executions[i] += 1;
+                },
+                .name = std::string("write buffer ") + std::to_string(i),
+            });
+        }
+        task_graph.submit({});
+        task_graph.complete({});
+        task_graph.execute({});
+        task_graph.execute({});
+        std::cout << task_graph.get_debug_string() << std::endl;
+        for (auto const & executions : task_executions)
+        {
+            DAXA_DBG_ASSERT_TRUE_M(executions == 2, "parallel recording must execute every task once per execution");
+        }
+        app.device.wait_idle();
+        app.device.collect_garbage();
+    }
+
+    void async_queues()
+    {
+        // TEST:
+        //    1) Write a transient buffer on the compute queue and copy it on the transfer queue
+        //    2) Copy the result into a host visible buffer on the main queue
+        //    3) Check the value, the main queue must wait on both async queues
+        //    Devices without async queues run the tasks on the main queue.
+        AppContext app = {};
+        auto readback_buffer = app.device.create_buffer({
+            .size = sizeof(daxa::u32),
+            .allocate_info = daxa::MemoryFlagBits::HOST_ACCESS_RANDOM,
+            .name = "readback buffer",
+        });
+        auto task_readback_buffer = daxa::TaskBuffer({
+            .initial_buffers = {.buffers = {&readback_buffer, 1}},
+            .name = "readback buffer",
+        });
+        auto task_graph = daxa::TaskGraph({
+            .device = app.device,
+            .record_debug_information = true,
+            .name = APPNAME_PREFIX("async queues"),
+        });
+        task_graph.use_persistent_buffer(task_readback_buffer);
+        auto compute_buffer = task_graph.create_transient_buffer({.size = sizeof(daxa::u32), .name = "compute buffer"});
+        auto transfer_buffer = task_graph.create_transient_buffer({.size = sizeof(daxa::u32), .name = "transfer buffer"});
+        task_graph.add_task({
+            .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, compute_buffer)},
+            .task = [=](daxa::TaskInterface ti)
+            {
+                auto allocation = ti.allocator->allocate_fill(42u).value();
+                ti.recorder.copy_buffer_to_buffer({
+                    .src_buffer = ti.allocator->buffer(),
+                    .dst_buffer = ti.get(compute_buffer).ids[0],
+                    .src_offset = allocation.buffer_offset,
+                    .size = sizeof(daxa::u32),
+                });
+            },
+            .name = "write on compute queue",
+            .queue = daxa::QUEUE_COMPUTE_0,
+        });
+        task_graph.add_task({
+            .attachments = {
+                daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, compute_buffer),
+                daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, transfer_buffer),
+            },
+            .task = [=](daxa::TaskInterface ti)
+            {
+                ti.recorder.copy_buffer_to_buffer({
+                    .src_buffer = ti.get(compute_buffer).ids[0],
+                    .dst_buffer = ti.get(transfer_buffer).ids[0],
+                    .size = sizeof(daxa::u32),
+                });
+            },
+            .name = "copy on transfer queue",
+            .queue = daxa::QUEUE_TRANSFER_0,
+        });
+        task_graph.add_task({
+            .attachments = {
+                daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, transfer_buffer),
+                daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, task_readback_buffer),
+            },
+            .task = [=](daxa::TaskInterface ti)
+            {
+                ti.recorder.copy_buffer_to_buffer({
+                    .src_buffer = ti.get(transfer_buffer).ids[0],
+                    .dst_buffer = ti.get(task_readback_buffer).ids[0],
+                    .size = sizeof(daxa::u32),
+                });
+            },
+            .name = "copy to readback buffer on main queue",
+        });
+        task_graph.submit({});
+        task_graph.complete({});
+        task_graph.execute({});
+        std::cout << task_graph.get_debug_string() << std::endl;
+        app.device.wait_idle();
+        DAXA_DBG_ASSERT_TRUE_M(*app.device.buffer_host_address_as<daxa::u32>(readback_buffer).value() == 42u, "main queue must see the value written on the async queues");
+        app.device.destroy_buffer(readback_buffer);
+        app.device.collect_garbage();
+    }
+
+    void transient_memory_statistics()
+    {
+        // TEST:
+        //    1) Chain three equally sized transient buffers, each only alive for two batches
+        //    2) At most two buffers are alive at once, so aliasing can place all three into the memory of two
+        //    3) Check that the allocated memory matches the peak live bytes and that the memory requirements were cached
+        AppContext app = {};
+        auto task_graph = daxa::TaskGraph({
+            .device = app.device,
+            .alias_transients = true,
+            .name = APPNAME_PREFIX("transient memory statistics"),
+        });
+        std::array<daxa::TaskBufferView, 3> buffers = {};
+        for (daxa::u32 i = 0; i < buffers.size(); ++i)
+        {
+            buffers[i] = task_graph.create_transient_buffer({.size = 1u << 20u, .name = std::string("buffer ") + std::to_string(i)});
+        }
+        task_graph.add_task({
+            .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, buffers[0])},
+            .task = [](daxa::TaskInterface) {},
+            .name = "write 0",
+        });
+        for (daxa::u32 i = 1; i < buffers.size(); ++i)
+        {
+            task_graph.add_task({
+                .attachments = {
+                    daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, buffers[i - 1]),
+                    daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, buffers[i]),
+                },
+                .task = [](daxa::TaskInterface) {},
+                .name = std::string("copy ") + std::to_string(i),
+            });
+        }
+        task_graph.add_task({
+            .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, buffers[2])},
+            .task = [](daxa::TaskInterface) {},
+            .name = "read 2",
+        });
+        task_graph.submit({});
+        task_graph.complete({});
+        auto const statistics = task_graph.get_transient_memory_statistics();
+        std::cout << "peak live bytes: " << statistics.peak_live_bytes
+                  << ", allocated bytes: " << statistics.allocated_bytes
+                  << ", unaliased bytes: " << statistics.unaliased_bytes << std::endl;
+        DAXA_DBG_ASSERT_TRUE_M(statistics.allocated_bytes == statistics.peak_live_bytes, "two buffers must share their memory");
+        DAXA_DBG_ASSERT_TRUE_M(statistics.unaliased_bytes == statistics.peak_live_bytes / 2 * 3, "peak live bytes must be two of the three buffers");
+        DAXA_DBG_ASSERT_TRUE_M(statistics.memory_requirements_cache_misses == 1, "identical buffers must share their memory requirements");
+        app.device.collect_garbage();
+    }
+
+    void shared_transient_heap()
+    {
+        // TEST:
+        //    1) Create two task graphs with differently sized transient buffers sharing one transient heap
+        //    2) Check that the heap grows to the larger requirement instead of the sum of both
+        //    3) Execute the graphs alternately, the smaller graph recreates its buffer in the grown heap
+        AppContext app = {};
+        auto heap = daxa::TransientHeap({.device = app.device, .name = APPNAME_PREFIX("shared transient heap")});
+        auto make_graph = [&](daxa::u32 size, std::string const & name)
+        {
+            auto task_graph = daxa::TaskGraph({
+                .device = app.device,
+                .transient_heap = heap,
+                .name = APPNAME_PREFIX("") + name,
+            });
+            auto buffer = task_graph.create_transient_buffer({.size = size, .name = name + " buffer"});
+            task_graph.add_task({
+                .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, buffer)},
+                .task = [=](daxa::TaskInterface ti)
+                { ti.recorder.clear_buffer({.buffer = ti.get(buffer).ids[0], .size = size, .clear_value = 1}); },
+                .name = name + " clear",
+            });
+            task_graph.add_task({
+                .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, buffer)},
+                .task = [](daxa::TaskInterface) {},
+                .name = name + " read",
+            });
+            task_graph.submit({});
+            task_graph.complete({});
+            return task_graph;
+        };
+        auto small_graph = make_graph(1u << 20u, "small graph");
+        auto const small_heap_size = heap.size();
+        auto large_graph = make_graph(1u << 22u, "large graph");
+        std::cout << "small graph: " << small_graph.get_transient_memory_size()
+                  << ", large graph: " << large_graph.get_transient_memory_size()
+                  << ", heap: " << heap.size() << std::endl;
+        DAXA_DBG_ASSERT_TRUE_M(small_heap_size == small_graph.get_transient_memory_size(), "heap must fit the first graph exactly");
+        DAXA_DBG_ASSERT_TRUE_M(heap.size() == std::max(small_graph.get_transient_memory_size(), large_graph.get_transient_memory_size()), "heap must grow to the largest graph");
+        DAXA_DBG_ASSERT_TRUE_M(large_graph.get_transient_memory_statistics().allocated_bytes == heap.size(), "graphs report the memory of their heap");
+        for (daxa::u32 i = 0; i < 3; ++i)
+        {
+            small_graph.execute({});
+            large_graph.execute({});
+        }
+        app.device.wait_idle();
+        app.device.collect_garbage();
+    }
+
+    void minimize_barriers()
+    {
+        // TEST:
+        //    1) Record a graph where a read of buffer a is recorded after a read of a, that itself waits on a longer dependency chain
+        //    2) The default scheduler orders the second read behind the first, adding a batch to the chain depending on it
+        //    3) Check that the barrier minimizing scheduler places the second read directly after the write of a, saving a batch
+        AppContext app = {};
+        auto task_graph = daxa::TaskGraph({
+            .device = app.device,
+            .minimize_barriers = true,
+            .record_debug_information = true,
+            .name = APPNAME_PREFIX("minimize barriers"),
+        });
+        auto make_buffer = [&](char const * name)
+        { return task_graph.create_transient_buffer({.size = 64, .name = name}); };
+        auto a = make_buffer("a");
+        auto b = make_buffer("b");
+        auto c = make_buffer("c");
+        auto e = make_buffer("e");
+        auto add_task = [&](std::vector<daxa::TaskAttachmentInfo> attachments, std::string const & name)
+        {
+            task_graph.add_task({
+                .attachments = attachments,
+                .task = [](daxa::TaskInterface) {},
+                .name = name,
+            });
+        };
+        using daxa::TaskBufferAccess;
+        add_task({daxa::inl_attachment(TaskBufferAccess::TRANSFER_WRITE, a)}, "write a");
+        add_task({daxa::inl_attachment(TaskBufferAccess::TRANSFER_WRITE, b)}, "write b");
+        add_task({daxa::inl_attachment(TaskBufferAccess::TRANSFER_READ, b), daxa::inl_attachment(TaskBufferAccess::TRANSFER_WRITE, c)}, "copy b to c");
+        add_task({daxa::inl_attachment(TaskBufferAccess::TRANSFER_READ, c), daxa::inl_attachment(TaskBufferAccess::TRANSFER_READ, a)}, "read c and a");
+        add_task({daxa::inl_attachment(TaskBufferAccess::TRANSFER_READ, a), daxa::inl_attachment(TaskBufferAccess::TRANSFER_WRITE, e)}, "copy a to e");
+        add_task({daxa::inl_attachment(TaskBufferAccess::TRANSFER_READ, e)}, "read e");
+        task_graph.submit({});
+        task_graph.complete({});
+        auto const statistics = task_graph.get_scheduling_statistics();
+        std::cout << "batches: " << statistics.earliest_batch.batch_count << " -> " << statistics.scheduled.batch_count
+                  << ", barrier points: " << statistics.earliest_batch.barrier_point_count << " -> " << statistics.scheduled.barrier_point_count
+                  << ", split barriers: " << statistics.earliest_batch.split_barrier_count << " -> " << statistics.scheduled.split_barrier_count << std::endl;
+        DAXA_DBG_ASSERT_TRUE_M(statistics.earliest_batch.batch_count == 4, "default scheduler orders the reads of a behind each other");
+        DAXA_DBG_ASSERT_TRUE_M(statistics.scheduled.batch_count == 3, "the second read of a only depends on the write of a");
+        DAXA_DBG_ASSERT_TRUE_M(statistics.scheduled.barrier_point_count < statistics.earliest_batch.barrier_point_count, "fewer batches must need fewer barrier points");
+        task_graph.execute({});
+        std::cout << task_graph.get_debug_string() << std::endl;
+        app.device.wait_idle();
+        app.device.collect_garbage();
+    }
+
+    void many_runtime_image_barriers()
+    {
+        // TEST:
+        //    1) Create a task image with 64 runtime images, more than the recorder used to batch into one barrier command
+        //    2) Write and read the images together with a transient buffer
+        //    3) The barriers between the tasks are merged into one memory barrier and 64 image barriers, recorded in one command
+        //    4) Check the schedule and the merged barrier command reported in the debug string
+        AppContext app = {};
+        std::vector<daxa::ImageId> images = {};
+        for (daxa::u32 i = 0; i < 64; ++i)
+        {
+            images.push_back(app.device.create_image({
+                .size = {1, 1, 1},
+                .usage = daxa::ImageUsageFlagBits::TRANSFER_SRC | daxa::ImageUsageFlagBits::TRANSFER_DST,
+                .name = std::string(APPNAME_PREFIX("image ")) + std::to_string(i),
+            }));
+        }
+        auto task_image = daxa::TaskImage({.initial_images = {.images = images}, .name = "images"});
+        {
+            auto task_graph = daxa::TaskGraph({
+                .device = app.device,
+                .use_split_barriers = false,
+                .record_debug_information = true,
+                .name = APPNAME_PREFIX("many runtime image barriers"),
+            });
+            task_graph.use_persistent_image(task_image);
+            auto buffer = task_graph.create_transient_buffer({.size = 64, .name = "buffer"});
+            task_graph.add_task({
+                .attachments = {
+                    daxa::inl_attachment(daxa::TaskImageAccess::TRANSFER_WRITE, task_image),
+                    daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, buffer),
+                },
+                .task = [=](daxa::TaskInterface ti)
+                {
+                    for (auto const image : ti.get(task_image).ids)
+                    {
+                        ti.recorder.clear_image({.dst_image_layout = ti.get(task_image).layout, .dst_image = image});
+                    }
+                    ti.recorder.clear_buffer({.buffer = ti.get(buffer).ids[0], .size = 64});
+                },
+                .name = "clear",
+            });
+            task_graph.add_task({
+                .attachments = {
+                    daxa::inl_attachment(daxa::TaskImageAccess::TRANSFER_READ, task_image),
+                    daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, buffer),
+                },
+                .task = [](daxa::TaskInterface) {},
+                .name = "read",
+            });
+            task_graph.submit({});
+            task_graph.complete({});
+            task_graph.execute({});
+            task_graph.execute({});
+            std::string const debug_string = task_graph.get_debug_string();
+            std::cout << debug_string << std::endl;
+            auto const statistics = task_graph.get_scheduling_statistics();
+            DAXA_DBG_ASSERT_TRUE_M(statistics.scheduled.batch_count == 2, "the read must be scheduled in the batch after the clear");
+            DAXA_DBG_ASSERT_TRUE_M(statistics.scheduled.barrier_point_count == 1, "only the read batch waits on barriers");
+            DAXA_DBG_ASSERT_TRUE_M(debug_string.find("merged pipeline barrier command: 1 memory barriers, 64 image barriers") != std::string::npos,
+                                   "all barriers of the read batch must be recorded in one command, more image barriers than the recorder used to batch");
+        }
+        app.device.wait_idle();
+        for (auto const image : images)
+        {
+            app.device.destroy_image(image);
+        }
+        app.device.collect_garbage();
+    }
+
+    void static_execution()
+    {
+        // TEST:
+        //    1) Create a static task graph with a persistent buffer
+        //    2) Execute twice, the second execution replays the commands recorded in the first one
+        //    3) Set a different runtime buffer, the next execution records the commands again
+        AppContext app = {};
+        auto buffer_a = app.device.create_buffer({.size = 64, .name = APPNAME_PREFIX("buffer a")});
+        auto buffer_b = app.device.create_buffer({.size = 64, .name = APPNAME_PREFIX("buffer b")});
+        auto task_buffer = daxa::TaskBuffer({.initial_buffers = {.buffers = {&buffer_a, 1}}, .name = "buffer"});
+        {
+            auto task_graph = daxa::TaskGraph({
+                .device = app.device,
+                .static_execution = true,
+                .name = APPNAME_PREFIX("static execution"),
+            });
+            task_graph.use_persistent_buffer(task_buffer);
+            daxa::u32 record_count = 0;
+            task_graph.add_task({
+                .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, task_buffer)},
+                .task = [&](daxa::TaskInterface ti)
+                {
+                    ti.recorder.clear_buffer({.buffer = ti.get(task_buffer).ids[0], .size = 64});
+                    record_count += 1;
+                },
+                .name = "clear",
+            });
+            task_graph.submit({});
+            task_graph.complete({});
+
+            task_graph.execute({});
+            task_graph.execute({});
+            auto statistics = task_graph.get_static_execution_statistics();
+            DAXA_DBG_ASSERT_TRUE_M(record_count == 1, "replayed execution must not call the task callbacks");
+            DAXA_DBG_ASSERT_TRUE_M(statistics.recorded_executions == 1 && statistics.replayed_executions == 1, "second execution must replay the recorded commands");
+
+            task_buffer.set_buffers({.buffers = {&buffer_b, 1}});
+            task_graph.execute({});
+            statistics = task_graph.get_static_execution_statistics();
+            DAXA_DBG_ASSERT_TRUE_M(record_count == 2, "changed runtime buffer must re-record the commands");
+            DAXA_DBG_ASSERT_TRUE_M(statistics.invalidations == 1, "changed runtime buffer must invalidate the recorded commands");
+        }
+        app.device.wait_idle();
+        app.device.destroy_buffer(buffer_a);
+        app.device.destroy_buffer(buffer_b);
+        app.device.collect_garbage();
+    }
+
+    void serialized_permutations()
+    {
+        // TEST:
+        //    1) Complete a task graph with a conditional and transient resources, then serialize its permutations
+        //    2) Record the same graph again and complete it with the serialized permutations, which skips compilation
+        //    3) Record a graph with an additional task, the serialized permutations no longer match and are ignored
+        //    4) Serializing the loaded graph reproduces the same bytes
+        AppContext app = {};
+        auto make_graph = [&](bool additional_task)
+        {
+            auto task_graph = daxa::TaskGraph({
+                .device = app.device,
+                .alias_transients = true,
+                .permutation_condition_count = 1,
+                .name = APPNAME_PREFIX("serialized permutations"),
+            });
+            auto image = task_graph.create_transient_image({.size = {1, 1, 1}, .name = "image"});
+            auto buffer = task_graph.create_transient_buffer({.size = 64, .name = "buffer"});
+            task_graph.add_task({
+                .attachments = {
+                    daxa::inl_attachment(daxa::TaskImageAccess::TRANSFER_WRITE, image),
+                    daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, buffer),
+                },
+                .task = [](daxa::TaskInterface) {},
+                .name = "write",
+            });
+            task_graph.conditional({
+                .condition_index = 0,
+                .when_true = [&]()
+                {
+                    task_graph.add_task({
+                        .attachments = {daxa::inl_attachment(daxa::TaskImageAccess::TRANSFER_READ, image)},
+                        .task = [](daxa::TaskInterface) {},
+                        .name = "read image when true",
+                    });
+                },
+            });
+            task_graph.add_task({
+                .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, buffer)},
+                .task = [](daxa::TaskInterface) {},
+                .name = "read buffer",
+            });
+            if (additional_task)
+            {
+                task_graph.add_task({
+                    .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, buffer)},
+                    .task = [](daxa::TaskInterface) {},
+                    .name = "write buffer again",
+                });
+            }
+            task_graph.submit({});
+            return task_graph;
+        };
+
+        auto compiled_graph = make_graph(false);
+        compiled_graph.complete({});
+        std::vector<std::byte> const serialized = compiled_graph.serialize_compiled_permutations();
+        DAXA_DBG_ASSERT_TRUE_M(!compiled_graph.loaded_serialized_permutations(), "graph without serialized permutations must be compiled");
+        std::cout << "serialized permutations: " << serialized.size() << " bytes" << std::endl;
+
+        auto loaded_graph = make_graph(false);
+        loaded_graph.complete({.serialized_permutations = serialized});
+        DAXA_DBG_ASSERT_TRUE_M(loaded_graph.loaded_serialized_permutations(), "matching serialized permutations must be loaded");
+        DAXA_DBG_ASSERT_TRUE_M(loaded_graph.get_transient_memory_size() == compiled_graph.get_transient_memory_size(), "loaded graph must allocate the same transient memory");
+        DAXA_DBG_ASSERT_TRUE_M(loaded_graph.get_scheduling_statistics().scheduled.batch_count == compiled_graph.get_scheduling_statistics().scheduled.batch_count, "loaded graph must have the same batches");
+        DAXA_DBG_ASSERT_TRUE_M(loaded_graph.serialize_compiled_permutations() == serialized, "serialized permutations must be reproducible");
+        std::array<bool, 1> condition = {true};
+        loaded_graph.execute({.permutation_condition_values = condition});
+        condition[0] = false;
+        loaded_graph.execute({.permutation_condition_values = condition});
+
+        auto changed_graph = make_graph(true);
+        changed_graph.complete({.serialized_permutations = serialized});
+        DAXA_DBG_ASSERT_TRUE_M(!changed_graph.loaded_serialized_permutations(), "serialized permutations of a different graph must be ignored");
+        changed_graph.execute({.permutation_condition_values = condition});
+        app.device.wait_idle();
+        app.device.collect_garbage();
+    }
+
+    void dead_task_culling()
+    {
+        // TEST:
+        //    1) Produce a transient buffer that is copied into a persistent buffer, both tasks are kept
+        //    2) Produce a transient buffer only read by a visualization task whose output is never read, both are culled
+        //    3) A task with side effects writing an unused transient buffer is kept
+        AppContext app = {};
+        auto persistent_buffer = app.device.create_buffer({.size = 64, .name = APPNAME_PREFIX("persistent buffer")});
+        auto task_persistent_buffer = daxa::TaskBuffer({.initial_buffers = {.buffers = {&persistent_buffer, 1}}, .name = "persistent buffer"});
+        {
+            auto task_graph = daxa::TaskGraph({
+                .device = app.device,
+                .cull_dead_tasks = true,
+                .record_debug_information = true,
+                .name = APPNAME_PREFIX("dead task culling"),
+            });
+            task_graph.use_persistent_buffer(task_persistent_buffer);
+            auto used = task_graph.create_transient_buffer({.size = 64, .name = "used"});
+            auto visualized = task_graph.create_transient_buffer({.size = 64, .name = "visualized"});
+            auto visualization = task_graph.create_transient_buffer({.size = 64, .name = "visualization"});
+            auto side_effect_output = task_graph.create_transient_buffer({.size = 64, .name = "side effect output"});
+            daxa::u32 kept_executions = 0;
+            daxa::u32 culled_executions = 0;
+            task_graph.add_task({
+                .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, used)},
+                .task = [&](daxa::TaskInterface) { kept_executions += 1; },
+                .name = "produce used",
+            });
+            task_graph.add_task({
+                .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, visualized)},
+                .task = [&](daxa::TaskInterface) { culled_executions += 1; },
+                .name = "produce visualized",
+            });
+            task_graph.add_task({
+                .attachments = {
+                    daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, used),
+                    daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, task_persistent_buffer),
+                },
+                .task = [&](daxa::TaskInterface) { kept_executions += 1; },
+                .name = "copy to persistent",
+            });
+            task_graph.add_task({
+                .attachments = {
+                    daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_READ, visualized),
+                    daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, visualization),
+                },
+                .task = [&](daxa::TaskInterface) { culled_executions += 1; },
+                .name = "visualize",
+            });
+            task_graph.add_task({
+                .attachments = {daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, side_effect_output)},
+                .task = [&](daxa::TaskInterface) { kept_executions += 1; },
+                .name = "side effects",
+                .has_side_effects = true,
+            });
+            task_graph.submit({});
+            task_graph.complete({});
+            task_graph.execute({});
+            std::string const debug_string = task_graph.get_debug_string();
+            std::cout << debug_string << std::endl;
+            DAXA_DBG_ASSERT_TRUE_M(kept_executions == 3, "tasks with used outputs or side effects must be kept");
+            DAXA_DBG_ASSERT_TRUE_M(culled_executions == 0, "tasks with unused outputs and their producers must be culled");
+            DAXA_DBG_ASSERT_TRUE_M(debug_string.find("culled tasks: 2") != std::string::npos, "debug string must report the culled tasks");
+        }
+        app.device.wait_idle();
+        app.device.destroy_buffer(persistent_buffer);
+        app.device.collect_garbage();
+    }
+
+    void frames_in_flight()
+    {
+        // TEST:
+        //    1) Write a transient buffer and image in a graph with two frames in flight
+        //    2) Consecutive executions must alternate between two different runtime buffers and images
+        //    3) Each frame in flight allocates its own transient memory
+        AppContext app = {};
+        auto task_graph = daxa::TaskGraph({
+            .device = app.device,
+            .frames_in_flight = 2,
+            .name = APPNAME_PREFIX("frames in flight"),
+        });
+        auto buffer = task_graph.create_transient_buffer({.size = 64, .name = "buffer"});
+        auto image = task_graph.create_transient_image({.size = {16, 16, 1}, .name = "image"});
+        std::vector<daxa::BufferId> buffer_ids = {};
+        std::vector<daxa::ImageId> image_ids = {};
+        task_graph.add_task({
+            .attachments = {
+                daxa::inl_attachment(daxa::TaskBufferAccess::TRANSFER_WRITE, buffer),
+                daxa::inl_attachment(daxa::TaskImageAccess::TRANSFER_WRITE, image),
+            },
+            .task = [&](daxa::TaskInterface ti)
+            {
+                buffer_ids.push_back(ti.get(buffer).ids[0]);
+                image_ids.push_back(ti.get(image).ids[0]);
+            },
+            .name = "write",
+        });
+        task_graph.submit({});
+        task_graph.complete({});
+        for (daxa::u32 i = 0; i < 4; ++i)
+        {
+            task_graph.execute({});
+            app.device.wait_idle();
+        }
+        DAXA_DBG_ASSERT_TRUE_M(buffer_ids[0] != buffer_ids[1] && image_ids[0] != image_ids[1], "consecutive executions must use different transient resources");
+        DAXA_DBG_ASSERT_TRUE_M(buffer_ids[0] == buffer_ids[2] && buffer_ids[1] == buffer_ids[3], "transient buffers must be used round robin");
+        DAXA_DBG_ASSERT_TRUE_M(image_ids[0] == image_ids[2] && image_ids[1] == image_ids[3], "transient images must be used round robin");
+        auto const statistics = task_graph.get_transient_memory_statistics();
+        DAXA_DBG_ASSERT_TRUE_M(statistics.allocated_bytes >= 2 * statistics.peak_live_bytes, "each frame in flight must allocate its own transient memory");
+        app.device.collect_garbage();
+    }
 } //namespace tests
 
 auto main() -> i32
@@ -1000,4 +1644,15 @@ auto main() -> i32
     tests::test_concurrent_read_write_buffer_cross_graphs();
     tests::mipmapping();
     tests::optional_attachments();
+    tests::jit_permutations();
+    tests::parallel_recording();
+    tests::async_queues();
+    tests::transient_memory_statistics();
+    tests::shared_transient_heap();
+    tests::minimize_barriers();
+    tests::many_runtime_image_barriers();
+    tests::static_execution();
+    tests::serialized_permutations();
+    tests::dead_task_culling();
+    tests::frames_in_flight();
 }
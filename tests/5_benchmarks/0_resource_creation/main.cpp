@@ -0,0 +1,173 @@
+#include <daxa/daxa.hpp>
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+// Stresses the gpu resource slot allocation of the device from many threads.
+// Each thread repeatedly creates and destroys buffers and samplers.
+// Prints the achieved throughput for increasing thread counts to show how creation/destruction scales with the core count.
+
+namespace benchmarks
+{
+    using namespace daxa::types;
+
+    static constexpr u32 ITERATIONS_PER_THREAD = 4096;
+    static constexpr u32 LIVE_RESOURCES_PER_THREAD = 64;
+
+    // Doubles the thread count up to the hardware thread count, which is always the last step even when it is not a power of two.
+    auto thread_count_sweep() -> std::vector<u32>
+    {
+        u32 const max_threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<u32> thread_counts = {};
+        for (u32 thread_count = 1; thread_count < max_threads; thread_count *= 2)
+        {
+            thread_counts.push_back(thread_count);
+        }
+        thread_counts.push_back(max_threads);
+        return thread_counts;
+    }
+
+    void create_destroy_thread(daxa::Device & device)
+    {
+        std::vector<daxa::BufferId> buffers = {};
+        std::vector<daxa::SamplerId> samplers = {};
+        buffers.reserve(LIVE_RESOURCES_PER_THREAD);
+        samplers.reserve(LIVE_RESOURCES_PER_THREAD);
+        for (u32 i = 0; i < ITERATIONS_PER_THREAD; ++i)
+        {
+            if (buffers.size() == LIVE_RESOURCES_PER_THREAD)
+            {
+                for (u32 j = 0; j < LIVE_RESOURCES_PER_THREAD; ++j)
+                {
+                    device.destroy_buffer(buffers[j]);
+                    device.destroy_sampler(samplers[j]);
+                }
+                buffers.clear();
+                samplers.clear();
+            }
+            buffers.push_back(device.create_buffer({.size = 64}));
+            samplers.push_back(device.create_sampler({}));
+        }
+        for (u32 j = 0; j < buffers.size(); ++j)
+        {
+            device.destroy_buffer(buffers[j]);
+            device.destroy_sampler(samplers[j]);
+        }
+    }
+
+    void resource_creation_scaling(daxa::Instance & instance)
+    {
+        auto device = instance.create_device_2(instance.choose_device({}, {}));
+        std::cout << "threads, resources created and destroyed, ms, resources per ms" << std::endl;
+        for (u32 const thread_count : thread_count_sweep())
+        {
+            auto const start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads = {};
+            for (u32 t = 0; t < thread_count; ++t)
+            {
+                threads.push_back(std::thread{[&]()
+                                              { create_destroy_thread(device); }});
+            }
+            for (auto & thread : threads)
+            {
+                thread.join();
+            }
+            auto const end = std::chrono::steady_clock::now();
+            device.collect_garbage();
+            f64 const ms = std::chrono::duration<f64, std::milli>(end - start).count();
+            u32 const resource_count = thread_count * ITERATIONS_PER_THREAD * 2;
+            std::cout << thread_count << ", " << resource_count << ", " << ms << ", " << (static_cast<f64>(resource_count) / ms) << std::endl;
+        }
+        auto const descriptor_writes = device.descriptor_write_statistics();
+        std::cout << "descriptor write flushes: " << descriptor_writes.flush_count
+                  << ", flushed writes: " << descriptor_writes.flushed_write_count
+                  << ", replaced writes: " << descriptor_writes.replaced_write_count << std::endl;
+    }
+
+    // Compares creating many buffers one by one with creating them in a single bulk call.
+    void bulk_creation(daxa::Instance & instance)
+    {
+        static constexpr u32 BULK_COUNT = 16384;
+        auto device = instance.create_device_2(instance.choose_device({}, {}));
+        std::vector<daxa::BufferInfo> infos = {};
+        for (u32 i = 0; i < BULK_COUNT; ++i)
+        {
+            infos.push_back({.size = 64u * (1u + (i % 4u))});
+        }
+
+        auto const single_start = std::chrono::steady_clock::now();
+        std::vector<daxa::BufferId> buffers = {};
+        for (auto const & info : infos)
+        {
+            buffers.push_back(device.create_buffer(info));
+        }
+        auto const single_end = std::chrono::steady_clock::now();
+        for (auto const id : buffers)
+        {
+            device.destroy_buffer(id);
+        }
+        device.collect_garbage();
+
+        auto const bulk_start = std::chrono::steady_clock::now();
+        buffers = device.create_buffers(infos);
+        auto const bulk_end = std::chrono::steady_clock::now();
+        device.destroy_buffers(buffers);
+        device.collect_garbage();
+
+        f64 const single_ms = std::chrono::duration<f64, std::milli>(single_end - single_start).count();
+        f64 const bulk_ms = std::chrono::duration<f64, std::milli>(bulk_end - bulk_start).count();
+        std::cout << "created " << BULK_COUNT << " buffers, one by one: " << single_ms << "ms, bulk: " << bulk_ms << "ms" << std::endl;
+    }
+
+    // Destroys a fixed number of buffers split across an increasing number of threads.
+    // Only the destroy calls are timed, collecting the garbage afterwards is measured separately.
+    void destroy_throughput(daxa::Instance & instance)
+    {
+        static constexpr u32 DESTROY_COUNT = 8192;
+        auto device = instance.create_device_2(instance.choose_device({}, {}));
+        std::cout << "threads, buffers destroyed, destroy ms, buffers destroyed per ms, collect garbage ms" << std::endl;
+        for (u32 const thread_count : thread_count_sweep())
+        {
+            std::vector<daxa::BufferId> buffers = {};
+            for (u32 i = 0; i < DESTROY_COUNT; ++i)
+            {
+                buffers.push_back(device.create_buffer({.size = 64}));
+            }
+            u32 const per_thread = DESTROY_COUNT / thread_count;
+            auto const start = std::chrono::steady_clock::now();
+            std::vector<std::thread> threads = {};
+            for (u32 t = 0; t < thread_count; ++t)
+            {
+                threads.push_back(std::thread{[&, t]()
+                                              {
+                                                  u32 const end = (t + 1 == thread_count) ? DESTROY_COUNT : (t + 1) * per_thread;
+                                                  for (u32 i = t * per_thread; i < end; ++i)
+                                                  {
+                                                      device.destroy_buffer(buffers[i]);
+                                                  }
+                                              }});
+            }
+            for (auto & thread : threads)
+            {
+                thread.join();
+            }
+            auto const end = std::chrono::steady_clock::now();
+            device.collect_garbage();
+            auto const collect_end = std::chrono::steady_clock::now();
+            f64 const ms = std::chrono::duration<f64, std::milli>(end - start).count();
+            f64 const collect_ms = std::chrono::duration<f64, std::milli>(collect_end - end).count();
+            std::cout << thread_count << ", " << DESTROY_COUNT << ", " << ms << ", " << (static_cast<f64>(DESTROY_COUNT) / ms) << ", " << collect_ms << std::endl;
+        }
+    }
+} // namespace benchmarks
+
+auto main() -> int
+{
+    auto instance = daxa::create_instance({});
+    benchmarks::resource_creation_scaling(instance);
+    benchmarks::bulk_creation(instance);
+    benchmarks::destroy_throughput(instance);
+    std::cout << "completed all benchmarks successfully!" << std::endl;
+}
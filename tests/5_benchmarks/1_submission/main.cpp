@@ -0,0 +1,81 @@
+#include <daxa/daxa.hpp>
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+// Compares submitting many small batches one by one against submitting them with a single batched call.
+// Each batch signals its own timeline semaphore, like the separate submissions of an async compute frame.
+
+namespace benchmarks
+{
+    using namespace daxa::types;
+
+    static constexpr u32 ITERATIONS = 256;
+
+    void submission(daxa::Instance & instance, u32 batch_count)
+    {
+        auto device = instance.create_device_2(instance.choose_device({}, {}));
+        std::vector<daxa::TimelineSemaphore> semaphores = {};
+        for (u32 i = 0; i < batch_count; ++i)
+        {
+            semaphores.push_back(device.create_timeline_semaphore({.initial_value = 0}));
+        }
+
+        f64 individual_ms = 0.0;
+        f64 batched_ms = 0.0;
+        u64 signal_value = 0;
+        for (u32 iteration = 0; iteration < ITERATIONS; ++iteration)
+        {
+            bool const batched = (iteration % 2) == 1;
+            ++signal_value;
+
+            std::vector<daxa::ExecutableCommandList> command_lists = {};
+            std::vector<std::pair<daxa::TimelineSemaphore, u64>> signals = {};
+            for (u32 i = 0; i < batch_count; ++i)
+            {
+                auto recorder = device.create_command_recorder({});
+                command_lists.push_back(recorder.complete_current_commands());
+                signals.push_back({semaphores[i], signal_value});
+            }
+            std::vector<daxa::CommandSubmitInfo> submit_infos = {};
+            for (u32 i = 0; i < batch_count; ++i)
+            {
+                submit_infos.push_back({
+                    .command_lists = std::span{&command_lists[i], 1},
+                    .signal_timeline_semaphores = std::span{&signals[i], 1},
+                });
+            }
+
+            auto const start = std::chrono::steady_clock::now();
+            if (batched)
+            {
+                device.submit_commands_batch(submit_infos);
+            }
+            else
+            {
+                for (auto const & submit_info : submit_infos)
+                {
+                    device.submit_commands(submit_info);
+                }
+            }
+            auto const end = std::chrono::steady_clock::now();
+            (batched ? batched_ms : individual_ms) += std::chrono::duration<f64, std::milli>(end - start).count();
+
+            device.wait_idle();
+            device.collect_garbage();
+        }
+        u32 const runs = ITERATIONS / 2;
+        std::cout << batch_count << ", " << (individual_ms / runs) << ", " << (batched_ms / runs) << std::endl;
+    }
+} // namespace benchmarks
+
+auto main() -> int
+{
+    auto instance = daxa::create_instance({});
+    std::cout << "batches, individual submits ms, batched submit ms" << std::endl;
+    for (daxa::u32 batch_count : {1u, 2u, 4u, 8u, 16u, 32u})
+    {
+        benchmarks::submission(instance, batch_count);
+    }
+    std::cout << "completed all benchmarks successfully!" << std::endl;
+}
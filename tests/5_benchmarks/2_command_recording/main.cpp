@@ -0,0 +1,65 @@
+#include <daxa/daxa.hpp>
+#include <iostream>
+#include <vector>
+
+// Records several command lists per frame, like per-frame recorders on multiple queues.
+// Prints how many command list bookkeeping sets had to be created from scratch each frame.
+// After the first frames all of them should be recycled from the devices pool.
+
+namespace benchmarks
+{
+    using namespace daxa::types;
+
+    static constexpr u32 FRAME_COUNT = 16;
+    static constexpr u32 COMMAND_LISTS_PER_FRAME = 11;
+    static constexpr u32 COMMANDS_PER_LIST = 64;
+
+    void command_list_data_recycling(daxa::Instance & instance)
+    {
+        auto device = instance.create_device_2(instance.choose_device({}, {}));
+        std::vector<daxa::BufferId> buffers = {};
+        for (u32 i = 0; i < 8; ++i)
+        {
+            buffers.push_back(device.create_buffer({.size = 256}));
+        }
+
+        std::cout << "frame, command list data created, recycled" << std::endl;
+        auto previous = device.command_list_data_statistics();
+        for (u32 frame = 0; frame < FRAME_COUNT; ++frame)
+        {
+            std::vector<daxa::ExecutableCommandList> command_lists = {};
+            for (u32 list = 0; list < COMMAND_LISTS_PER_FRAME; ++list)
+            {
+                auto recorder = device.create_command_recorder({});
+                for (u32 command = 0; command < COMMANDS_PER_LIST; ++command)
+                {
+                    recorder.clear_buffer({
+                        .buffer = buffers[command % buffers.size()],
+                        .size = 256,
+                    });
+                }
+                command_lists.push_back(recorder.complete_current_commands());
+            }
+            device.submit_commands({.command_lists = command_lists});
+            command_lists.clear();
+            device.wait_idle();
+            device.collect_garbage();
+
+            auto const current = device.command_list_data_statistics();
+            std::cout << frame << ", " << (current.created_count - previous.created_count) << ", " << (current.recycled_count - previous.recycled_count) << std::endl;
+            previous = current;
+        }
+
+        for (auto const id : buffers)
+        {
+            device.destroy_buffer(id);
+        }
+    }
+} // namespace benchmarks
+
+auto main() -> int
+{
+    auto instance = daxa::create_instance({});
+    benchmarks::command_list_data_recycling(instance);
+    std::cout << "completed all benchmarks successfully!" << std::endl;
+}
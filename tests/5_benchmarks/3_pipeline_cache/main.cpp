@@ -0,0 +1,133 @@
+#include <daxa/daxa.hpp>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <array>
+#include <filesystem>
+
+// Compares pipeline creation time at startup with a cold and a warm pipeline cache.
+// The first device starts without a cache file and writes it when destroyed.
+// The second device loads that file, so the driver can skip most of the compilation.
+// Also compares creating pipelines one by one with batched and multi-threaded batched creation.
+
+namespace benchmarks
+{
+    using namespace daxa::types;
+
+    static constexpr u32 PIPELINE_COUNT = 256;
+    static constexpr char const * CACHE_PATH = "daxa_benchmark_pipeline_cache.bin";
+
+    // Minimal compute shader with an empty main.
+    // The local size x is patched per pipeline, so every pipeline is a distinct compilation.
+    static constexpr usize LOCAL_SIZE_X_WORD = 18;
+    static constexpr std::array<u32, 35> EMPTY_COMPUTE_SPIRV = {
+        0x07230203, 0x00010000, 0, 5, 0,
+        0x00020011, 1,                                // OpCapability Shader
+        0x0003000E, 0, 1,                             // OpMemoryModel Logical GLSL450
+        0x0005000F, 5, 1, 0x6E69616D, 0,              // OpEntryPoint GLCompute %1 "main"
+        0x00060010, 1, 17, 1, 1, 1,                   // OpExecutionMode %1 LocalSize x 1 1
+        0x00020013, 2,                                // %2 = OpTypeVoid
+        0x00030021, 3, 2,                             // %3 = OpTypeFunction %2
+        0x00050036, 2, 1, 0, 3,                       // %1 = OpFunction %2 None %3
+        0x000200F8, 4,                                // OpLabel
+        0x000100FD,                                   // OpReturn
+        0x00010038,                                   // OpFunctionEnd
+    };
+
+    using ByteCode = std::array<u32, EMPTY_COMPUTE_SPIRV.size()>;
+
+    // Every pipeline gets a distinct local size starting at first_local_size_x, so no run hits pipelines compiled by an earlier one.
+    auto make_byte_codes(u32 first_local_size_x) -> std::vector<ByteCode>
+    {
+        std::vector<ByteCode> byte_codes(PIPELINE_COUNT, EMPTY_COMPUTE_SPIRV);
+        for (u32 i = 0; i < PIPELINE_COUNT; ++i)
+        {
+            byte_codes[i][LOCAL_SIZE_X_WORD] = first_local_size_x + i;
+        }
+        return byte_codes;
+    }
+
+    auto make_pipeline_infos(std::vector<ByteCode> const & byte_codes) -> std::vector<daxa::ComputePipelineInfo>
+    {
+        std::vector<daxa::ComputePipelineInfo> infos = {};
+        for (auto const & byte_code : byte_codes)
+        {
+            infos.push_back({
+                .shader_info = {
+                    .byte_code = byte_code.data(),
+                    .byte_code_size = static_cast<u32>(byte_code.size()),
+                },
+                .name = "pipeline cache benchmark",
+            });
+        }
+        return infos;
+    }
+
+    auto create_pipelines_ms(daxa::Instance & instance) -> f64
+    {
+        auto device_info = instance.choose_device({}, {});
+        device_info.pipeline_cache_path = CACHE_PATH;
+        auto device = instance.create_device_2(device_info);
+
+        auto const byte_codes = make_byte_codes(1);
+        auto const infos = make_pipeline_infos(byte_codes);
+        std::vector<daxa::ComputePipeline> pipelines = {};
+        auto const start = std::chrono::steady_clock::now();
+        for (auto const & info : infos)
+        {
+            pipelines.push_back(device.create_compute_pipeline(info));
+        }
+        auto const end = std::chrono::steady_clock::now();
+        return std::chrono::duration<f64, std::milli>(end - start).count();
+    }
+
+    void pipeline_cache_startup(daxa::Instance & instance)
+    {
+        std::filesystem::remove(CACHE_PATH);
+        f64 const cold_ms = create_pipelines_ms(instance);
+        f64 const warm_ms = create_pipelines_ms(instance);
+        std::filesystem::remove(CACHE_PATH);
+        std::cout << "created " << PIPELINE_COUNT << " compute pipelines, cold cache: " << cold_ms << "ms, warm cache: " << warm_ms << "ms" << std::endl;
+    }
+
+    // Runs without a pipeline cache file, so every variant compiles its pipelines from scratch.
+    void batch_creation(daxa::Instance & instance)
+    {
+        auto device = instance.create_device_2(instance.choose_device({}, {}));
+
+        auto const single_byte_codes = make_byte_codes(1);
+        auto const single_infos = make_pipeline_infos(single_byte_codes);
+        std::vector<daxa::ComputePipeline> pipelines = {};
+        auto const single_start = std::chrono::steady_clock::now();
+        for (auto const & info : single_infos)
+        {
+            pipelines.push_back(device.create_compute_pipeline(info));
+        }
+        auto const single_end = std::chrono::steady_clock::now();
+
+        auto const batch_byte_codes = make_byte_codes(1 + PIPELINE_COUNT);
+        auto const batch_infos = make_pipeline_infos(batch_byte_codes);
+        auto const batch_start = std::chrono::steady_clock::now();
+        auto const batch_pipelines = device.create_compute_pipelines(batch_infos);
+        auto const batch_end = std::chrono::steady_clock::now();
+
+        auto const threaded_byte_codes = make_byte_codes(1 + 2 * PIPELINE_COUNT);
+        auto const threaded_infos = make_pipeline_infos(threaded_byte_codes);
+        auto const threaded_start = std::chrono::steady_clock::now();
+        auto const threaded_pipelines = device.create_compute_pipelines(threaded_infos, 0);
+        auto const threaded_end = std::chrono::steady_clock::now();
+
+        f64 const single_ms = std::chrono::duration<f64, std::milli>(single_end - single_start).count();
+        f64 const batch_ms = std::chrono::duration<f64, std::milli>(batch_end - batch_start).count();
+        f64 const threaded_ms = std::chrono::duration<f64, std::milli>(threaded_end - threaded_start).count();
+        std::cout << "created " << PIPELINE_COUNT << " compute pipelines, one by one: " << single_ms << "ms, batched: " << batch_ms << "ms, batched on all threads: " << threaded_ms << "ms" << std::endl;
+    }
+} // namespace benchmarks
+
+auto main() -> int
+{
+    auto instance = daxa::create_instance({});
+    benchmarks::pipeline_cache_startup(instance);
+    benchmarks::batch_creation(instance);
+    std::cout << "completed all benchmarks successfully!" << std::endl;
+}
@@ -0,0 +1,80 @@
+#include <daxa/daxa.hpp>
+#include <daxa/utils/task_graph.hpp>
+#include <iostream>
+#include <chrono>
+
+// Measures how long the task graph takes to compile a mip chain generation over an image array.
+// Every task blits one array layer of one mip into the next mip, so the graph tracks many small subresource slices.
+// Prints the time spent recording the tasks and completing the graph for several runs.
+
+namespace benchmarks
+{
+    using namespace daxa::types;
+
+    static constexpr u32 RUN_COUNT = 8;
+    static constexpr u32 MIP_COUNT = 11;
+    static constexpr u32 LAYER_COUNT = 100;
+
+    void mip_chain_compile(daxa::Instance & instance)
+    {
+        auto device = instance.create_device_2(instance.choose_device({}, {}));
+        std::cout << "run, tasks, record ms, complete ms" << std::endl;
+        for (u32 run = 0; run < RUN_COUNT; ++run)
+        {
+            auto task_graph = daxa::TaskGraph({
+                .device = device,
+                .name = "mip chain compile",
+            });
+            auto const record_start = std::chrono::steady_clock::now();
+            auto image = task_graph.create_transient_image({
+                .size = {1u << (MIP_COUNT - 1), 1u << (MIP_COUNT - 1), 1},
+                .mip_level_count = MIP_COUNT,
+                .array_layer_count = LAYER_COUNT,
+                .name = "mip chain",
+            });
+            u32 task_count = 0;
+            task_graph.add_task({
+                .attachments = {daxa::inl_attachment(daxa::TaskImageAccess::TRANSFER_WRITE, image.view({.level_count = 1, .layer_count = LAYER_COUNT}))},
+                .task = [](daxa::TaskInterface const &) {},
+                .name = "upload mip 0",
+            });
+            task_count += 1;
+            for (u32 mip = 1; mip < MIP_COUNT; ++mip)
+            {
+                for (u32 layer = 0; layer < LAYER_COUNT; ++layer)
+                {
+                    task_graph.add_task({
+                        .attachments = {
+                            daxa::inl_attachment(daxa::TaskImageAccess::TRANSFER_READ, image.view({.base_mip_level = mip - 1, .base_array_layer = layer})),
+                            daxa::inl_attachment(daxa::TaskImageAccess::TRANSFER_WRITE, image.view({.base_mip_level = mip, .base_array_layer = layer})),
+                        },
+                        .task = [](daxa::TaskInterface const &) {},
+                        .name = "blit mip",
+                    });
+                    task_count += 1;
+                }
+            }
+            task_graph.add_task({
+                .attachments = {daxa::inl_attachment(daxa::TaskImageAccess::FRAGMENT_SHADER_SAMPLED, image.view({.level_count = MIP_COUNT, .layer_count = LAYER_COUNT}))},
+                .task = [](daxa::TaskInterface const &) {},
+                .name = "sample mip chain",
+            });
+            task_count += 1;
+            task_graph.submit({});
+            auto const complete_start = std::chrono::steady_clock::now();
+            task_graph.complete({});
+            auto const complete_end = std::chrono::steady_clock::now();
+            f64 const record_ms = std::chrono::duration<f64, std::milli>(complete_start - record_start).count();
+            f64 const complete_ms = std::chrono::duration<f64, std::milli>(complete_end - complete_start).count();
+            std::cout << run << ", " << task_count << ", " << record_ms << ", " << complete_ms << std::endl;
+        }
+        device.collect_garbage();
+    }
+} // namespace benchmarks
+
+auto main() -> int
+{
+    auto instance = daxa::create_instance({});
+    benchmarks::mip_chain_compile(instance);
+    std::cout << "completed all benchmarks successfully!" << std::endl;
+}
@@ -0,0 +1,81 @@
+#include <daxa/daxa.hpp>
+#include <daxa/utils/task_graph.hpp>
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+// Measures the cpu time the task graph spends recording and completing a large graph with several permutations.
+// Half of the tasks are recorded unconditionally, the rest is split across the conditionals.
+// Nothing is executed, so the numbers only contain the compile time of the task graph itself.
+
+namespace benchmarks
+{
+    using namespace daxa::types;
+
+    static constexpr u32 RUN_COUNT = 4;
+    static constexpr u32 TASK_COUNT = 10000;
+    static constexpr u32 CONDITION_COUNT = 4;
+    static constexpr u32 BUFFER_COUNT = 256;
+
+    void large_graph_complete(daxa::Instance & instance)
+    {
+        auto device = instance.create_device_2(instance.choose_device({}, {}));
+        std::cout << "run, tasks, permutations, record ms, complete ms, complete ms per permutation" << std::endl;
+        for (u32 run = 0; run < RUN_COUNT; ++run)
+        {
+            auto task_graph = daxa::TaskGraph({
+                .device = device,
+                .permutation_condition_count = CONDITION_COUNT,
+                .name = "large graph complete",
+            });
+            auto const record_start = std::chrono::steady_clock::now();
+            std::vector<daxa::TaskBufferView> buffers = {};
+            for (u32 i = 0; i < BUFFER_COUNT; ++i)
+            {
+                buffers.push_back(task_graph.create_transient_buffer({.size = 256, .name = "buffer " + std::to_string(i)}));
+            }
+            // Each task reads one buffer and writes another, forming many interleaved dependency chains.
+            auto const add_tasks = [&](u32 first_task, u32 task_count)
+            {
+                for (u32 task = first_task; task < first_task + task_count; ++task)
+                {
+                    task_graph.add_task({
+                        .attachments = {
+                            daxa::inl_attachment(daxa::TaskBufferAccess::COMPUTE_SHADER_READ, buffers[(task * 7u + 3u) % BUFFER_COUNT]),
+                            daxa::inl_attachment(daxa::TaskBufferAccess::COMPUTE_SHADER_WRITE, buffers[task % BUFFER_COUNT]),
+                        },
+                        .task = [](daxa::TaskInterface const &) {},
+                        .name = "task",
+                    });
+                }
+            };
+            u32 const unconditional_task_count = TASK_COUNT / 2;
+            u32 const conditional_task_count = (TASK_COUNT - unconditional_task_count) / CONDITION_COUNT;
+            add_tasks(0, unconditional_task_count);
+            for (u32 condition = 0; condition < CONDITION_COUNT; ++condition)
+            {
+                task_graph.conditional({
+                    .condition_index = condition,
+                    .when_true = [&]()
+                    { add_tasks(unconditional_task_count + condition * conditional_task_count, conditional_task_count); },
+                });
+            }
+            task_graph.submit({});
+            auto const complete_start = std::chrono::steady_clock::now();
+            task_graph.complete({});
+            auto const complete_end = std::chrono::steady_clock::now();
+            u32 const permutation_count = 1u << CONDITION_COUNT;
+            f64 const record_ms = std::chrono::duration<f64, std::milli>(complete_start - record_start).count();
+            f64 const complete_ms = std::chrono::duration<f64, std::milli>(complete_end - complete_start).count();
+            std::cout << run << ", " << TASK_COUNT << ", " << permutation_count << ", " << record_ms << ", " << complete_ms << ", " << (complete_ms / static_cast<f64>(permutation_count)) << std::endl;
+        }
+        device.collect_garbage();
+    }
+} // namespace benchmarks
+
+auto main() -> int
+{
+    auto instance = daxa::create_instance({});
+    benchmarks::large_graph_complete(instance);
+    std::cout << "completed all benchmarks successfully!" << std::endl;
+}